@@ -34,7 +34,10 @@ public class GEInput : ModuleRules
         PrivateDependencyModuleNames.AddRange(
             new string[]
             {
+                "Slate", "SlateCore",
             }
         );
+
+        SetupGameplayDebuggerSupport(Target);
     }
 }
@@ -2,13 +2,64 @@
 
 #include "GEInput.h"
 
+#include "GEInputStats.h"
+#include "Latency/InputLatencyTracker.h"
+#include "Mapping/InputMappingContextRegistry.h"
+#include "Development/InputAllocationCounter.h"
+
+#include "Misc/CoreDelegates.h"
+
+#if WITH_GAMEPLAY_DEBUGGER && !UE_BUILD_SHIPPING
+#include "GameplayDebugger.h"
+#include "Development/GameplayDebuggerCategory_GEInput.h"
+#endif
+
 IMPLEMENT_MODULE(FGEInputModule, GEInput)
 
 
 void FGEInputModule::StartupModule()
 {
+#if !UE_BUILD_SHIPPING
+	FInputAllocationScope::Startup();
+#endif
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FGEInputModule::HandleEndFrame);
+
+#if GEINPUT_LATENCY_ENABLED
+	FInputLatencyTracker::Startup();
+#endif
+
+	FInputMappingContextRegistry::Startup();
+
+#if WITH_GAMEPLAY_DEBUGGER && !UE_BUILD_SHIPPING
+	auto& GameplayDebuggerModule{ IGameplayDebugger::Get() };
+	GameplayDebuggerModule.RegisterCategory("GEInput", IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_GEInput::MakeInstance), EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FGEInputModule::ShutdownModule()
 {
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+#if GEINPUT_LATENCY_ENABLED
+	FInputLatencyTracker::Shutdown();
+#endif
+
+	FInputMappingContextRegistry::Shutdown();
+
+#if WITH_GAMEPLAY_DEBUGGER && !UE_BUILD_SHIPPING
+	if (IGameplayDebugger::IsAvailable())
+	{
+		auto& GameplayDebuggerModule{ IGameplayDebugger::Get() };
+		GameplayDebuggerModule.UnregisterCategory("GEInput");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
+}
+
+
+void FGEInputModule::HandleEndFrame()
+{
+	GEInputStats::FlushFrameStats();
 }
@@ -13,4 +13,10 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+protected:
+	FDelegateHandle EndFrameHandle;
+
+protected:
+	void HandleEndFrame();
+
 };
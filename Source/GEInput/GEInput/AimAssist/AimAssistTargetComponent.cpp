@@ -0,0 +1,37 @@
+// Copyright (C) 2024 owoDra
+
+#include "AimAssistTargetComponent.h"
+
+#include "AimAssist/AimAssistTargetSubsystem.h"
+
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AimAssistTargetComponent)
+
+
+UAimAssistTargetComponent::UAimAssistTargetComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+
+void UAimAssistTargetComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (auto* Subsystem{ UWorld::GetSubsystem<UAimAssistTargetSubsystem>(GetWorld()) })
+	{
+		Subsystem->RegisterTarget(this);
+	}
+}
+
+void UAimAssistTargetComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (auto* Subsystem{ UWorld::GetSubsystem<UAimAssistTargetSubsystem>(GetWorld()) })
+	{
+		Subsystem->UnregisterTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
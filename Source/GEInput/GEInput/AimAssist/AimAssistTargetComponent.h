@@ -0,0 +1,56 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Components/SceneComponent.h"
+
+#include "AimAssistTargetComponent.generated.h"
+
+class UAimAssistTargetSubsystem;
+
+
+/**
+ * Marks a point of the owning actor that aim assist can pull towards
+ *
+ * Tips:
+ *	Attach it to the part that should be aimed at (e.g. the chest socket).
+ *	Registered with UAimAssistTargetSubsystem while the game is playing.
+ */
+UCLASS(meta = (BlueprintSpawnableComponent))
+class GEINPUT_API UAimAssistTargetComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+	friend class UAimAssistTargetSubsystem;
+
+public:
+	UAimAssistTargetComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	//
+	// Radius in cm of the target volume used to scale the friction and magnetism zones
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aim Assist", meta = (ClampMin = 1, Units = "Centimeters"))
+	float TargetRadius{ 40.0f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aim Assist")
+	bool bAimAssistEnabled{ true };
+
+	//
+	// Index of this target in the subsystem, INDEX_NONE if not registered
+	//
+	int32 TargetIndex{ INDEX_NONE };
+
+public:
+	float GetTargetRadius() const { return TargetRadius; }
+
+	bool IsAimAssistEnabled() const { return bAimAssistEnabled; }
+
+	UFUNCTION(BlueprintCallable, Category = "Aim Assist")
+	void SetAimAssistEnabled(bool bEnabled) { bAimAssistEnabled = bEnabled; }
+
+};
@@ -0,0 +1,219 @@
+// Copyright (C) 2024 owoDra
+
+#include "AimAssistTargetSubsystem.h"
+
+#include "AimAssist/AimAssistTargetComponent.h"
+#include "GEInputLLM.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AimAssistTargetSubsystem)
+
+
+void UAimAssistTargetSubsystem::Deinitialize()
+{
+	for (const auto& Target : Targets)
+	{
+		if (auto* Component{ Target.Component.Get() })
+		{
+			Component->TargetIndex = INDEX_NONE;
+		}
+	}
+
+	Targets.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UAimAssistTargetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Targets.IsEmpty() || (RefreshRate <= 0.0f))
+	{
+		return;
+	}
+
+	// At most one refresh per frame, the remaining time is dropped when the frame rate is below the refresh rate
+
+	const auto StepSeconds{ 1.0 / RefreshRate };
+
+	RefreshAccumulator += DeltaTime;
+
+	if (RefreshAccumulator >= StepSeconds)
+	{
+		RefreshAccumulator = FMath::Fmod(RefreshAccumulator, StepSeconds);
+
+		RefreshTargets();
+	}
+}
+
+TStatId UAimAssistTargetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAimAssistTargetSubsystem, STATGROUP_Tickables);
+}
+
+bool UAimAssistTargetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+
+void UAimAssistTargetSubsystem::RegisterTarget(UAimAssistTargetComponent* Component)
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (!Component || (Component->TargetIndex != INDEX_NONE))
+	{
+		return;
+	}
+
+	const auto Location{ Component->GetComponentLocation() };
+
+	auto& NewTarget{ Targets.AddDefaulted_GetRef() };
+	NewTarget.Component = Component;
+	NewTarget.Location = Location;
+	NewTarget.Cell = GetCell(Location);
+
+	Component->TargetIndex = Targets.Num() - 1;
+
+	AddToCell(NewTarget.Cell, Component->TargetIndex);
+}
+
+void UAimAssistTargetSubsystem::UnregisterTarget(UAimAssistTargetComponent* Component)
+{
+	if (!Component || !Targets.IsValidIndex(Component->TargetIndex))
+	{
+		return;
+	}
+
+	RemoveTargetAt(Component->TargetIndex);
+
+	Component->TargetIndex = INDEX_NONE;
+}
+
+void UAimAssistTargetSubsystem::ForEachTargetInRadius(const FVector& Center, float Radius, TFunctionRef<void(UAimAssistTargetComponent*, const FVector&)> Visitor) const
+{
+	const auto MinCell{ GetCell(Center - FVector(Radius)) };
+	const auto MaxCell{ GetCell(Center + FVector(Radius)) };
+	const auto RadiusSquared{ FMath::Square(Radius) };
+
+	for (auto X{ MinCell.X }; X <= MaxCell.X; ++X)
+	{
+		for (auto Y{ MinCell.Y }; Y <= MaxCell.Y; ++Y)
+		{
+			for (auto Z{ MinCell.Z }; Z <= MaxCell.Z; ++Z)
+			{
+				const auto* CellTargets{ Cells.Find(FIntVector(X, Y, Z)) };
+
+				if (!CellTargets)
+				{
+					continue;
+				}
+
+				for (const auto TargetIndex : *CellTargets)
+				{
+					const auto& Target{ Targets[TargetIndex] };
+					auto* Component{ Target.Component.Get() };
+
+					if (Component && Component->IsAimAssistEnabled() && (FVector::DistSquared(Center, Target.Location) <= RadiusSquared))
+					{
+						Visitor(Component, Target.Location);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+FIntVector UAimAssistTargetSubsystem::GetCell(const FVector& Location) const
+{
+	const auto InvCellSize{ 1.0 / FMath::Max(CellSize, 1.0f) };
+
+	return FIntVector(
+		FMath::FloorToInt32(Location.X * InvCellSize),
+		FMath::FloorToInt32(Location.Y * InvCellSize),
+		FMath::FloorToInt32(Location.Z * InvCellSize));
+}
+
+void UAimAssistTargetSubsystem::AddToCell(const FIntVector& Cell, int32 TargetIndex)
+{
+	Cells.FindOrAdd(Cell).Add(TargetIndex);
+}
+
+void UAimAssistTargetSubsystem::RemoveFromCell(const FIntVector& Cell, int32 TargetIndex)
+{
+	if (auto* CellTargets{ Cells.Find(Cell) })
+	{
+		CellTargets->RemoveSingleSwap(TargetIndex);
+
+		if (CellTargets->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UAimAssistTargetSubsystem::RemoveTargetAt(int32 Index)
+{
+	const auto LastIndex{ Targets.Num() - 1 };
+
+	RemoveFromCell(Targets[Index].Cell, Index);
+
+	if (Index != LastIndex)
+	{
+		auto& MovedTarget{ Targets[LastIndex] };
+
+		RemoveFromCell(MovedTarget.Cell, LastIndex);
+		AddToCell(MovedTarget.Cell, Index);
+
+		if (auto* MovedComponent{ MovedTarget.Component.Get() })
+		{
+			MovedComponent->TargetIndex = Index;
+		}
+	}
+
+	Targets.RemoveAtSwap(Index);
+}
+
+void UAimAssistTargetSubsystem::RefreshTargets()
+{
+	GEINPUT_LLM_SCOPE();
+
+	// Targets are refreshed round robin so that the cost per refresh is bounded
+
+	const auto NumToRefresh{ FMath::Min(Targets.Num(), FMath::Max(TargetsPerRefresh, 1)) };
+
+	for (int32 Count{ 0 }; (Count < NumToRefresh) && !Targets.IsEmpty(); ++Count)
+	{
+		if (NextRefreshIndex >= Targets.Num())
+		{
+			NextRefreshIndex = 0;
+		}
+
+		auto& Target{ Targets[NextRefreshIndex] };
+		auto* Component{ Target.Component.Get() };
+
+		// Components destroyed without EndPlay are dropped, the swapped in target is refreshed next
+
+		if (!Component)
+		{
+			RemoveTargetAt(NextRefreshIndex);
+			continue;
+		}
+
+		Target.Location = Component->GetComponentLocation();
+
+		const auto NewCell{ GetCell(Target.Location) };
+
+		if (NewCell != Target.Cell)
+		{
+			RemoveFromCell(Target.Cell, NextRefreshIndex);
+			AddToCell(NewCell, NextRefreshIndex);
+
+			Target.Cell = NewCell;
+		}
+
+		++NextRefreshIndex;
+	}
+}
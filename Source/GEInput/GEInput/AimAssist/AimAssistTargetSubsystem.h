@@ -0,0 +1,96 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "AimAssistTargetSubsystem.generated.h"
+
+class UAimAssistTargetComponent;
+
+
+/**
+ * Spatial hash of the aim assist targets of a world, shared by all local players
+ *
+ * Tips:
+ *	Target locations are refreshed at a fixed rate, a limited number of targets per refresh,
+ *	so that the cost does not depend on the number of players querying it.
+ *	Queries return the cached locations; use the component for the exact location.
+ */
+UCLASS(Config = Input)
+class GEINPUT_API UAimAssistTargetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UAimAssistTargetSubsystem() {}
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+protected:
+	struct FTarget
+	{
+		TWeakObjectPtr<UAimAssistTargetComponent> Component;
+		FVector Location{ FVector::ZeroVector };
+		FIntVector Cell{ FIntVector::ZeroValue };
+	};
+
+	//
+	// Edge length in cm of a spatial hash cell
+	//
+	UPROPERTY(Config)
+	float CellSize{ 1000.0f };
+
+	//
+	// Rate in Hz at which target locations are refreshed
+	//
+	UPROPERTY(Config)
+	float RefreshRate{ 20.0f };
+
+	//
+	// Maximum number of targets whose location is refreshed per refresh
+	//
+	UPROPERTY(Config)
+	int32 TargetsPerRefresh{ 64 };
+
+	TArray<FTarget> Targets;
+
+	//
+	// Indices into Targets of the targets inside each cell
+	//
+	TMap<FIntVector, TArray<int32, TInlineAllocator<8>>> Cells;
+
+	double RefreshAccumulator{ 0.0 };
+
+	int32 NextRefreshIndex{ 0 };
+
+public:
+	void RegisterTarget(UAimAssistTargetComponent* Component);
+	void UnregisterTarget(UAimAssistTargetComponent* Component);
+
+	/**
+	 * Calls the visitor with each enabled target whose cached location is within the radius of the center
+	 */
+	void ForEachTargetInRadius(const FVector& Center, float Radius, TFunctionRef<void(UAimAssistTargetComponent*, const FVector&)> Visitor) const;
+
+	int32 GetNumTargets() const { return Targets.Num(); }
+
+protected:
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(const FIntVector& Cell, int32 TargetIndex);
+	void RemoveFromCell(const FIntVector& Cell, int32 TargetIndex);
+
+	/**
+	 * Removes the target by moving the last target into its place
+	 */
+	void RemoveTargetAt(int32 Index);
+
+	void RefreshTargets();
+
+};
@@ -0,0 +1,66 @@
+// Copyright (C) 2024 owoDra
+
+#include "GameplayDebuggerCategory_GEInput.h"
+
+#if WITH_GAMEPLAY_DEBUGGER && !UE_BUILD_SHIPPING
+
+#include "InputProcessComponent.h"
+#include "Development/InputProcessorDebug.h"
+
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+
+FGameplayDebuggerCategory_GEInput::FGameplayDebuggerCategory_GEInput()
+{
+	CollectDataInterval = 0.5f;
+	bShowOnlyWithDebugActor = false;
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_GEInput::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_GEInput());
+}
+
+
+void FGameplayDebuggerCategory_GEInput::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	GEInputDebug::RequestProcessorStats();
+
+	// Debug the selected actor's controller if it is a player, otherwise the local player
+
+	auto* DebugPawn{ Cast<APawn>(DebugActor) };
+	auto* PlayerController{ DebugPawn ? Cast<APlayerController>(DebugPawn->GetController()) : Cast<APlayerController>(DebugActor) };
+	PlayerController = PlayerController ? PlayerController : OwnerPC;
+	DebugPawn = DebugPawn ? DebugPawn : (PlayerController ? PlayerController->GetPawn() : nullptr);
+
+	TArray<FString> Lines;
+
+	TArray<AActor*, TInlineAllocator<2>> Owners;
+	Owners.AddUnique(PlayerController);
+	Owners.AddUnique(DebugPawn);
+
+	for (auto* Owner : Owners)
+	{
+		if (Owner)
+		{
+			auto* InputComponent{ Cast<UInputProcessComponent>(Owner->InputComponent) };
+			InputComponent = InputComponent ? InputComponent : Owner->FindComponentByClass<UInputProcessComponent>();
+
+			GEInputDebug::DescribeInputComponent(InputComponent, Lines);
+		}
+	}
+
+	if (PlayerController)
+	{
+		Lines.Add(TEXT("Mapping Contexts:"));
+		GEInputDebug::DescribeMappingContexts(PlayerController, Lines);
+	}
+
+	for (const auto& Line : Lines)
+	{
+		AddTextLine(Line.StartsWith(TEXT(" ")) ? Line : FString::Printf(TEXT("{yellow}%s"), *Line));
+	}
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
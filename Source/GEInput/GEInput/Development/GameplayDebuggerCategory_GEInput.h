@@ -0,0 +1,32 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER && !UE_BUILD_SHIPPING
+
+#include "GameplayDebuggerCategory.h"
+
+class APlayerController;
+class AActor;
+
+
+/**
+ * Gameplay Debugger category that shows the processors, bindings and event rates of the debugged player
+ * and the mapping contexts added to its controller by game feature actions
+ *
+ * Tips:
+ *	Processor stats are only collected while this category is active.
+ */
+class FGameplayDebuggerCategory_GEInput : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_GEInput();
+
+public:
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
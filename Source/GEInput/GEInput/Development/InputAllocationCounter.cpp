@@ -0,0 +1,138 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputAllocationCounter.h"
+
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace GEInputAllocationCounter
+{
+	static thread_local uint64* ActiveCounter{ nullptr };
+
+	static bool bInstalled{ false };
+
+	/**
+	 * Forwards every call to the original allocator and counts the allocations of threads that own a scope
+	 *
+	 * Tips:
+	 *	Every virtual of FMalloc whose default implementation does not end up in Malloc, Realloc or Free must be overridden here,
+	 *	otherwise the default would answer instead of the original allocator (for example GetAllocationSize returning false,
+	 *	Trim or the TLS cache notifications doing nothing). MallocZeroed and the other defaults built on Malloc are forwarded through it.
+	 *	Install verifies the forwarding of allocation, reallocation, size queries and trimming before the proxy replaces GMalloc.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+	private:
+		FMalloc* Inner{ nullptr };
+
+		static FORCEINLINE void Count()
+		{
+			if (auto* Counter{ ActiveCounter })
+			{
+				++(*Counter);
+			}
+		}
+
+	public:
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Count(); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Count(); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override { Count(); return Inner->Realloc(Original, Size, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override { Count(); return Inner->TryRealloc(Original, Size, Alignment); }
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+		virtual void OnMallocInitialized() override { Inner->OnMallocInitialized(); }
+		virtual void OnPreFork() override { Inner->OnPreFork(); }
+		virtual void OnPostFork() override { Inner->OnPostFork(); }
+
+	public:
+		/**
+		 * Returns true if the proxy answers like the original allocator and counts allocations and reallocations
+		 */
+		bool VerifyForwarding()
+		{
+			uint64 NumCounted{ 0 };
+
+			auto* PreviousCounter{ ActiveCounter };
+			ActiveCounter = &NumCounted;
+
+			auto* Block{ Malloc(64, DEFAULT_ALIGNMENT) };
+			Block = Realloc(Block, 256, DEFAULT_ALIGNMENT);
+
+			ActiveCounter = PreviousCounter;
+
+			SIZE_T ProxySize{ 0 };
+			SIZE_T InnerSize{ 0 };
+			const auto bSameSize{ GetAllocationSize(Block, ProxySize) == Inner->GetAllocationSize(Block, InnerSize) && (ProxySize == InnerSize) };
+
+			Free(Block);
+			Trim(false);
+
+			return (NumCounted == 2) && bSameSize && (QuantizeSize(100, DEFAULT_ALIGNMENT) == Inner->QuantizeSize(100, DEFAULT_ALIGNMENT));
+		}
+	};
+}
+
+
+FInputAllocationScope::FInputAllocationScope()
+{
+	PreviousCounter = GEInputAllocationCounter::ActiveCounter;
+	GEInputAllocationCounter::ActiveCounter = &Count;
+}
+
+FInputAllocationScope::~FInputAllocationScope()
+{
+	GEInputAllocationCounter::ActiveCounter = PreviousCounter;
+
+	if (PreviousCounter)
+	{
+		*PreviousCounter += Count;
+	}
+}
+
+
+bool FInputAllocationScope::IsCounting()
+{
+	return GEInputAllocationCounter::bInstalled;
+}
+
+void FInputAllocationScope::Startup()
+{
+	if (GEInputAllocationCounter::bInstalled || !GMalloc || !FParse::Param(FCommandLine::Get(), TEXT("GEInputCountAllocations")))
+	{
+		return;
+	}
+
+	// Blocks allocated before the proxy are freed through it into the same allocator, so the swap only has to be atomic.
+	// The proxy is intentionally never deleted, other threads may still be inside it.
+	// Systems that cached GMalloc before the module started keep allocating past the proxy and are not counted.
+
+	auto* Proxy{ new GEInputAllocationCounter::FCountingMalloc(GMalloc) };
+
+	checkf(Proxy->VerifyForwarding(), TEXT("The GEInput allocation counting proxy does not forward to %s like the original allocator"), GMalloc->GetDescriptiveName());
+
+	FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), Proxy);
+
+	GEInputAllocationCounter::bInstalled = true;
+}
+
+#endif
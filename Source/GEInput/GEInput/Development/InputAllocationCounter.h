@@ -0,0 +1,48 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Counts heap allocations made by the current thread while a scope is active
+ *
+ * Tips:
+ *	Counting requires the forwarding proxy in front of GMalloc, which is installed once while the module starts up
+ *	when -GEInputCountAllocations is on the command line, and never while the game is running.
+ *	The proxy forwards every FMalloc virtual to the original allocator and checks on startup that it answers like it.
+ *	Without it scopes count nothing and IsCounting returns false.
+ *	Only allocations of threads that currently own a scope are counted, other threads only pay one TLS read.
+ */
+class GEINPUT_API FInputAllocationScope
+{
+public:
+	FInputAllocationScope();
+	~FInputAllocationScope();
+
+private:
+	uint64 Count{ 0 };
+	uint64* PreviousCounter{ nullptr };
+
+public:
+	/**
+	 * Returns number of allocations and reallocations made by this thread since the scope was opened
+	 */
+	uint64 GetNumAllocations() const { return Count; }
+
+	/**
+	 * Returns true if the counting proxy is installed
+	 */
+	static bool IsCounting();
+
+	/**
+	 * Installs the counting proxy in front of GMalloc if requested on the command line.
+	 * Called by the module on startup.
+	 */
+	static void Startup();
+
+};
+
+#endif
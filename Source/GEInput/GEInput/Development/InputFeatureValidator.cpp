@@ -0,0 +1,526 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputFeatureValidator.h"
+
+#if WITH_EDITOR
+
+#include "GameFeature/GameFeatureAction_AddInputContextMapping.h"
+#include "GameFeature/GameFeatureAction_AddInputProcessors.h"
+#include "Processor/InputProcessor.h"
+
+#include "GameFeatureData.h"
+#include "InputMappingContext.h"
+#include "InputAction.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/StreamableManager.h"
+#include "Async/ParallelFor.h"
+#include "Misc/DataValidation.h"
+
+
+namespace GEInputFeatureValidation
+{
+	static const uint8 TriggerEventFlags[]
+	{
+		static_cast<uint8>(ETriggerEvent::Triggered),
+		static_cast<uint8>(ETriggerEvent::Started),
+		static_cast<uint8>(ETriggerEvent::Ongoing),
+		static_cast<uint8>(ETriggerEvent::Canceled),
+		static_cast<uint8>(ETriggerEvent::Completed),
+	};
+
+	static FString GetTriggerEventName(uint8 TriggerEvent)
+	{
+		return StaticEnum<ETriggerEvent>()->GetNameStringByValue(TriggerEvent);
+	}
+
+	static FString JoinPaths(const TArray<FSoftObjectPath>& Paths)
+	{
+		return FString::JoinBy(Paths, TEXT(", "), [](const FSoftObjectPath& Path) { return Path.GetAssetName(); });
+	}
+}
+
+
+void FInputFeatureValidator::ValidateOwningFeature(const UGameFeatureAction* Action, FDataValidationContext& Context)
+{
+	const auto* FeatureData{ Action ? Action->GetTypedOuter<UGameFeatureData>() : nullptr };
+
+	if (!FeatureData)
+	{
+		return;
+	}
+
+	const auto* FirstInputAction
+	{
+		FeatureData->GetActions().FindByPredicate([](const UGameFeatureAction* Each)
+		{
+			return Each && (Each->IsA<UGameFeatureAction_AddInputProcessors>() || Each->IsA<UGameFeatureAction_AddInputContextMapping>());
+		})
+	};
+
+	if (!FirstInputAction || (*FirstInputAction != Action))
+	{
+		return;
+	}
+
+	// Overlaps within the owning feature, the GEInputFeatureValidation commandlet checks across features
+
+	FInputFeatureValidator Validator;
+	Validator.AddFeature(FeatureData);
+	Validator.Run();
+
+	for (const auto& Issue : Validator.GetIssues())
+	{
+		Context.AddWarning(FText::FromString(Issue.Message));
+	}
+}
+
+
+void FInputFeatureValidator::AddFeature(const UGameFeatureData* FeatureData)
+{
+	if (FeatureData)
+	{
+		AddFeatures(MakeArrayView(&FeatureData, 1));
+	}
+}
+
+int32 FInputFeatureValidator::AddAllFeatures()
+{
+	TArray<FAssetData> Assets;
+	IAssetRegistry::GetChecked().GetAssetsByClass(UGameFeatureData::StaticClass()->GetClassPathName(), Assets, true);
+
+	TArray<FSoftObjectPath> Paths;
+	Paths.Reserve(Assets.Num());
+
+	for (const auto& Asset : Assets)
+	{
+		Paths.Add(Asset.GetSoftObjectPath());
+	}
+
+	const auto LoadedAssets{ LoadAssets(Paths) };
+
+	TArray<const UGameFeatureData*> Features;
+	Features.Reserve(LoadedAssets.Num());
+
+	for (const auto& KVP : LoadedAssets)
+	{
+		if (const auto* FeatureData{ Cast<UGameFeatureData>(KVP.Value) })
+		{
+			Features.Add(FeatureData);
+		}
+	}
+
+	AddFeatures(Features);
+
+	return Features.Num();
+}
+
+void FInputFeatureValidator::AddFeatures(TConstArrayView<const UGameFeatureData*> Features)
+{
+	const auto FirstIndex{ FeaturePaths.Num() };
+
+	for (const auto* FeatureData : Features)
+	{
+		FeaturePaths.Add(FSoftObjectPath(FeatureData));
+	}
+
+	// Entries only read the loaded actions and are collected per feature in parallel
+
+	TArray<TArray<FProcessorEntry>> FeatureProcessorEntries;
+	TArray<TArray<FMappingEntry>> FeatureMappingEntries;
+	FeatureProcessorEntries.SetNum(Features.Num());
+	FeatureMappingEntries.SetNum(Features.Num());
+
+	ParallelFor(Features.Num(),
+		[&](int32 Index)
+		{
+			const auto FeatureIndex{ FirstIndex + Index };
+
+			for (const auto& Action : Features[Index]->GetActions())
+			{
+				if (const auto* AddProcessors{ Cast<UGameFeatureAction_AddInputProcessors>(Action) })
+				{
+					for (const auto& Entry : AddProcessors->GetInputProcessors())
+					{
+						for (const auto& Processor : Entry.Processors)
+						{
+							if (!Entry.ActorClass.IsNull() && !Processor.IsNull())
+							{
+								FeatureProcessorEntries[Index].Add({ FeatureIndex, Entry.ActorClass.ToSoftObjectPath(), Processor.ToSoftObjectPath() });
+							}
+						}
+					}
+				}
+				else if (const auto* AddMappings{ Cast<UGameFeatureAction_AddInputContextMapping>(Action) })
+				{
+					for (const auto& Entry : AddMappings->GetInputMappings())
+					{
+						if (!Entry.InputMapping.IsNull())
+						{
+							FeatureMappingEntries[Index].Add({ FeatureIndex, Entry.InputMapping.ToSoftObjectPath(), Entry.Priority });
+						}
+					}
+				}
+			}
+		});
+
+	for (auto Index{ 0 }; Index < Features.Num(); ++Index)
+	{
+		ProcessorEntries.Append(MoveTemp(FeatureProcessorEntries[Index]));
+		MappingEntries.Append(MoveTemp(FeatureMappingEntries[Index]));
+	}
+}
+
+
+void FInputFeatureValidator::Run()
+{
+	Issues.Reset();
+
+	// Load every referenced class and context in one batch
+
+	TSet<FSoftObjectPath> UniquePaths;
+
+	for (const auto& Entry : ProcessorEntries)
+	{
+		UniquePaths.Add(Entry.ActorClass);
+		UniquePaths.Add(Entry.ProcessorClass);
+	}
+
+	for (const auto& Entry : MappingEntries)
+	{
+		UniquePaths.Add(Entry.MappingContext);
+	}
+
+	const auto LoadedAssets{ LoadAssets(UniquePaths.Array()) };
+
+	TMap<FSoftObjectPath, UClass*> ActorClasses;
+	TArray<TPair<FSoftObjectPath, const UInputProcessor*>> ProcessorDefaults;
+	TSet<FSoftObjectPath> VisitedProcessors;
+
+	for (const auto& Entry : ProcessorEntries)
+	{
+		if (auto* ActorClass{ Cast<UClass>(LoadedAssets.FindRef(Entry.ActorClass)) })
+		{
+			ActorClasses.Add(Entry.ActorClass, ActorClass);
+		}
+
+		if (const auto* ProcessorClass{ Cast<UClass>(LoadedAssets.FindRef(Entry.ProcessorClass)) }; ProcessorClass && !VisitedProcessors.Contains(Entry.ProcessorClass))
+		{
+			VisitedProcessors.Add(Entry.ProcessorClass);
+			ProcessorDefaults.Emplace(Entry.ProcessorClass, Cast<UInputProcessor>(ProcessorClass->GetDefaultObject()));
+		}
+	}
+
+	// Bindings are read from the class default objects in parallel
+
+	TArray<FProcessorBindings> ProcessorBindings;
+	ProcessorBindings.SetNum(ProcessorDefaults.Num());
+
+	ParallelFor(ProcessorDefaults.Num(),
+		[&](int32 Index)
+		{
+			if (const auto* Processor{ ProcessorDefaults[Index].Value })
+			{
+				const auto TriggerEvents{ Processor->GetBoundTriggerEvents() };
+
+				for (const auto& KVP : Processor->GetInputActions())
+				{
+					if (KVP.Key.IsValid() && KVP.Value)
+					{
+						ProcessorBindings[Index].Actions.Emplace(FSoftObjectPath(KVP.Value.Get()), TriggerEvents);
+					}
+				}
+			}
+		});
+
+	TMap<FSoftObjectPath, FProcessorBindings> Bindings;
+	Bindings.Reserve(ProcessorDefaults.Num());
+
+	for (auto Index{ 0 }; Index < ProcessorDefaults.Num(); ++Index)
+	{
+		Bindings.Add(ProcessorDefaults[Index].Key, MoveTemp(ProcessorBindings[Index]));
+	}
+
+	FindDuplicateProcessors(ActorClasses);
+	FindOverlappingBindings(ActorClasses, Bindings);
+	FindMappingConflicts();
+}
+
+
+void FInputFeatureValidator::FindDuplicateProcessors(const TMap<FSoftObjectPath, UClass*>& ActorClasses)
+{
+	TSet<FString> ReportedKeys;
+
+	for (const auto& ActorClassPair : ActorClasses)
+	{
+		const auto Entries{ GetEffectiveEntries(ActorClassPair.Value, ActorClasses) };
+
+		TMap<FSoftObjectPath, TArray<const FProcessorEntry*>> EntriesByProcessor;
+
+		for (const auto* Entry : Entries)
+		{
+			EntriesByProcessor.FindOrAdd(Entry->ProcessorClass).Add(Entry);
+		}
+
+		for (const auto& KVP : EntriesByProcessor)
+		{
+			if (KVP.Value.Num() < 2)
+			{
+				continue;
+			}
+
+			TArray<int32> FeatureIndices;
+			TArray<FSoftObjectPath> AddedTo;
+			FString Key{ KVP.Key.ToString() };
+
+			for (const auto* Entry : KVP.Value)
+			{
+				FeatureIndices.AddUnique(Entry->FeatureIndex);
+				AddedTo.AddUnique(Entry->ActorClass);
+				Key += FString::Printf(TEXT("|%d"), static_cast<int32>(Entry - ProcessorEntries.GetData()));
+			}
+
+			if (!ReportedKeys.Contains(Key))
+			{
+				ReportedKeys.Add(Key);
+
+				AddIssue(EInputFeatureIssueType::DuplicateProcessor,
+					FString::Printf(TEXT("%s is added %d times to %s (through %s)"),
+						*KVP.Key.GetAssetName(), KVP.Value.Num(), *ActorClassPair.Key.GetAssetName(), *GEInputFeatureValidation::JoinPaths(AddedTo)),
+					FeatureIndices);
+			}
+		}
+	}
+}
+
+void FInputFeatureValidator::FindOverlappingBindings(const TMap<FSoftObjectPath, UClass*>& ActorClasses, const TMap<FSoftObjectPath, FProcessorBindings>& Bindings)
+{
+	TSet<FString> ReportedKeys;
+
+	for (const auto& ActorClassPair : ActorClasses)
+	{
+		const auto Entries{ GetEffectiveEntries(ActorClassPair.Value, ActorClasses) };
+
+		// Action and trigger event to the distinct processors binding them
+
+		TMap<TPair<FSoftObjectPath, uint8>, TArray<const FProcessorEntry*>> EntriesByBinding;
+
+		for (const auto* Entry : Entries)
+		{
+			const auto* ProcessorBindings{ Bindings.Find(Entry->ProcessorClass) };
+
+			if (!ProcessorBindings)
+			{
+				continue;
+			}
+
+			for (const auto& Action : ProcessorBindings->Actions)
+			{
+				for (const auto TriggerEvent : GEInputFeatureValidation::TriggerEventFlags)
+				{
+					if (Action.Value & TriggerEvent)
+					{
+						auto& BindingEntries{ EntriesByBinding.FindOrAdd({ Action.Key, TriggerEvent }) };
+
+						if (!BindingEntries.ContainsByPredicate([Entry](const FProcessorEntry* Each) { return Each->ProcessorClass == Entry->ProcessorClass; }))
+						{
+							BindingEntries.Add(Entry);
+						}
+					}
+				}
+			}
+		}
+
+		for (const auto& KVP : EntriesByBinding)
+		{
+			if (KVP.Value.Num() < 2)
+			{
+				continue;
+			}
+
+			TArray<int32> FeatureIndices;
+			TArray<FSoftObjectPath> Processors;
+
+			for (const auto* Entry : KVP.Value)
+			{
+				FeatureIndices.AddUnique(Entry->FeatureIndex);
+				Processors.Add(Entry->ProcessorClass);
+			}
+
+			Processors.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+
+			const auto Key{ FString::Printf(TEXT("%s|%d|%s"), *KVP.Key.Key.ToString(), KVP.Key.Value, *GEInputFeatureValidation::JoinPaths(Processors)) };
+
+			if (!ReportedKeys.Contains(Key))
+			{
+				ReportedKeys.Add(Key);
+
+				AddIssue(EInputFeatureIssueType::OverlappingBinding,
+					FString::Printf(TEXT("%s (%s) is bound by %s on %s and is dispatched once per processor"),
+						*KVP.Key.Key.GetAssetName(), *GEInputFeatureValidation::GetTriggerEventName(KVP.Key.Value),
+						*GEInputFeatureValidation::JoinPaths(Processors), *ActorClassPair.Key.GetAssetName()),
+					FeatureIndices);
+			}
+		}
+	}
+}
+
+void FInputFeatureValidator::FindMappingConflicts()
+{
+	// The same context added with different priorities
+
+	TMap<FSoftObjectPath, TArray<const FMappingEntry*>> EntriesByContext;
+
+	for (const auto& Entry : MappingEntries)
+	{
+		EntriesByContext.FindOrAdd(Entry.MappingContext).Add(&Entry);
+	}
+
+	for (const auto& KVP : EntriesByContext)
+	{
+		TArray<int32> Priorities;
+		TArray<int32> FeatureIndices;
+
+		for (const auto* Entry : KVP.Value)
+		{
+			Priorities.AddUnique(Entry->Priority);
+			FeatureIndices.AddUnique(Entry->FeatureIndex);
+		}
+
+		if (Priorities.Num() > 1)
+		{
+			AddIssue(EInputFeatureIssueType::MappingPriority,
+				FString::Printf(TEXT("%s is added with different priorities (%s), the priority depends on the activation order"),
+					*KVP.Key.GetAssetName(), *FString::JoinBy(Priorities, TEXT(", "), [](int32 Priority) { return FString::FromInt(Priority); })),
+				FeatureIndices);
+		}
+	}
+
+	// Different contexts with the same priority that map the same keys
+
+	TMap<int32, TArray<FSoftObjectPath>> ContextsByPriority;
+
+	for (const auto& Entry : MappingEntries)
+	{
+		ContextsByPriority.FindOrAdd(Entry.Priority).AddUnique(Entry.MappingContext);
+	}
+
+	TMap<FSoftObjectPath, int32> ContextIndices;
+	TArray<const UInputMappingContext*> Contexts;
+
+	for (const auto& KVP : EntriesByContext)
+	{
+		ContextIndices.Add(KVP.Key, Contexts.Add(Cast<UInputMappingContext>(KVP.Key.ResolveObject())));
+	}
+
+	TArray<TSet<FKey>> ContextKeys;
+	ContextKeys.SetNum(Contexts.Num());
+
+	ParallelFor(Contexts.Num(),
+		[&](int32 Index)
+		{
+			if (const auto* MappingContext{ Contexts[Index] })
+			{
+				for (const auto& Mapping : MappingContext->GetMappings())
+				{
+					ContextKeys[Index].Add(Mapping.Key);
+				}
+			}
+		});
+
+	for (const auto& KVP : ContextsByPriority)
+	{
+		const auto& SamePriority{ KVP.Value };
+
+		for (auto A{ 0 }; A < SamePriority.Num(); ++A)
+		{
+			for (auto B{ A + 1 }; B < SamePriority.Num(); ++B)
+			{
+				const auto& KeysA{ ContextKeys[ContextIndices[SamePriority[A]]] };
+				const auto& KeysB{ ContextKeys[ContextIndices[SamePriority[B]]] };
+				const auto SharedKeys{ KeysA.Intersect(KeysB) };
+
+				if (SharedKeys.IsEmpty())
+				{
+					continue;
+				}
+
+				TArray<int32> FeatureIndices;
+
+				for (const auto* Entry : EntriesByContext[SamePriority[A]])
+				{
+					FeatureIndices.AddUnique(Entry->FeatureIndex);
+				}
+
+				for (const auto* Entry : EntriesByContext[SamePriority[B]])
+				{
+					FeatureIndices.AddUnique(Entry->FeatureIndex);
+				}
+
+				AddIssue(EInputFeatureIssueType::MappingPriority,
+					FString::Printf(TEXT("%s and %s have the same priority (%d) and both map %s"),
+						*SamePriority[A].GetAssetName(), *SamePriority[B].GetAssetName(), KVP.Key,
+						*FString::JoinBy(SharedKeys, TEXT(", "), [](const FKey& Key) { return Key.ToString(); })),
+					FeatureIndices);
+			}
+		}
+	}
+}
+
+
+TArray<const FInputFeatureValidator::FProcessorEntry*> FInputFeatureValidator::GetEffectiveEntries(const UClass* ActorClass, const TMap<FSoftObjectPath, UClass*>& ActorClasses) const
+{
+	TArray<const FProcessorEntry*> Entries;
+
+	for (const auto& Entry : ProcessorEntries)
+	{
+		if (const auto* EntryActorClass{ ActorClasses.FindRef(Entry.ActorClass) }; EntryActorClass && ActorClass->IsChildOf(EntryActorClass))
+		{
+			Entries.Add(&Entry);
+		}
+	}
+
+	return Entries;
+}
+
+void FInputFeatureValidator::AddIssue(EInputFeatureIssueType Type, FString&& Message, TConstArrayView<int32> FeatureIndices)
+{
+	auto& NewIssue{ Issues.AddDefaulted_GetRef() };
+	NewIssue.Type = Type;
+	NewIssue.Message = MoveTemp(Message);
+
+	for (const auto FeatureIndex : FeatureIndices)
+	{
+		NewIssue.Features.Add(FeaturePaths[FeatureIndex]);
+	}
+}
+
+TMap<FSoftObjectPath, UObject*> FInputFeatureValidator::LoadAssets(const TArray<FSoftObjectPath>& Paths)
+{
+	TMap<FSoftObjectPath, UObject*> LoadedAssets;
+
+	if (Paths.IsEmpty())
+	{
+		return LoadedAssets;
+	}
+
+	// Packages are loaded concurrently by the async loader, the handle keeps them alive until resolved
+
+	FStreamableManager StreamableManager;
+
+	if (const auto Handle{ StreamableManager.RequestAsyncLoad(Paths) })
+	{
+		Handle->WaitUntilComplete();
+	}
+
+	for (const auto& Path : Paths)
+	{
+		if (auto* Object{ Path.ResolveObject() })
+		{
+			LoadedAssets.Add(Path, Object);
+		}
+	}
+
+	return LoadedAssets;
+}
+
+#endif // WITH_EDITOR
@@ -0,0 +1,138 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+#if WITH_EDITOR
+
+class UGameFeatureData;
+class UGameFeatureAction;
+class FDataValidationContext;
+
+
+/**
+ * Kind of overlap found between the input configurations of game features
+ */
+enum class EInputFeatureIssueType : uint8
+{
+	// A processor is added more than once to the same actor class or to one of its parent classes
+	DuplicateProcessor,
+
+	// Different processors added to the same actor class bind the same input action and trigger event
+	OverlappingBinding,
+
+	// A mapping context is added with different priorities, or contexts with the same priority map the same key
+	MappingPriority,
+};
+
+
+/**
+ * Overlap found by FInputFeatureValidator
+ */
+struct GEINPUT_API FInputFeatureValidationIssue
+{
+public:
+	EInputFeatureIssueType Type{ EInputFeatureIssueType::DuplicateProcessor };
+
+	FString Message;
+
+	//
+	// Game feature data assets involved in the issue
+	//
+	TArray<FSoftObjectPath> Features;
+};
+
+
+/**
+ * Finds input processors and mapping contexts of game features that overlap at runtime and cause double dispatch
+ *
+ * Tips:
+ *	Assets are loaded in batches and their entries are collected in parallel, then compared on the calling thread.
+ *	Used by UGEInputFeatureValidationCommandlet for the whole project and by the game feature actions for their own feature.
+ *	Authoring time only, compiled in editor builds.
+ */
+class GEINPUT_API FInputFeatureValidator
+{
+public:
+	FInputFeatureValidator() {}
+
+protected:
+	struct FProcessorEntry
+	{
+		int32 FeatureIndex{ INDEX_NONE };
+		FSoftObjectPath ActorClass;
+		FSoftObjectPath ProcessorClass;
+	};
+
+	struct FMappingEntry
+	{
+		int32 FeatureIndex{ INDEX_NONE };
+		FSoftObjectPath MappingContext;
+		int32 Priority{ 0 };
+	};
+
+	struct FProcessorBindings
+	{
+		//
+		// Input actions bound by the processor and the trigger events bound to them as ETriggerEvent flags
+		//
+		TArray<TPair<FSoftObjectPath, uint8>> Actions;
+	};
+
+	TArray<FSoftObjectPath> FeaturePaths;
+
+	TArray<FProcessorEntry> ProcessorEntries;
+	TArray<FMappingEntry> MappingEntries;
+
+	TArray<FInputFeatureValidationIssue> Issues;
+
+public:
+	/**
+	 * Adds a loaded game feature data asset to the validation
+	 */
+	void AddFeature(const UGameFeatureData* FeatureData);
+
+	/**
+	 * Loads and adds every game feature data asset known to the asset registry, returns the number of added features
+	 */
+	int32 AddAllFeatures();
+
+	/**
+	 * Compares the entries of the added features and collects the issues
+	 */
+	void Run();
+
+	const TArray<FInputFeatureValidationIssue>& GetIssues() const { return Issues; }
+
+	int32 GetNumFeatures() const { return FeaturePaths.Num(); }
+
+	/**
+	 * Validates the game feature owning the action and adds the issues to the context as warnings.
+	 * Only the first input action of the feature runs the validation, so that each issue is reported once per feature.
+	 */
+	static void ValidateOwningFeature(const UGameFeatureAction* Action, FDataValidationContext& Context);
+
+protected:
+	void AddFeatures(TConstArrayView<const UGameFeatureData*> Features);
+
+	void FindDuplicateProcessors(const TMap<FSoftObjectPath, UClass*>& ActorClasses);
+	void FindOverlappingBindings(const TMap<FSoftObjectPath, UClass*>& ActorClasses, const TMap<FSoftObjectPath, FProcessorBindings>& Bindings);
+	void FindMappingConflicts();
+
+	/**
+	 * Returns the entries added to the actor class or to one of its parent classes
+	 */
+	TArray<const FProcessorEntry*> GetEffectiveEntries(const UClass* ActorClass, const TMap<FSoftObjectPath, UClass*>& ActorClasses) const;
+
+	void AddIssue(EInputFeatureIssueType Type, FString&& Message, TConstArrayView<int32> FeatureIndices);
+
+	/**
+	 * Loads the assets in one batch and returns them by path
+	 */
+	static TMap<FSoftObjectPath, UObject*> LoadAssets(const TArray<FSoftObjectPath>& Paths);
+
+};
+
+#endif // WITH_EDITOR
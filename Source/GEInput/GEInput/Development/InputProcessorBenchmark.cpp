@@ -0,0 +1,456 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputProcessorBenchmark.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "InputProcessComponent.h"
+#include "Processor/InputProcessor.h"
+#include "Development/InputProcessor_Benchmark.h"
+#include "Development/InputAllocationCounter.h"
+#include "Record/InputPlayer.h"
+#include "GEInputLogs.h"
+
+#include "InputAction.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+
+namespace GEInputBenchmark
+{
+	struct FScenario
+	{
+		FString Name;
+		TArray<UClass*> ProcessorClasses;
+	};
+
+	static double CyclesToNanoseconds(uint64 Cycles)
+	{
+		return static_cast<double>(Cycles) * FPlatformTime::GetSecondsPerCycle64() * 1000000000.0;
+	}
+
+	//
+	// Processors of a component that bind an input tag and the trigger events they bind, as EnhancedInput would call them
+	//
+	using FBoundProcessors = TMap<FGameplayTag, TArray<TPair<UInputProcessor*, uint8>, TInlineAllocator<4>>>;
+
+	static FBoundProcessors GetBoundProcessors(const UInputProcessComponent* Component)
+	{
+		FBoundProcessors BoundProcessors;
+
+		for (const auto& KVP : Component->GetInputProcessors())
+		{
+			if (auto* Processor{ KVP.Value.Get() })
+			{
+				for (const auto& Action : Processor->GetInputActions())
+				{
+					if (Action.Key.IsValid() && Action.Value)
+					{
+						BoundProcessors.FindOrAdd(Action.Key).Emplace(Processor, Processor->GetBoundTriggerEvents());
+					}
+				}
+			}
+		}
+
+		return BoundProcessors;
+	}
+
+	static int32 CountBindings(const TArray<UInputProcessComponent*>& Components)
+	{
+		auto Count{ 0 };
+		for (const auto* Component : Components)
+		{
+			Count += Component->GetActionEventBindings().Num();
+		}
+		return Count;
+	}
+
+	/**
+	 * Builds the event stream injected to each component, either from a recording or from the tags bound by the processors
+	 */
+	static TArray<FInputRecordEvent> BuildEventStream(const FInputProcessorBenchmarkSettings& Settings, const TArray<UClass*>& ProcessorClasses)
+	{
+		TArray<FInputRecordEvent> Events;
+		Events.Reserve(Settings.NumEvents);
+
+		if (!Settings.RecordingFilename.IsEmpty())
+		{
+			FInputPlayer Player;
+			if (Player.Open(Settings.RecordingFilename))
+			{
+				FInputRecordEvent Event;
+				while ((Events.Num() < Settings.NumEvents) && Player.ReadNextEvent(Event))
+				{
+					Events.Add(Event);
+				}
+			}
+
+			return Events;
+		}
+
+		TArray<FGameplayTag> Tags;
+		for (const auto* Class : ProcessorClasses)
+		{
+			for (const auto& KVP : GetDefault<UInputProcessor>(Class)->GetInputActions())
+			{
+				if (KVP.Value && KVP.Key.IsValid())
+				{
+					Tags.AddUnique(KVP.Key);
+				}
+			}
+		}
+
+		if (Tags.IsEmpty())
+		{
+			return Events;
+		}
+
+		// Each tag receives a short press: Started, 8 x Triggered, Completed
+
+		for (int32 Index{ 0 }; Index < Settings.NumEvents; ++Index)
+		{
+			const auto Phase{ Index % 10 };
+
+			FInputRecordEvent& Event{ Events.AddDefaulted_GetRef() };
+			Event.Frame = Index / 10;
+			Event.InputTag = Tags[(Index / 10) % Tags.Num()];
+			Event.TriggerEvent = (Phase == 0) ? ETriggerEvent::Started : (Phase == 9) ? ETriggerEvent::Completed : ETriggerEvent::Triggered;
+			Event.Value = FInputActionValue(FVector2D(FMath::Sin(Index * 0.1), FMath::Cos(Index * 0.1)));
+		}
+
+		return Events;
+	}
+
+	static void RunScenario(UWorld* World, const FScenario& Scenario, int32 NumActors, const TArray<FInputRecordEvent>& Events, FInputProcessorBenchmarkResult& OutResult)
+	{
+		TArray<AActor*> Actors;
+		TArray<UInputProcessComponent*> Components;
+
+		for (int32 Index{ 0 }; Index < NumActors; ++Index)
+		{
+			auto* Actor{ World->SpawnActor<AActor>() };
+			auto* Component{ NewObject<UInputProcessComponent>(Actor) };
+			Component->RegisterComponent();
+
+			Actors.Add(Actor);
+			Components.Add(Component);
+		}
+
+		const auto NumProcessors{ FMath::Max(1, NumActors * Scenario.ProcessorClasses.Num()) };
+		const auto NumDispatched{ FMath::Max(1, NumActors * Events.Num()) };
+
+		OutResult.Scenario = Scenario.Name;
+		OutResult.NumActors = NumActors;
+		OutResult.NumProcessors = NumActors * Scenario.ProcessorClasses.Num();
+		OutResult.NumEvents = Events.Num();
+
+		// AddInputProcessor
+
+		const auto BindingsBefore{ CountBindings(Components) };
+		{
+			FInputAllocationScope AllocationScope;
+			const auto StartCycles{ FPlatformTime::Cycles64() };
+
+			for (auto* Component : Components)
+			{
+				for (auto* Class : Scenario.ProcessorClasses)
+				{
+					Component->AddInputProcessor(Class);
+				}
+			}
+
+			OutResult.AddNsPerProcessor = CyclesToNanoseconds(FPlatformTime::Cycles64() - StartCycles) / NumProcessors;
+			OutResult.AddAllocsPerProcessor = static_cast<double>(AllocationScope.GetNumAllocations()) / NumProcessors;
+		}
+		OutResult.NumBindingsCreated = CountBindings(Components) - BindingsBefore;
+
+		// Dispatch through the handlers of the bound actions, which is the path of live input
+
+		TArray<FBoundProcessors> BoundProcessors;
+		BoundProcessors.Reserve(Components.Num());
+
+		for (const auto* Component : Components)
+		{
+			BoundProcessors.Add(GetBoundProcessors(Component));
+		}
+
+		{
+			FInputAllocationScope AllocationScope;
+			const auto StartCycles{ FPlatformTime::Cycles64() };
+
+			for (const auto& Event : Events)
+			{
+				const auto EventFlag{ static_cast<uint8>(Event.TriggerEvent) };
+
+				for (const auto& ComponentProcessors : BoundProcessors)
+				{
+					if (const auto* Processors{ ComponentProcessors.Find(Event.InputTag) })
+					{
+						for (const auto& Pair : *Processors)
+						{
+							if (Pair.Value & EventFlag)
+							{
+								Pair.Key->SimulateBoundInputEvent(Event.TriggerEvent, Event.InputTag, Event.Value);
+							}
+						}
+					}
+				}
+			}
+
+			OutResult.DispatchNsPerEvent = CyclesToNanoseconds(FPlatformTime::Cycles64() - StartCycles) / NumDispatched;
+			OutResult.DispatchAllocsPerEvent = static_cast<double>(AllocationScope.GetNumAllocations()) / NumDispatched;
+		}
+
+		// RemoveAllInputProcessors
+
+		{
+			FInputAllocationScope AllocationScope;
+			const auto StartCycles{ FPlatformTime::Cycles64() };
+
+			for (auto* Component : Components)
+			{
+				Component->RemoveAllInputProcessors();
+			}
+
+			OutResult.RemoveNsPerProcessor = CyclesToNanoseconds(FPlatformTime::Cycles64() - StartCycles) / NumProcessors;
+			OutResult.RemoveAllocsPerProcessor = static_cast<double>(AllocationScope.GetNumAllocations()) / NumProcessors;
+		}
+
+		// Reported as -1 when allocations are not counted
+
+		if (!FInputAllocationScope::IsCounting())
+		{
+			OutResult.AddAllocsPerProcessor = -1.0;
+			OutResult.DispatchAllocsPerEvent = -1.0;
+			OutResult.RemoveAllocsPerProcessor = -1.0;
+		}
+
+		for (auto* Actor : Actors)
+		{
+			World->DestroyActor(Actor);
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+}
+
+
+// FInputProcessorBenchmarkSettings
+
+FInputProcessorBenchmarkSettings FInputProcessorBenchmarkSettings::FromCommandLine(const TCHAR* CommandLine)
+{
+	FInputProcessorBenchmarkSettings Settings;
+
+	FString ActorsString;
+	if (FParse::Value(CommandLine, TEXT("GEInputBenchActors="), ActorsString, false))
+	{
+		TArray<FString> Parts;
+		ActorsString.ParseIntoArray(Parts, TEXT(","));
+
+		Settings.NumActors.Reset();
+		for (const auto& Part : Parts)
+		{
+			const auto Value{ FCString::Atoi(*Part) };
+			if (Value > 0)
+			{
+				Settings.NumActors.Add(Value);
+			}
+		}
+	}
+
+	FParse::Value(CommandLine, TEXT("GEInputBenchEvents="), Settings.NumEvents);
+	Settings.NumEvents = FMath::Max(Settings.NumEvents, 1);
+
+	FString BlueprintsString;
+	if (FParse::Value(CommandLine, TEXT("GEInputBenchBlueprints="), BlueprintsString, false))
+	{
+		TArray<FString> Parts;
+		BlueprintsString.ParseIntoArray(Parts, TEXT("+"));
+
+		for (const auto& Part : Parts)
+		{
+			Settings.BlueprintProcessors.Add(FSoftClassPath(Part));
+		}
+	}
+
+	FParse::Value(CommandLine, TEXT("GEInputBenchRecording="), Settings.RecordingFilename);
+
+	Settings.OutputDirectory = FPaths::ProfilingDir() / TEXT("GEInput");
+	FParse::Value(CommandLine, TEXT("GEInputBenchOutput="), Settings.OutputDirectory);
+
+	return Settings;
+}
+
+
+// FInputProcessorBenchmark
+
+bool FInputProcessorBenchmark::Run(const FInputProcessorBenchmarkSettings& Settings, TArray<FInputProcessorBenchmarkResult>& OutResults)
+{
+	if (!GEngine)
+	{
+		return false;
+	}
+
+	UE_CLOG(!FInputAllocationScope::IsCounting(), LogGameCore_Input, Warning, TEXT("Benchmark: Allocations are not counted, run with -GEInputCountAllocations"));
+
+	// Build scenarios
+
+	TArray<UClass*> BlueprintClasses;
+	for (const auto& Path : Settings.BlueprintProcessors)
+	{
+		auto* Class{ Path.TryLoadClass<UInputProcessor>() };
+
+		if (Class && !Class->HasAnyClassFlags(CLASS_Abstract))
+		{
+			BlueprintClasses.Add(Class);
+		}
+		else
+		{
+			UE_LOG(LogGameCore_Input, Warning, TEXT("Benchmark: Skipped invalid processor class (%s)"), *Path.ToString());
+		}
+	}
+
+	TArray<GEInputBenchmark::FScenario> Scenarios;
+	Scenarios.Add({ TEXT("Native"), { UInputProcessor_Benchmark::StaticClass() } });
+
+	if (!BlueprintClasses.IsEmpty())
+	{
+		Scenarios.Add({ TEXT("Blueprint"), BlueprintClasses });
+
+		auto MixedClasses{ BlueprintClasses };
+		MixedClasses.Add(UInputProcessor_Benchmark::StaticClass());
+		Scenarios.Add({ TEXT("Mixed"), MixedClasses });
+	}
+
+	// Create isolated game world
+
+	auto* World{ UWorld::CreateWorld(EWorldType::Game, false, TEXT("GEInputBenchmarkWorld")) };
+	auto& WorldContext{ GEngine->CreateNewWorldContext(EWorldType::Game) };
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	for (const auto& Scenario : Scenarios)
+	{
+		const auto Events{ GEInputBenchmark::BuildEventStream(Settings, Scenario.ProcessorClasses) };
+
+		for (const auto NumActors : Settings.NumActors)
+		{
+			auto& Result{ OutResults.AddDefaulted_GetRef() };
+			GEInputBenchmark::RunScenario(World, Scenario, NumActors, Events, Result);
+
+			UE_LOG(LogGameCore_Input, Display, TEXT("Benchmark[%s] Actors=%d Processors=%d Bindings=%d Add=%.1fns/proc (%.2f allocs) Dispatch=%.1fns/event (%.3f allocs) Remove=%.1fns/proc (%.2f allocs)"),
+				*Result.Scenario, Result.NumActors, Result.NumProcessors, Result.NumBindingsCreated,
+				Result.AddNsPerProcessor, Result.AddAllocsPerProcessor,
+				Result.DispatchNsPerEvent, Result.DispatchAllocsPerEvent,
+				Result.RemoveNsPerProcessor, Result.RemoveAllocsPerProcessor);
+		}
+	}
+
+	// Cleanup
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+bool FInputProcessorBenchmark::WriteResults(const TArray<FInputProcessorBenchmarkResult>& Results, const FString& Directory, FString& OutJsonFilename, FString& OutCsvFilename)
+{
+	const auto BaseFilename{ Directory / FString::Printf(TEXT("ProcessorBenchmark-%s"), *FDateTime::Now().ToString()) };
+	OutJsonFilename = BaseFilename + TEXT(".json");
+	OutCsvFilename = BaseFilename + TEXT(".csv");
+
+	FString Json{ TEXT("[\n") };
+	FString Csv{ TEXT("Scenario,Actors,Processors,Events,BindingsCreated,AddNsPerProcessor,AddAllocsPerProcessor,DispatchNsPerEvent,DispatchAllocsPerEvent,RemoveNsPerProcessor,RemoveAllocsPerProcessor\n") };
+
+	for (int32 Index{ 0 }; Index < Results.Num(); ++Index)
+	{
+		const auto& Result{ Results[Index] };
+
+		Json += FString::Printf(TEXT("\t{ \"scenario\": \"%s\", \"actors\": %d, \"processors\": %d, \"events\": %d, \"bindings_created\": %d, ")
+			TEXT("\"add_ns_per_processor\": %.3f, \"add_allocs_per_processor\": %.3f, \"dispatch_ns_per_event\": %.3f, \"dispatch_allocs_per_event\": %.4f, ")
+			TEXT("\"remove_ns_per_processor\": %.3f, \"remove_allocs_per_processor\": %.3f }%s\n"),
+			*Result.Scenario, Result.NumActors, Result.NumProcessors, Result.NumEvents, Result.NumBindingsCreated,
+			Result.AddNsPerProcessor, Result.AddAllocsPerProcessor, Result.DispatchNsPerEvent, Result.DispatchAllocsPerEvent,
+			Result.RemoveNsPerProcessor, Result.RemoveAllocsPerProcessor, (Index + 1 < Results.Num()) ? TEXT(",") : TEXT(""));
+
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.4f,%.3f,%.3f\n"),
+			*Result.Scenario, Result.NumActors, Result.NumProcessors, Result.NumEvents, Result.NumBindingsCreated,
+			Result.AddNsPerProcessor, Result.AddAllocsPerProcessor, Result.DispatchNsPerEvent, Result.DispatchAllocsPerEvent,
+			Result.RemoveNsPerProcessor, Result.RemoveAllocsPerProcessor);
+	}
+
+	Json += TEXT("]\n");
+
+	return FFileHelper::SaveStringToFile(Json, *OutJsonFilename) && FFileHelper::SaveStringToFile(Csv, *OutCsvFilename);
+}
+
+
+// Console command and automation test
+
+static void RunProcessorBenchmark(const TArray<FString>& Args)
+{
+	// Arguments of the console command take priority over the command line
+
+	const auto CommandLine{ FString::Join(Args, TEXT(" ")) + TEXT(" ") + FCommandLine::Get() };
+	const auto Settings{ FInputProcessorBenchmarkSettings::FromCommandLine(*CommandLine) };
+
+	TArray<FInputProcessorBenchmarkResult> Results;
+	if (FInputProcessorBenchmark::Run(Settings, Results))
+	{
+		FString JsonFilename, CsvFilename;
+		if (FInputProcessorBenchmark::WriteResults(Results, Settings.OutputDirectory, JsonFilename, CsvFilename))
+		{
+			UE_LOG(LogGameCore_Input, Display, TEXT("Benchmark results written to %s and %s"), *JsonFilename, *CsvFilename);
+		}
+	}
+}
+
+static FAutoConsoleCommand CCmdRunProcessorBenchmark(
+	TEXT("GEInput.RunProcessorBenchmark"),
+	TEXT("Measures AddInputProcessor, dispatch and RemoveAllInputProcessors costs and writes JSON/CSV results. Accepts the same -GEInputBench* arguments as the command line."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunProcessorBenchmark));
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputProcessorDispatchBenchmark, "GEInput.Benchmark.ProcessorDispatch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInputProcessorDispatchBenchmark::RunTest(const FString& Parameters)
+{
+	const auto Settings{ FInputProcessorBenchmarkSettings::FromCommandLine(FCommandLine::Get()) };
+
+	TArray<FInputProcessorBenchmarkResult> Results;
+	if (!TestTrue(TEXT("Benchmark world created"), FInputProcessorBenchmark::Run(Settings, Results)))
+	{
+		return false;
+	}
+
+	for (const auto& Result : Results)
+	{
+		TestTrue(FString::Printf(TEXT("[%s x%d] every processor binds at least one action"), *Result.Scenario, Result.NumActors), (Result.NumProcessors == 0) || (Result.NumBindingsCreated > 0));
+
+		AddInfo(FString::Printf(TEXT("[%s x%d] Add %.1f ns/proc, Dispatch %.1f ns/event (%.3f allocs/event), Remove %.1f ns/proc"),
+			*Result.Scenario, Result.NumActors, Result.AddNsPerProcessor, Result.DispatchNsPerEvent, Result.DispatchAllocsPerEvent, Result.RemoveNsPerProcessor));
+	}
+
+	FString JsonFilename, CsvFilename;
+	TestTrue(TEXT("Results written"), FInputProcessorBenchmark::WriteResults(Results, Settings.OutputDirectory, JsonFilename, CsvFilename));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+#endif // !UE_BUILD_SHIPPING
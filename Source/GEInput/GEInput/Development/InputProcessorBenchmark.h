@@ -0,0 +1,109 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Settings of the processor dispatch benchmark
+ *
+ * Tips:
+ *	Can be overridden from the command line:
+ *	-GEInputBenchActors=1,8,64 -GEInputBenchEvents=10000 -GEInputBenchBlueprints=/Game/A.A_C+/Game/B.B_C
+ *	-GEInputBenchRecording=<file recorded by FInputRecorder> -GEInputBenchOutput=<directory>
+ *	Allocations are only counted with -GEInputCountAllocations, see FInputAllocationScope.
+ */
+struct GEINPUT_API FInputProcessorBenchmarkSettings
+{
+public:
+	FInputProcessorBenchmarkSettings() {}
+
+public:
+	//
+	// Number of actors (each with its own UInputProcessComponent) measured per scenario
+	//
+	TArray<int32> NumActors{ 1, 8, 64 };
+
+	//
+	// Number of events injected to each component
+	//
+	int32 NumEvents{ 10000 };
+
+	//
+	// Blueprint processor classes measured in the Blueprint and Mixed scenarios
+	//
+	TArray<FSoftClassPath> BlueprintProcessors;
+
+	//
+	// If set, events are read from this recording instead of being generated
+	//
+	FString RecordingFilename;
+
+	//
+	// Directory where the results are written
+	//
+	FString OutputDirectory;
+
+public:
+	static FInputProcessorBenchmarkSettings FromCommandLine(const TCHAR* CommandLine);
+
+};
+
+
+/**
+ * Result of a benchmark scenario
+ */
+struct GEINPUT_API FInputProcessorBenchmarkResult
+{
+public:
+	FInputProcessorBenchmarkResult() {}
+
+public:
+	FString Scenario;
+
+	int32 NumActors{ 0 };
+	int32 NumProcessors{ 0 };
+	int32 NumEvents{ 0 };
+	int32 NumBindingsCreated{ 0 };
+
+	//
+	// Allocation counts are -1 when allocations are not counted
+	//
+	double AddNsPerProcessor{ 0.0 };
+	double AddAllocsPerProcessor{ 0.0 };
+
+	double DispatchNsPerEvent{ 0.0 };
+	double DispatchAllocsPerEvent{ 0.0 };
+
+	double RemoveNsPerProcessor{ 0.0 };
+	double RemoveAllocsPerProcessor{ 0.0 };
+};
+
+
+/**
+ * Measures the overhead of AddInputProcessor, event dispatch and RemoveAllInputProcessors in an isolated game world
+ *
+ * Tips:
+ *	Events are passed to the handlers of the bound input actions, so dispatch includes every stage of live input
+ *	(device filter, recording, replication capture, latency stamping and forwarding to subscribers).
+ */
+class GEINPUT_API FInputProcessorBenchmark
+{
+public:
+	/**
+	 * Runs every scenario and returns the results.
+	 * Returns false if no world could be created.
+	 */
+	static bool Run(const FInputProcessorBenchmarkSettings& Settings, TArray<FInputProcessorBenchmarkResult>& OutResults);
+
+	/**
+	 * Writes the results as JSON and CSV files in the directory
+	 */
+	static bool WriteResults(const TArray<FInputProcessorBenchmarkResult>& Results, const FString& Directory, FString& OutJsonFilename, FString& OutCsvFilename);
+
+};
+
+#endif
@@ -0,0 +1,202 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputProcessorDebug.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "InputProcessComponent.h"
+#include "Processor/InputProcessor.h"
+#include "GameFeature/GameFeatureAction_AddInputContextMapping.h"
+
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+
+// FInputProcessorDebugStats
+
+void FInputProcessorDebugStats::UpdateRates(double Now)
+{
+	if (WindowStartTime <= 0.0)
+	{
+		WindowStartEvents = NumEvents;
+		WindowStartCycles = Cycles;
+		WindowStartTime = Now;
+		return;
+	}
+
+	const auto Elapsed{ Now - WindowStartTime };
+
+	if (Elapsed >= 1.0)
+	{
+		EventsPerSecond = static_cast<float>((NumEvents - WindowStartEvents) / Elapsed);
+		MillisecondsPerSecond = static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles - WindowStartCycles) / Elapsed);
+
+		WindowStartEvents = NumEvents;
+		WindowStartCycles = Cycles;
+		WindowStartTime = Now;
+	}
+}
+
+
+// GEInputDebug
+
+namespace GEInputDebug
+{
+	uint64 StatsRequestedUntilFrame{ 0 };
+	bool bAlwaysCollectProcessorStats{ false };
+
+	static FAutoConsoleVariableRef CVarCollectProcessorStats(
+		TEXT("GEInput.Debug.CollectProcessorStats"),
+		bAlwaysCollectProcessorStats,
+		TEXT("Collects per processor event rates and time spent even when the GEInput Gameplay Debugger category is not active."));
+
+	static FString DescribeBoundEvents(const UInputProcessor* Processor, const FGameplayTag& InputTag)
+	{
+		static const ETriggerEvent Events[]{ ETriggerEvent::Triggered, ETriggerEvent::Started, ETriggerEvent::Ongoing, ETriggerEvent::Canceled, ETriggerEvent::Completed };
+
+		FString Result;
+
+		for (const auto Event : Events)
+		{
+			if (Processor->IsBoundTo(InputTag, Event))
+			{
+				Result += Result.IsEmpty() ? TEXT("") : TEXT("|");
+				Result += UEnum::GetDisplayValueAsText(Event).ToString();
+			}
+		}
+
+		return Result.IsEmpty() ? TEXT("None") : Result;
+	}
+
+	void DescribeInputComponent(UInputProcessComponent* InputComponent, TArray<FString>& OutLines)
+	{
+		if (!InputComponent)
+		{
+			return;
+		}
+
+		const auto Now{ FPlatformTime::Seconds() };
+		const auto& Processors{ InputComponent->GetInputProcessors() };
+
+		OutLines.Add(FString::Printf(TEXT("%s.%s: %d processor(s), %d binding(s)"),
+			*GetNameSafe(InputComponent->GetOwner()), *InputComponent->GetName(), Processors.Num(), InputComponent->GetActionEventBindings().Num()));
+
+		for (const auto& KVP : Processors)
+		{
+			auto* Processor{ KVP.Value.Get() };
+
+			if (!Processor)
+			{
+				continue;
+			}
+
+			auto& Stats{ Processor->GetDebugStats() };
+			Stats.UpdateRates(Now);
+
+			OutLines.Add(FString::Printf(TEXT("  %s: %.1f events/s, %.3f ms/s (total %llu events, %.3f ms)"),
+				*GetNameSafe(Processor->GetClass()), Stats.EventsPerSecond, Stats.MillisecondsPerSecond, Stats.NumEvents, FPlatformTime::ToMilliseconds64(Stats.Cycles)));
+
+			for (const auto& ActionKVP : Processor->GetInputActions())
+			{
+				OutLines.Add(FString::Printf(TEXT("    %s -> %s [%s]"),
+					*ActionKVP.Key.ToString(), *GetNameSafe(ActionKVP.Value), *DescribeBoundEvents(Processor, ActionKVP.Key)));
+			}
+
+			for (const auto& SubscribedTag : Processor->GetSubscribedInputTags())
+			{
+				OutLines.Add(FString::Printf(TEXT("    %s.* (subscribed)"), *SubscribedTag.ToString()));
+			}
+
+			for (const auto& ActionKVP : Processor->GetSubscribedInputActions())
+			{
+				OutLines.Add(FString::Printf(TEXT("    %s -> %s [%s] (subscribed)"),
+					*ActionKVP.Key.ToString(), *GetNameSafe(ActionKVP.Value), *DescribeBoundEvents(Processor, ActionKVP.Key)));
+			}
+		}
+	}
+
+	void DescribeMappingContexts(const APlayerController* PlayerController, TArray<FString>& OutLines)
+	{
+		for (TObjectIterator<UGameFeatureAction_AddInputContextMapping> It; It; ++It)
+		{
+			const auto* Action{ *It };
+
+			if (!Action || Action->HasAnyFlags(RF_ClassDefaultObject) || !Action->IsAddedToController(PlayerController))
+			{
+				continue;
+			}
+
+			OutLines.Add(FString::Printf(TEXT("%s:"), *GetPathNameSafe(Action->GetOuter())));
+
+			for (const auto& Entry : Action->GetInputMappings())
+			{
+				OutLines.Add(FString::Printf(TEXT("  %s (Priority %d)%s"),
+					*Entry.InputMapping.GetAssetName(), Entry.Priority, Entry.InputMapping.IsValid() ? TEXT("") : TEXT(" [Not Loaded]")));
+			}
+		}
+	}
+
+
+	static bool IsDebuggableWorld(const UWorld* World, const UObject* Object)
+	{
+		return Object && !Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) && (Object->GetWorld() == World);
+	}
+
+	static void DumpProcessors(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		TArray<FString> Lines;
+
+		for (TObjectIterator<UInputProcessComponent> It; It; ++It)
+		{
+			if (IsDebuggableWorld(World, *It))
+			{
+				DescribeInputComponent(*It, Lines);
+			}
+		}
+
+		for (const auto& Line : Lines)
+		{
+			Ar.Log(Line);
+		}
+
+		if (!bAlwaysCollectProcessorStats)
+		{
+			Ar.Log(TEXT("Event rates are only collected while the GEInput Gameplay Debugger category is active or GEInput.Debug.CollectProcessorStats is 1"));
+		}
+	}
+
+	static void DumpMappings(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		TArray<FString> Lines;
+
+		for (TObjectIterator<APlayerController> It; It; ++It)
+		{
+			if (IsDebuggableWorld(World, *It) && It->IsLocalController())
+			{
+				Lines.Add(FString::Printf(TEXT("%s:"), *It->GetName()));
+				DescribeMappingContexts(*It, Lines);
+			}
+		}
+
+		for (const auto& Line : Lines)
+		{
+			Ar.Log(Line);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CCmdDumpProcessors(
+		TEXT("GEInput.DumpProcessors"),
+		TEXT("Lists every UInputProcessComponent of the world with its processors, bindings and event rates."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpProcessors));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CCmdDumpMappings(
+		TEXT("GEInput.DumpMappings"),
+		TEXT("Lists the input mapping contexts each game feature action has added per local player controller."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpMappings));
+}
+
+#endif
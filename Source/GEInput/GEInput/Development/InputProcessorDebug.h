@@ -0,0 +1,98 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+class UInputProcessComponent;
+class APlayerController;
+
+
+/**
+ * Event count and time spent by a processor, only collected while GEInputDebug::IsCollectingProcessorStats() is true
+ */
+struct GEINPUT_API FInputProcessorDebugStats
+{
+public:
+	uint64 NumEvents{ 0 };
+	uint64 Cycles{ 0 };
+
+	//
+	// Rates measured over the last completed window of about one second
+	//
+	float EventsPerSecond{ 0.0f };
+	float MillisecondsPerSecond{ 0.0f };
+
+private:
+	uint64 WindowStartEvents{ 0 };
+	uint64 WindowStartCycles{ 0 };
+	double WindowStartTime{ 0.0 };
+
+public:
+	/**
+	 * Refreshes the rates when the current window is complete
+	 */
+	void UpdateRates(double Now);
+
+	/**
+	 * Adds one event and its duration to the stats when constructed with non-null stats
+	 */
+	struct FScope
+	{
+	public:
+		explicit FScope(FInputProcessorDebugStats* InStats)
+			: Stats(InStats)
+			, StartCycles(InStats ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+
+		~FScope()
+		{
+			if (Stats)
+			{
+				Stats->NumEvents++;
+				Stats->Cycles += FPlatformTime::Cycles64() - StartCycles;
+			}
+		}
+
+	private:
+		FInputProcessorDebugStats* Stats{ nullptr };
+		uint64 StartCycles{ 0 };
+	};
+};
+
+
+/**
+ * Describes processors, bindings and mapping contexts for the Gameplay Debugger category and the GEInput.Dump* commands
+ */
+namespace GEInputDebug
+{
+	//
+	// Frame until which a debugger asked for processor stats
+	//
+	extern GEINPUT_API uint64 StatsRequestedUntilFrame;
+	extern GEINPUT_API bool bAlwaysCollectProcessorStats;
+
+	/**
+	 * Returns true if processors should collect FInputProcessorDebugStats
+	 */
+	FORCEINLINE bool IsCollectingProcessorStats()
+	{
+		return bAlwaysCollectProcessorStats || (GFrameCounter < StatsRequestedUntilFrame);
+	}
+
+	/**
+	 * Keeps processor stats collection enabled for the next frames
+	 */
+	FORCEINLINE void RequestProcessorStats(uint64 NumFrames = 120)
+	{
+		StatsRequestedUntilFrame = FMath::Max(StatsRequestedUntilFrame, GFrameCounter + NumFrames);
+	}
+
+	GEINPUT_API void DescribeInputComponent(UInputProcessComponent* InputComponent, TArray<FString>& OutLines);
+	GEINPUT_API void DescribeMappingContexts(const APlayerController* PlayerController, TArray<FString>& OutLines);
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 owoDra
+
+#include "Development/InputProcessor_Subscription.h"
+#include "InputProcessComponent.h"
+#include "Mapping/InputMappingCompositeSubsystem.h"
+#include "Keybind/KeybindSettings.h"
+
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputProcessorSubscriptionTest, "GEInput.Processor.Subscription", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInputProcessorSubscriptionTest::RunTest(const FString& Parameters)
+{
+	// Mapping context with an action whose keybind settings carry a child tag of Input.Ability
+
+	auto* InputAction{ NewObject<UInputAction>(GetTransientPackage()) };
+	auto* KeybindSettings{ NewObject<UKeybindSettings>(InputAction) };
+	auto* MappingContext{ NewObject<UInputMappingContext>(GetTransientPackage()) };
+
+	auto* InputTagProperty{ FindFProperty<FStructProperty>(UKeybindSettings::StaticClass(), TEXT("InputTag")) };
+	auto* KeySettingsProperty{ FindFProperty<FObjectProperty>(UInputAction::StaticClass(), TEXT("PlayerMappableKeySettings")) };
+
+	if (!TestNotNull(TEXT("InputTag property"), InputTagProperty) || !TestNotNull(TEXT("PlayerMappableKeySettings property"), KeySettingsProperty))
+	{
+		return false;
+	}
+
+	*InputTagProperty->ContainerPtrToValuePtr<FGameplayTag>(KeybindSettings) = TAG_Input_Ability_SubscriptionTest;
+	KeySettingsProperty->SetObjectPropertyValue_InContainer(InputAction, KeybindSettings);
+
+	MappingContext->MapKey(InputAction, EKeys::SpaceBar);
+
+	TMap<FGameplayTag, TObjectPtr<const UInputAction>> InputActionsByTag;
+	UInputMappingCompositeSubsystem::CollectInputActionsByTag(MappingContext, InputActionsByTag);
+
+	TestEqual(TEXT("Collected input actions"), InputActionsByTag.Num(), 1);
+
+	// Create isolated game world
+
+	auto* World{ UWorld::CreateWorld(EWorldType::Game, false, TEXT("GEInputSubscriptionTestWorld")) };
+	auto& WorldContext{ GEngine->CreateNewWorldContext(EWorldType::Game) };
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	auto* Actor{ World->SpawnActor<AActor>() };
+	auto* Component{ NewObject<UInputProcessComponent>(Actor) };
+	Component->RegisterComponent();
+
+	Component->AddInputProcessor(UInputProcessor_Subscription::StaticClass());
+	Component->UpdateSubscribedInputActions(InputActionsByTag);
+
+	const auto* Processor{ Cast<UInputProcessor_Subscription>(Component->GetInputProcessors().FindRef(UInputProcessor_Subscription::StaticClass())) };
+
+	if (TestNotNull(TEXT("Processor"), Processor))
+	{
+		TestTrue(TEXT("Processor binds the subscribed child tag"), Processor->IsBoundTo(TAG_Input_Ability_SubscriptionTest, ETriggerEvent::Started));
+
+		// Execute the bindings as EnhancedInput would when the key is pressed and released
+
+		const FInputActionInstance ActionInstance(InputAction);
+		auto NumBindings{ 0 };
+
+		for (const auto& Binding : Component->GetActionEventBindings())
+		{
+			if (Binding->GetAction() == InputAction)
+			{
+				Binding->Execute(ActionInstance);
+				++NumBindings;
+			}
+		}
+
+		TestEqual(TEXT("Bindings of the subscribed action"), NumBindings, 2);
+		TestEqual(TEXT("Events received"), Processor->GetNumEventsReceived(), 2);
+		TestTrue(TEXT("Input tag received"), Processor->GetLastInputTag() == TAG_Input_Ability_SubscriptionTest.GetTag());
+
+		// Removing the mapping removes the bindings
+
+		Component->UpdateSubscribedInputActions({});
+
+		TestFalse(TEXT("Processor unbinds the removed child tag"), Processor->IsBoundTo(TAG_Input_Ability_SubscriptionTest, ETriggerEvent::Started));
+		TestEqual(TEXT("Remaining bindings"), Component->GetActionEventBindings().Num(), 0);
+	}
+
+	// Cleanup
+
+	Component->RemoveAllInputProcessors();
+	World->DestroyActor(Actor);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
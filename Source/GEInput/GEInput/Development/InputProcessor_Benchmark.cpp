@@ -0,0 +1,39 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputProcessor_Benchmark.h"
+
+#include "GameplayTag/GEInputTags_Input.h"
+
+#include "InputAction.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessor_Benchmark)
+
+
+UInputProcessor_Benchmark::UInputProcessor_Benchmark(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bBind_Triggered = true;
+	bBind_Started = true;
+	bBind_Ongoing = true;
+	bBind_Canceled = true;
+	bBind_Complete = true;
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		const TPair<FName, FGameplayTag> Bindings[]
+		{
+			{ TEXT("GamepadMove"), TAG_Input_Gamepad_Move },
+			{ TEXT("GamepadLook"), TAG_Input_Gamepad_Look },
+			{ TEXT("MouseAndKeyboardMove"), TAG_Input_MouseAndKeyboard_Move },
+			{ TEXT("MouseAndKeyboardLook"), TAG_Input_MouseAndKeyboard_Look },
+		};
+
+		for (const auto& Binding : Bindings)
+		{
+			auto* InputAction{ CreateDefaultSubobject<UInputAction>(Binding.Key, true) };
+			InputAction->ValueType = EInputActionValueType::Axis2D;
+
+			InputActions.Add(Binding.Value, InputAction);
+		}
+	}
+}
@@ -0,0 +1,39 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Processor/InputProcessor.h"
+
+#include "InputProcessor_Benchmark.generated.h"
+
+
+/**
+ * Native processor used by the processor dispatch benchmark.
+ * Binds every trigger event and only counts the events it receives.
+ *
+ * Tips:
+ *	Binds transient Axis2D input actions to the move and look tags. They are created on the class default object only,
+ *	so that instances share them like the actions referenced from assets by other processors.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class GEINPUT_API UInputProcessor_Benchmark : public UInputProcessor
+{
+	GENERATED_BODY()
+public:
+	UInputProcessor_Benchmark(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	UPROPERTY(Transient)
+	int32 NumEventsReceived{ 0 };
+
+public:
+	int32 GetNumEventsReceived() const { return NumEventsReceived; }
+
+protected:
+	virtual void OnTriggered_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; }
+	virtual void OnStarted_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; }
+	virtual void OnOngoing_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; }
+	virtual void OnCanceled_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; }
+	virtual void OnComplete_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; }
+
+};
@@ -0,0 +1,24 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputProcessor_Replicated.h"
+
+#include "GameplayTag/GEInputTags_Input.h"
+
+#include "InputAction.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessor_Replicated)
+
+
+UInputProcessor_Replicated::UInputProcessor_Replicated(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bRunOnServer = true;
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		auto* InputAction{ CreateDefaultSubobject<UInputAction>(TEXT("GamepadMove"), true) };
+		InputAction->ValueType = EInputActionValueType::Axis2D;
+
+		InputActions.Add(TAG_Input_Gamepad_Move, InputAction);
+	}
+}
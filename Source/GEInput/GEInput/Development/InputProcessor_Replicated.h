@@ -0,0 +1,42 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Processor/InputProcessor.h"
+
+#include "InputProcessor_Replicated.generated.h"
+
+
+/**
+ * Native processor used by the input replication test.
+ * Runs on the server and binds a transient Axis2D input action to the gamepad move tag, counting the events it receives.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class GEINPUT_API UInputProcessor_Replicated : public UInputProcessor
+{
+	GENERATED_BODY()
+public:
+	UInputProcessor_Replicated(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	UPROPERTY(Transient)
+	int32 NumStartedReceived{ 0 };
+
+	UPROPERTY(Transient)
+	int32 NumCompletedReceived{ 0 };
+
+	UPROPERTY(Transient)
+	FVector2D LastValue{ FVector2D::ZeroVector };
+
+public:
+	int32 GetNumStartedReceived() const { return NumStartedReceived; }
+
+	int32 GetNumCompletedReceived() const { return NumCompletedReceived; }
+
+	const FVector2D& GetLastValue() const { return LastValue; }
+
+protected:
+	virtual void OnStarted_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumStartedReceived; LastValue = InputActionValue.Get<FVector2D>(); }
+	virtual void OnComplete_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumCompletedReceived; LastValue = InputActionValue.Get<FVector2D>(); }
+
+};
@@ -0,0 +1,20 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputProcessor_Subscription.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessor_Subscription)
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Input_Ability, "Input.Ability");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Input_Ability_SubscriptionTest, "Input.Ability.SubscriptionTest");
+#endif
+
+
+UInputProcessor_Subscription::UInputProcessor_Subscription(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+#if WITH_DEV_AUTOMATION_TESTS
+	SubscribedInputTags.AddTag(TAG_Input_Ability);
+#endif
+}
@@ -0,0 +1,43 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Processor/InputProcessor.h"
+
+#include "NativeGameplayTags.h"
+
+#include "InputProcessor_Subscription.generated.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Input_Ability_SubscriptionTest);
+#endif
+
+
+/**
+ * Native processor used by the subscription test.
+ * Binds no input actions and only subscribes to Input.Ability, counting the events it receives.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class GEINPUT_API UInputProcessor_Subscription : public UInputProcessor
+{
+	GENERATED_BODY()
+public:
+	UInputProcessor_Subscription(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	UPROPERTY(Transient)
+	int32 NumEventsReceived{ 0 };
+
+	UPROPERTY(Transient)
+	FGameplayTag LastInputTag;
+
+public:
+	int32 GetNumEventsReceived() const { return NumEventsReceived; }
+
+	const FGameplayTag& GetLastInputTag() const { return LastInputTag; }
+
+protected:
+	virtual void OnStarted_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; LastInputTag = InputTag; }
+	virtual void OnComplete_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) override { ++NumEventsReceived; LastInputTag = InputTag; }
+
+};
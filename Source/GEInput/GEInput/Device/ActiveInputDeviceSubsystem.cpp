@@ -0,0 +1,179 @@
+// Copyright (C) 2024 owoDra
+
+#include "ActiveInputDeviceSubsystem.h"
+
+#include "GEInputLLM.h"
+
+#include "Engine/LocalPlayer.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ActiveInputDeviceSubsystem)
+
+
+/**
+ * Observes platform input routed by Slate for one local player without consuming it
+ */
+class FActiveInputDevicePreProcessor : public IInputProcessor
+{
+public:
+	explicit FActiveInputDevicePreProcessor(UActiveInputDeviceSubsystem* InSubsystem) : Subsystem(InSubsystem) {}
+
+private:
+	TWeakObjectPtr<UActiveInputDeviceSubsystem> Subsystem;
+
+public:
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		if (auto* Target{ GetSubsystem(InKeyEvent.GetUserIndex()) })
+		{
+			Target->HandleButtonInput(InKeyEvent.GetKey().IsGamepadKey() ? EInputDeviceFamily::Gamepad : EInputDeviceFamily::MouseAndKeyboard);
+		}
+
+		return false;
+	}
+
+	virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override
+	{
+		if (InAnalogInputEvent.GetKey().IsGamepadKey())
+		{
+			if (auto* Target{ GetSubsystem(InAnalogInputEvent.GetUserIndex()) })
+			{
+				Target->HandleAnalogInput(FMath::Abs(InAnalogInputEvent.GetAnalogValue()));
+			}
+		}
+
+		return false;
+	}
+
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		if (auto* Target{ GetSubsystem(MouseEvent.GetUserIndex()) })
+		{
+			Target->HandleMouseMove(MouseEvent.GetCursorDelta().Size());
+		}
+
+		return false;
+	}
+
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		if (auto* Target{ GetSubsystem(MouseEvent.GetUserIndex()) })
+		{
+			Target->HandleButtonInput(EInputDeviceFamily::MouseAndKeyboard);
+		}
+
+		return false;
+	}
+
+	virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent) override
+	{
+		if (auto* Target{ GetSubsystem(InWheelEvent.GetUserIndex()) })
+		{
+			Target->HandleButtonInput(EInputDeviceFamily::MouseAndKeyboard);
+		}
+
+		return false;
+	}
+
+	virtual const TCHAR* GetDebugName() const override { return TEXT("GEInputActiveDevice"); }
+
+private:
+	UActiveInputDeviceSubsystem* GetSubsystem(int32 UserIndex) const
+	{
+		auto* Target{ Subsystem.Get() };
+		return (Target && (Target->GetUserIndex() == UserIndex)) ? Target : nullptr;
+	}
+};
+
+
+void UActiveInputDeviceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		GEINPUT_LLM_SCOPE();
+
+		PreProcessor = MakeShared<FActiveInputDevicePreProcessor>(this);
+		FSlateApplication::Get().RegisterInputPreProcessor(PreProcessor);
+	}
+}
+
+void UActiveInputDeviceSubsystem::Deinitialize()
+{
+	if (PreProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(PreProcessor);
+	}
+
+	PreProcessor.Reset();
+
+	Super::Deinitialize();
+}
+
+
+int32 UActiveInputDeviceSubsystem::GetUserIndex() const
+{
+	return GetSlateUserIndex(GetLocalPlayer());
+}
+
+void UActiveInputDeviceSubsystem::HandleButtonInput(EInputDeviceFamily DeviceFamily)
+{
+	AccumulatedMouseMove = 0.0f;
+
+	SetActiveDeviceFamily(DeviceFamily);
+}
+
+void UActiveInputDeviceSubsystem::HandleAnalogInput(float Magnitude)
+{
+	if (Magnitude >= AnalogSwitchThreshold)
+	{
+		AccumulatedMouseMove = 0.0f;
+
+		SetActiveDeviceFamily(EInputDeviceFamily::Gamepad);
+	}
+}
+
+void UActiveInputDeviceSubsystem::HandleMouseMove(float Distance)
+{
+	if (ActiveDeviceFamily == EInputDeviceFamily::MouseAndKeyboard)
+	{
+		return;
+	}
+
+	AccumulatedMouseMove += Distance;
+
+	if (AccumulatedMouseMove >= MouseMoveSwitchThreshold)
+	{
+		AccumulatedMouseMove = 0.0f;
+
+		SetActiveDeviceFamily(EInputDeviceFamily::MouseAndKeyboard);
+	}
+}
+
+void UActiveInputDeviceSubsystem::SetActiveDeviceFamily(EInputDeviceFamily NewDeviceFamily)
+{
+	if (NewDeviceFamily == ActiveDeviceFamily)
+	{
+		return;
+	}
+
+	const auto Now{ FPlatformTime::Seconds() };
+
+	// The first device is taken immediately, later changes are rate limited
+
+	if ((ActiveDeviceFamily != EInputDeviceFamily::None) && ((Now - LastSwitchTime) < MinSwitchInterval))
+	{
+		return;
+	}
+
+	const auto OldDeviceFamily{ ActiveDeviceFamily };
+
+	ActiveDeviceFamily = NewDeviceFamily;
+	LastSwitchTime = Now;
+
+	OnInputDeviceChanged.Broadcast(NewDeviceFamily, OldDeviceFamily);
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "Device/InputDeviceTypes.h"
+
+#include "ActiveInputDeviceSubsystem.generated.h"
+
+class FActiveInputDevicePreProcessor;
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInputDeviceChangedDelegate, EInputDeviceFamily, NewDeviceFamily, EInputDeviceFamily, OldDeviceFamily);
+
+
+/**
+ * Tracks the device family a local player is currently using
+ *
+ * Tips:
+ *	Input is observed before EnhancedInput evaluates it, so the device is already switched when the first event of the new device is dispatched.
+ *	Analog and mouse movement must exceed a threshold and switches are rate limited to avoid flickering between devices.
+ */
+UCLASS(Config = Input)
+class GEINPUT_API UActiveInputDeviceSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+public:
+	UActiveInputDeviceSubsystem() {}
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+	//
+	// Minimum time in seconds between two device changes
+	//
+	UPROPERTY(Config)
+	float MinSwitchInterval{ 0.25f };
+
+	//
+	// Analog input magnitude required to switch to a gamepad
+	//
+	UPROPERTY(Config)
+	float AnalogSwitchThreshold{ 0.3f };
+
+	//
+	// Mouse movement in pixels accumulated without other input required to switch to mouse and keyboard
+	//
+	UPROPERTY(Config)
+	float MouseMoveSwitchThreshold{ 8.0f };
+
+	EInputDeviceFamily ActiveDeviceFamily{ EInputDeviceFamily::None };
+
+	double LastSwitchTime{ 0.0 };
+
+	float AccumulatedMouseMove{ 0.0f };
+
+	TSharedPtr<FActiveInputDevicePreProcessor> PreProcessor;
+
+public:
+	//
+	// Broadcast when the player starts using another device family, for example to swap UI prompts
+	//
+	UPROPERTY(BlueprintAssignable, Category = "Input")
+	FInputDeviceChangedDelegate OnInputDeviceChanged;
+
+public:
+	UFUNCTION(BlueprintPure, Category = "Input")
+	EInputDeviceFamily GetActiveDeviceFamily() const { return ActiveDeviceFamily; }
+
+	/**
+	 * Returns Input.Gamepad or Input.MouseAndKeyboard depending on the active device
+	 */
+	UFUNCTION(BlueprintPure, Category = "Input")
+	FGameplayTag GetActiveDeviceTag() const { return GetInputDeviceFamilyTag(ActiveDeviceFamily); }
+
+	/**
+	 * Returns Slate user index of the owning local player
+	 */
+	int32 GetUserIndex() const;
+
+	void HandleButtonInput(EInputDeviceFamily DeviceFamily);
+	void HandleAnalogInput(float Magnitude);
+	void HandleMouseMove(float Distance);
+
+protected:
+	void SetActiveDeviceFamily(EInputDeviceFamily NewDeviceFamily);
+
+};
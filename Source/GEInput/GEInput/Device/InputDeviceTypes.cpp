@@ -0,0 +1,44 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputDeviceTypes.h"
+
+#include "GameplayTag/GEInputTags_Input.h"
+
+#include "Engine/LocalPlayer.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputDeviceTypes)
+
+
+EInputDeviceFamily GetInputDeviceFamilyForTag(const FGameplayTag& InputTag)
+{
+	if (InputTag.MatchesTag(TAG_Input_Gamepad))
+	{
+		return EInputDeviceFamily::Gamepad;
+	}
+
+	if (InputTag.MatchesTag(TAG_Input_MouseAndKeyboard))
+	{
+		return EInputDeviceFamily::MouseAndKeyboard;
+	}
+
+	return EInputDeviceFamily::None;
+}
+
+FGameplayTag GetInputDeviceFamilyTag(EInputDeviceFamily DeviceFamily)
+{
+	switch (DeviceFamily)
+	{
+	case EInputDeviceFamily::MouseAndKeyboard:	return TAG_Input_MouseAndKeyboard;
+	case EInputDeviceFamily::Gamepad:			return TAG_Input_Gamepad;
+	default:									return FGameplayTag();
+	}
+}
+
+int32 GetSlateUserIndex(const ULocalPlayer* LocalPlayer)
+{
+	// Events carry the user index of the platform user that owns the device, which differs from the controller id once devices are remapped
+
+	const auto PlatformUserId{ LocalPlayer ? LocalPlayer->GetPlatformUserId() : PLATFORMUSERID_NONE };
+
+	return PlatformUserId.IsValid() ? FPlatformMisc::GetUserIndexForPlatformUser(PlatformUserId) : INDEX_NONE;
+}
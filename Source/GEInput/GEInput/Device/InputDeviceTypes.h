@@ -0,0 +1,37 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "InputDeviceTypes.generated.h"
+
+class ULocalPlayer;
+
+
+/**
+ * Family of devices a player is currently using
+ */
+UENUM(BlueprintType)
+enum class EInputDeviceFamily : uint8
+{
+	None,
+	MouseAndKeyboard,
+	Gamepad,
+};
+
+
+/**
+ * Returns the device family of an input tag under Input.MouseAndKeyboard or Input.Gamepad, None for other tags
+ */
+GEINPUT_API EInputDeviceFamily GetInputDeviceFamilyForTag(const FGameplayTag& InputTag);
+
+/**
+ * Returns the parent tag (Input.MouseAndKeyboard or Input.Gamepad) of the device family
+ */
+GEINPUT_API FGameplayTag GetInputDeviceFamilyTag(EInputDeviceFamily DeviceFamily);
+
+/**
+ * Returns the user index Slate tags the input events of the local player with, INDEX_NONE if it has no platform user
+ */
+GEINPUT_API int32 GetSlateUserIndex(const ULocalPlayer* LocalPlayer);
@@ -0,0 +1,64 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputFilter.h"
+
+
+// FInputFilter_OneEuro
+
+FVector FInputFilter_OneEuro::Apply(const FVector& Value, float DeltaSeconds, FInputFilterState& State) const
+{
+	auto& FilterState{ State.Get<FState>() };
+
+	if (!State.bInitialized)
+	{
+		FilterState.Value = Value;
+		FilterState.Derivative = FVector::ZeroVector;
+		State.bInitialized = true;
+
+		return Value;
+	}
+
+	// No time passed since the previous value of the stream
+
+	if (DeltaSeconds <= 0.0f)
+	{
+		return FilterState.Value;
+	}
+
+	const auto Derivative{ (Value - FilterState.Value) / DeltaSeconds };
+	const auto SmoothedDerivative{ FMath::Lerp(FilterState.Derivative, Derivative, GetAlpha(DerivativeCutoff, DeltaSeconds)) };
+
+	const auto Cutoff{ MinCutoff + Beta * static_cast<float>(SmoothedDerivative.Size()) };
+	const auto SmoothedValue{ FMath::Lerp(FilterState.Value, Value, GetAlpha(Cutoff, DeltaSeconds)) };
+
+	FilterState.Value = SmoothedValue;
+	FilterState.Derivative = SmoothedDerivative;
+
+	return SmoothedValue;
+}
+
+float FInputFilter_OneEuro::GetAlpha(float Cutoff, float DeltaSeconds)
+{
+	const auto Tau{ 1.0f / (UE_TWO_PI * FMath::Max(Cutoff, UE_KINDA_SMALL_NUMBER)) };
+	return 1.0f / (1.0f + Tau / DeltaSeconds);
+}
+
+
+// FInputFilter_RadialDeadzone
+
+FVector FInputFilter_RadialDeadzone::Apply(const FVector& Value, float DeltaSeconds, FInputFilterState& State) const
+{
+	const auto Stick{ FVector2D(Value.X, Value.Y) };
+	const auto Magnitude{ Stick.Size() };
+
+	if (Magnitude <= InnerRadius)
+	{
+		return FVector(0.0, 0.0, Value.Z);
+	}
+
+	const auto Range{ FMath::Max(OuterRadius - InnerRadius, UE_KINDA_SMALL_NUMBER) };
+	const auto Scaled{ (FMath::Min(Magnitude, static_cast<double>(OuterRadius)) - InnerRadius) / Range };
+	const auto Direction{ Stick / Magnitude };
+
+	return FVector(Direction.X * Scaled, Direction.Y * Scaled, Value.Z);
+}
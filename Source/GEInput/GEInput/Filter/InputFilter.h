@@ -0,0 +1,117 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Per stream state of an input filter, stored by UInputProcessComponent for each filtered input tag
+ */
+struct GEINPUT_API FInputFilterState
+{
+public:
+	static constexpr int32 Size{ 64 };
+
+	alignas(16) uint8 Data[Size]{};
+
+	bool bInitialized{ false };
+
+public:
+	template<typename T>
+	T& Get()
+	{
+		static_assert(sizeof(T) <= Size, "Filter state does not fit in FInputFilterState");
+		static_assert(alignof(T) <= 16, "Filter state alignment is too large for FInputFilterState");
+		static_assert(std::is_trivially_copyable_v<T>, "Filter state must be trivially copyable");
+
+		return *reinterpret_cast<T*>(Data);
+	}
+
+	void Reset()
+	{
+		FMemory::Memzero(Data);
+		bInitialized = false;
+	}
+};
+
+
+/**
+ * Side effect free transform of an input value, applied before the value is dispatched to processors
+ *
+ * Tips:
+ *	Apply runs on task graph workers in parallel with the filters of other players.
+ *	It must only read the filter and write the state it is given.
+ */
+class GEINPUT_API FInputFilter
+{
+public:
+	virtual ~FInputFilter() {}
+
+	/**
+	 * Returns the filtered value, DeltaSeconds is the time since the previous value of the stream (0 for the first value)
+	 */
+	virtual FVector Apply(const FVector& Value, float DeltaSeconds, FInputFilterState& State) const = 0;
+
+};
+
+
+/**
+ * One euro filter: smooths jitter at low speed while keeping latency low at high speed
+ */
+class GEINPUT_API FInputFilter_OneEuro : public FInputFilter
+{
+public:
+	FInputFilter_OneEuro(float InMinCutoff = 1.0f, float InBeta = 0.01f, float InDerivativeCutoff = 1.0f)
+		: MinCutoff(InMinCutoff), Beta(InBeta), DerivativeCutoff(InDerivativeCutoff)
+	{}
+
+protected:
+	struct FState
+	{
+		FVector Value;
+		FVector Derivative;
+	};
+
+	//
+	// Cutoff frequency in Hz at rest, lower values smooth more
+	//
+	float MinCutoff;
+
+	//
+	// Increase of the cutoff frequency with the speed of the value, higher values reduce lag
+	//
+	float Beta;
+
+	//
+	// Cutoff frequency in Hz of the speed estimate
+	//
+	float DerivativeCutoff;
+
+public:
+	virtual FVector Apply(const FVector& Value, float DeltaSeconds, FInputFilterState& State) const override;
+
+protected:
+	static float GetAlpha(float Cutoff, float DeltaSeconds);
+
+};
+
+
+/**
+ * Radial deadzone: removes stick input below the inner radius and rescales the rest to the 0-1 range
+ */
+class GEINPUT_API FInputFilter_RadialDeadzone : public FInputFilter
+{
+public:
+	FInputFilter_RadialDeadzone(float InInnerRadius = 0.2f, float InOuterRadius = 1.0f)
+		: InnerRadius(InInnerRadius), OuterRadius(InOuterRadius)
+	{}
+
+protected:
+	float InnerRadius;
+	float OuterRadius;
+
+public:
+	virtual FVector Apply(const FVector& Value, float DeltaSeconds, FInputFilterState& State) const override;
+
+};
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Tuple.h"
+#include "Templates/IntegerSequence.h"
+
+#include "Filter/InputFilterStages.h"
+
+
+/**
+ * Chain of filter stages composed at compile time and applied in order
+ *
+ * Tips:
+ *	The stage parameters are properties of the owning processor, the chain only points to them,
+ *	so designers can edit them while the stages are inlined without virtual calls or heap state.
+ *
+ *	UPROPERTY(EditDefaultsOnly) FInputFilterStage_Deadzone LookDeadzone;
+ *	UPROPERTY(EditDefaultsOnly) FInputFilterStage_Invert LookInvert;
+ *	TInputFilterChain<FInputFilterStage_Deadzone, FInputFilterStage_Invert> LookFilter{ LookDeadzone, LookInvert };
+ */
+template<typename... TStages>
+class TInputFilterChain
+{
+public:
+	explicit TInputFilterChain(const TStages&... InStages)
+		: Stages(&InStages...)
+	{}
+
+	// Stages point into the owner and cannot be copied to another owner
+
+	TInputFilterChain(const TInputFilterChain&) = delete;
+	TInputFilterChain& operator=(const TInputFilterChain&) = delete;
+
+private:
+	TTuple<const TStages*...> Stages;
+
+	TTuple<typename TStages::FState...> States;
+
+public:
+	/**
+	 * Applies every stage in order, DeltaSeconds is the time since the previous value
+	 */
+	FORCEINLINE FVector Apply(const FVector& Value, float DeltaSeconds)
+	{
+		return ApplyStages(Value, DeltaSeconds, TMakeIntegerSequence<uint32, sizeof...(TStages)>());
+	}
+
+	FORCEINLINE FVector2D Apply(const FVector2D& Value, float DeltaSeconds)
+	{
+		const auto Result{ Apply(FVector(Value.X, Value.Y, 0.0), DeltaSeconds) };
+		return FVector2D(Result.X, Result.Y);
+	}
+
+	/**
+	 * Clears the state of the stateful stages
+	 */
+	void Reset()
+	{
+		States = TTuple<typename TStages::FState...>();
+	}
+
+private:
+	template<uint32... Indices>
+	FORCEINLINE FVector ApplyStages(FVector Value, float DeltaSeconds, TIntegerSequence<uint32, Indices...>)
+	{
+		((Value = Stages.template Get<Indices>()->Apply(Value, DeltaSeconds, States.template Get<Indices>())), ...);
+		return Value;
+	}
+};
@@ -0,0 +1,123 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "InputFilterStages.generated.h"
+
+
+/**
+ * Stages composed at compile time by TInputFilterChain
+ *
+ * Tips:
+ *	A stage is a struct with its parameters as properties, a nested FState (empty if stateless)
+ *	and an inline, branch free Apply(Value, DeltaSeconds, State).
+ */
+
+
+/**
+ * Radial deadzone: removes stick input below the inner radius and rescales the rest to the 0-1 range
+ */
+USTRUCT(BlueprintType)
+struct GEINPUT_API FInputFilterStage_Deadzone
+{
+	GENERATED_BODY()
+public:
+	struct FState {};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deadzone", meta = (ClampMin = 0, ClampMax = 1))
+	float InnerRadius{ 0.0f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deadzone", meta = (ClampMin = 0, ClampMax = 1))
+	float OuterRadius{ 1.0f };
+
+public:
+	FORCEINLINE FVector Apply(const FVector& Value, float DeltaSeconds, FState& State) const
+	{
+		const auto Magnitude{ FVector2D(Value.X, Value.Y).Size() };
+		const auto Scaled{ FMath::Clamp((Magnitude - InnerRadius) / FMath::Max(static_cast<double>(OuterRadius - InnerRadius), UE_DOUBLE_KINDA_SMALL_NUMBER), 0.0, 1.0) };
+		const auto Scale{ Scaled / FMath::Max(Magnitude, UE_DOUBLE_KINDA_SMALL_NUMBER) };
+
+		return FVector(Value.X * Scale, Value.Y * Scale, Value.Z);
+	}
+};
+
+
+/**
+ * Response curve: raises the stick magnitude to a power, values above 1 give finer control near the center
+ */
+USTRUCT(BlueprintType)
+struct GEINPUT_API FInputFilterStage_ResponseCurve
+{
+	GENERATED_BODY()
+public:
+	struct FState {};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Response Curve", meta = (ClampMin = 0.1))
+	float Exponent{ 1.0f };
+
+public:
+	FORCEINLINE FVector Apply(const FVector& Value, float DeltaSeconds, FState& State) const
+	{
+		const auto Magnitude{ FVector2D(Value.X, Value.Y).Size() };
+		const auto Scale{ FMath::Pow(Magnitude, static_cast<double>(Exponent)) / FMath::Max(Magnitude, UE_DOUBLE_KINDA_SMALL_NUMBER) };
+
+		return FVector(Value.X * Scale, Value.Y * Scale, Value.Z);
+	}
+};
+
+
+/**
+ * Exponential smoothing towards the latest value
+ */
+USTRUCT(BlueprintType)
+struct GEINPUT_API FInputFilterStage_Smoothing
+{
+	GENERATED_BODY()
+public:
+	struct FState
+	{
+		FVector Value{ FVector::ZeroVector };
+	};
+
+	//
+	// Time in seconds over which the value follows its input, 0 disables smoothing
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (ClampMin = 0, Units = "Seconds"))
+	float SmoothingTime{ 0.0f };
+
+public:
+	FORCEINLINE FVector Apply(const FVector& Value, float DeltaSeconds, FState& State) const
+	{
+		const auto Alpha{ DeltaSeconds / FMath::Max(DeltaSeconds + SmoothingTime, UE_KINDA_SMALL_NUMBER) };
+
+		State.Value = FMath::Lerp(State.Value, Value, Alpha);
+
+		return State.Value;
+	}
+};
+
+
+/**
+ * Inverts the axes of the value
+ */
+USTRUCT(BlueprintType)
+struct GEINPUT_API FInputFilterStage_Invert
+{
+	GENERATED_BODY()
+public:
+	struct FState {};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Invert")
+	bool bInvertX{ false };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Invert")
+	bool bInvertY{ false };
+
+public:
+	FORCEINLINE FVector Apply(const FVector& Value, float DeltaSeconds, FState& State) const
+	{
+		return FVector(Value.X * (1.0 - 2.0 * bInvertX), Value.Y * (1.0 - 2.0 * bInvertY), Value.Z);
+	}
+};
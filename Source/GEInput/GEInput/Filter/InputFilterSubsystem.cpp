@@ -0,0 +1,287 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputFilterSubsystem.h"
+
+#include "InputProcessComponent.h"
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Async/ParallelFor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputFilterSubsystem)
+
+
+namespace GEInputFilters
+{
+	static bool bParallel{ true };
+	static FAutoConsoleVariableRef CVarParallel(
+		TEXT("GEInput.Filters.Parallel"),
+		bParallel,
+		TEXT("Applies the input filters of different components on task graph workers in parallel."));
+}
+
+
+// FInputFilterTickFunction
+
+void FInputFilterTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && (TickType != LEVELTICK_ViewportsOnly))
+	{
+		Target->RunFilters();
+	}
+}
+
+
+// UInputFilterSubsystem
+
+void UInputFilterSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TickFunction.Target = this;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bRunOnAnyThread = false;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+	for (auto& Entry : Components)
+	{
+		AddTickDependencies(Entry);
+	}
+}
+
+void UInputFilterSubsystem::Deinitialize()
+{
+	for (auto& Entry : Components)
+	{
+		RemoveTickDependencies(Entry);
+		UnbindPossessionEvents(Entry.Owner.Get());
+	}
+
+	Components.Empty();
+
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	TickFunction.Target = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UInputFilterSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+
+void UInputFilterSubsystem::RegisterComponent(UInputProcessComponent* Component)
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (!Component || Components.ContainsByPredicate([Component](const FRegisteredComponent& Each) { return Each.Component == Component; }))
+	{
+		return;
+	}
+
+	auto* Owner{ Component->GetOwner() };
+
+	auto& NewEntry{ Components.AddDefaulted_GetRef() };
+	NewEntry.Component = Component;
+	NewEntry.Owner = Owner;
+
+	ResolveTickDependencies(NewEntry);
+	BindPossessionEvents(Owner);
+
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		AddTickDependencies(NewEntry);
+	}
+}
+
+void UInputFilterSubsystem::UnregisterComponent(UInputProcessComponent* Component)
+{
+	const auto Index{ Components.IndexOfByPredicate([Component](const FRegisteredComponent& Each) { return Each.Component == Component; }) };
+
+	if (Index != INDEX_NONE)
+	{
+		auto* Owner{ Components[Index].Owner.Get() };
+
+		RemoveTickDependencies(Components[Index]);
+
+		Components.RemoveAtSwap(Index);
+
+		// Other components of the same actor still need the events
+
+		if (!Components.ContainsByPredicate([Owner](const FRegisteredComponent& Each) { return Each.Owner == Owner; }))
+		{
+			UnbindPossessionEvents(Owner);
+		}
+	}
+}
+
+void UInputFilterSubsystem::AddTickDependencies(FRegisteredComponent& Entry)
+{
+	if (auto* Controller{ Entry.Controller.Get() })
+	{
+		TickFunction.AddPrerequisite(Controller, Controller->PrimaryActorTick);
+	}
+
+	if (auto* Pawn{ Entry.Pawn.Get() })
+	{
+		Pawn->PrimaryActorTick.AddPrerequisite(this, TickFunction);
+
+		if (auto* MovementComponent{ Pawn->GetMovementComponent() })
+		{
+			MovementComponent->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+		}
+	}
+}
+
+void UInputFilterSubsystem::RemoveTickDependencies(FRegisteredComponent& Entry)
+{
+	if (auto* Controller{ Entry.Controller.Get() })
+	{
+		TickFunction.RemovePrerequisite(Controller, Controller->PrimaryActorTick);
+	}
+
+	if (auto* Pawn{ Entry.Pawn.Get() })
+	{
+		Pawn->PrimaryActorTick.RemovePrerequisite(this, TickFunction);
+
+		if (auto* MovementComponent{ Pawn->GetMovementComponent() })
+		{
+			MovementComponent->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+		}
+	}
+}
+
+void UInputFilterSubsystem::ResolveTickDependencies(FRegisteredComponent& Entry)
+{
+	// The component belongs to a controller or to a pawn driven by one
+
+	auto* Owner{ Entry.Owner.Get() };
+	auto* Pawn{ Cast<APawn>(Owner) };
+	auto* Controller{ Pawn ? Pawn->GetController() : Cast<AController>(Owner) };
+
+	if (!Pawn && Controller)
+	{
+		Pawn = Controller->GetPawn();
+	}
+
+	Entry.Controller = Controller;
+	Entry.Pawn = Pawn;
+}
+
+void UInputFilterSubsystem::UpdateTickDependencies()
+{
+	const auto bRegistered{ TickFunction.IsTickFunctionRegistered() };
+
+	for (auto& Entry : Components)
+	{
+		auto NewEntry{ Entry };
+		ResolveTickDependencies(NewEntry);
+
+		if ((NewEntry.Controller == Entry.Controller) && (NewEntry.Pawn == Entry.Pawn))
+		{
+			continue;
+		}
+
+		if (bRegistered)
+		{
+			RemoveTickDependencies(Entry);
+			AddTickDependencies(NewEntry);
+		}
+
+		Entry = NewEntry;
+	}
+}
+
+void UInputFilterSubsystem::BindPossessionEvents(AActor* Owner)
+{
+	if (auto* Controller{ Cast<AController>(Owner) })
+	{
+		Controller->OnPossessedPawnChanged.AddUniqueDynamic(this, &ThisClass::HandlePossessedPawnChanged);
+	}
+	else if (auto* Pawn{ Cast<APawn>(Owner) })
+	{
+		Pawn->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
+void UInputFilterSubsystem::UnbindPossessionEvents(AActor* Owner)
+{
+	if (auto* Controller{ Cast<AController>(Owner) })
+	{
+		Controller->OnPossessedPawnChanged.RemoveDynamic(this, &ThisClass::HandlePossessedPawnChanged);
+	}
+	else if (auto* Pawn{ Cast<APawn>(Owner) })
+	{
+		Pawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
+void UInputFilterSubsystem::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	UpdateTickDependencies();
+}
+
+void UInputFilterSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	UpdateTickDependencies();
+}
+
+
+void UInputFilterSubsystem::RunFilters()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_RunInputFilters);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_RunInputFilters);
+
+	PendingComponents.Reset();
+
+	for (const auto& Entry : Components)
+	{
+		if (auto* Component{ Entry.Component.Get() }; Component && Component->HasPendingFilteredEvents())
+		{
+			PendingComponents.Add(Component);
+		}
+	}
+
+	if (PendingComponents.IsEmpty())
+	{
+		return;
+	}
+
+	// Filters only touch the state and events of their own component
+
+	if (GEInputFilters::bParallel && (PendingComponents.Num() > 1))
+	{
+		ParallelFor(PendingComponents.Num(),
+			[this](int32 Index)
+			{
+				PendingComponents[Index]->ApplyInputFilters();
+			});
+	}
+	else
+	{
+		for (auto* Component : PendingComponents)
+		{
+			Component->ApplyInputFilters();
+		}
+	}
+
+	// Processors run on the game thread in registration order
+
+	for (auto* Component : PendingComponents)
+	{
+		Component->FlushFilteredEvents();
+	}
+}
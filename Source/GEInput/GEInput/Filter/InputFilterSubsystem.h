@@ -0,0 +1,119 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "InputFilterSubsystem.generated.h"
+
+class UInputFilterSubsystem;
+class UInputProcessComponent;
+class AController;
+class APawn;
+class AActor;
+
+
+/**
+ * Tick function that applies the input filters of every component once the player controllers processed their input
+ */
+USTRUCT()
+struct FInputFilterTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+public:
+	UInputFilterSubsystem* Target{ nullptr };
+
+public:
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("FInputFilterTickFunction"); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FInputFilterTickFunction> : public TStructOpsTypeTraitsBase2<FInputFilterTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+
+/**
+ * Runs the input filters of all input components of a world in parallel and dispatches the results on the game thread
+ *
+ * Tips:
+ *	Ticks in TG_PrePhysics after the player controllers of the registered components and before their pawns,
+ *	so that filtered input reaches the processors in the same frame it was received.
+ *	The dependencies follow the possessed pawn of the controller and the controller of the pawn that owns the component.
+ */
+UCLASS()
+class GEINPUT_API UInputFilterSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UInputFilterSubsystem() {}
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+protected:
+	struct FRegisteredComponent
+	{
+		TWeakObjectPtr<UInputProcessComponent> Component;
+		TWeakObjectPtr<AActor> Owner;
+		TWeakObjectPtr<AController> Controller;
+		TWeakObjectPtr<APawn> Pawn;
+	};
+
+	FInputFilterTickFunction TickFunction;
+
+	TArray<FRegisteredComponent> Components;
+
+	//
+	// Components with queued events, collected on every run
+	//
+	TArray<UInputProcessComponent*> PendingComponents;
+
+public:
+	/**
+	 * Adds the component to the parallel filter stage, events queued by it are filtered and dispatched on the next run
+	 */
+	void RegisterComponent(UInputProcessComponent* Component);
+	void UnregisterComponent(UInputProcessComponent* Component);
+
+	/**
+	 * Returns true if queued events are filtered and dispatched by this subsystem this frame
+	 */
+	bool IsRunning() const { return TickFunction.IsTickFunctionRegistered(); }
+
+	/**
+	 * Applies the filters of every component with queued events and dispatches the filtered events
+	 */
+	void RunFilters();
+
+protected:
+	void AddTickDependencies(FRegisteredComponent& Entry);
+	void RemoveTickDependencies(FRegisteredComponent& Entry);
+
+	/**
+	 * Resolves the controller and pawn of the component from its owner
+	 */
+	static void ResolveTickDependencies(FRegisteredComponent& Entry);
+
+	/**
+	 * Moves the dependencies of every component whose controller or pawn changed
+	 */
+	void UpdateTickDependencies();
+
+	void BindPossessionEvents(AActor* Owner);
+	void UnbindPossessionEvents(AActor* Owner);
+
+	UFUNCTION()
+	void HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+};
@@ -3,19 +3,22 @@
 #include "GameFeatureAction_AddInputContextMapping.h"
 
 #include "InputProcessComponent.h"
-
-#include "AssetManager/GFCAssetManager.h"
+#include "Mapping/InputMappingContextRegistry.h"
+#include "Mapping/InputMappingCompositeSubsystem.h"
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
 
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
 #include "Components/GameFrameworkComponentManager.h"
-#include "UserSettings/EnhancedInputUserSettings.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
 
 #if WITH_EDITOR
+#include "Development/InputFeatureValidator.h"
 #include "Misc/DataValidation.h"
 #endif
 
@@ -42,6 +45,8 @@ EDataValidationResult UGameFeatureAction_AddInputContextMapping::IsDataValid(FDa
 		++Index;
 	}
 
+	FInputFeatureValidator::ValidateOwningFeature(this, Context);
+
 	return Result;
 }
 #endif
@@ -49,6 +54,8 @@ EDataValidationResult UGameFeatureAction_AddInputContextMapping::IsDataValid(FDa
 
 void UGameFeatureAction_AddInputContextMapping::OnGameFeatureRegistering()
 {
+	GEINPUT_LLM_SCOPE();
+
 	Super::OnGameFeatureRegistering();
 
 	RegisterInputMappingContexts();
@@ -56,6 +63,10 @@ void UGameFeatureAction_AddInputContextMapping::OnGameFeatureRegistering()
 
 void UGameFeatureAction_AddInputContextMapping::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
 {
+	GEINPUT_LLM_SCOPE();
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputContextMapping_Activating);
+	GEINPUT_TRACE_FEATURE_ACTION_CHANGED(this, true);
+
 	auto& ActiveData{ ContextData.FindOrAdd(Context) };
 
 	if (!ensure(ActiveData.ExtensionRequestHandles.IsEmpty()) ||
@@ -64,11 +75,21 @@ void UGameFeatureAction_AddInputContextMapping::OnGameFeatureActivating(FGameFea
 		Reset(ActiveData);
 	}
 
+	// Deferred registrations must reach the user settings before the mapping contexts are added to the players
+
+	if (auto* Registry{ FInputMappingContextRegistry::Get() })
+	{
+		Registry->Flush();
+	}
+
 	Super::OnGameFeatureActivating(Context);
 }
 
 void UGameFeatureAction_AddInputContextMapping::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
 {
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputContextMapping_Deactivating);
+	GEINPUT_TRACE_FEATURE_ACTION_CHANGED(this, false);
+
 	Super::OnGameFeatureDeactivating(Context);
 
 	auto* ActiveData{ ContextData.Find(Context) };
@@ -89,118 +110,42 @@ void UGameFeatureAction_AddInputContextMapping::OnGameFeatureUnregistering()
 
 void UGameFeatureAction_AddInputContextMapping::RegisterInputMappingContexts()
 {
-	RegisterInputContextMappingsForGameInstanceHandle = FWorldDelegates::OnStartGameInstance.AddUObject(this, &UGameFeatureAction_AddInputContextMapping::RegisterInputContextMappingsForGameInstance);
-
-	const auto& WorldContexts{ GEngine->GetWorldContexts() };
+	auto* Registry{ FInputMappingContextRegistry::Get() };
 
-	for (auto WorldContextIterator{ WorldContexts.CreateConstIterator() }; WorldContextIterator; ++WorldContextIterator)
+	if (!Registry)
 	{
-		RegisterInputContextMappingsForGameInstance(WorldContextIterator->OwningGameInstance);
+		return;
 	}
-}
 
-void UGameFeatureAction_AddInputContextMapping::RegisterInputContextMappingsForGameInstance(UGameInstance* GameInstance)
-{
-	if (GameInstance != nullptr && !GameInstance->OnLocalPlayerAddedEvent.IsBoundToObject(this))
-	{
-		GameInstance->OnLocalPlayerAddedEvent.AddUObject(this, &UGameFeatureAction_AddInputContextMapping::RegisterInputMappingContextsForLocalPlayer);
-		GameInstance->OnLocalPlayerRemovedEvent.AddUObject(this, &UGameFeatureAction_AddInputContextMapping::UnregisterInputMappingContextsForLocalPlayer);
+	TArray<TSoftObjectPtr<UInputMappingContext>> MappingContexts;
+	MappingContexts.Reserve(InputMappings.Num());
 
-		for (auto LocalPlayerIterator{ GameInstance->GetLocalPlayerIterator() }; LocalPlayerIterator; ++LocalPlayerIterator)
-		{
-			RegisterInputMappingContextsForLocalPlayer(*LocalPlayerIterator);
-		}
-	}
-}
-
-void UGameFeatureAction_AddInputContextMapping::RegisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer)
-{
-	ensure(LocalPlayer);
-
-	auto* EISubsystem{ ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer) };
-	auto* Settings{ EISubsystem ? EISubsystem->GetUserSettings() : nullptr};
-
-	if (Settings)
+	for (const auto& Entry : InputMappings)
 	{
-		auto& AssetManager{ UGFCAssetManager::Get() };
+		// Skip entries that don't want to be registered
 
-		for (const auto& Entry : InputMappings)
+		if (Entry.bRegisterWithSettings)
 		{
-			// Skip entries that don't want to be registered
-
-			if (!Entry.bRegisterWithSettings)
-			{
-				continue;
-			}
-
-			// Register this IMC with the settings!
-
-			if (auto* IMC{ AssetManager.GetAsset(Entry.InputMapping) })
-			{
-				Settings->RegisterInputMappingContext(IMC);
-			}
+			MappingContexts.Add(Entry.InputMapping);
 		}
 	}
-}
-
-void UGameFeatureAction_AddInputContextMapping::UnregisterInputMappingContexts()
-{
-	FWorldDelegates::OnStartGameInstance.Remove(RegisterInputContextMappingsForGameInstanceHandle);
-	RegisterInputContextMappingsForGameInstanceHandle.Reset();
-
-	const auto& WorldContexts{ GEngine->GetWorldContexts() };
-
-	for (auto WorldContextIterator{ WorldContexts.CreateConstIterator() }; WorldContextIterator; ++WorldContextIterator)
-	{
-		UnregisterInputContextMappingsForGameInstance(WorldContextIterator->OwningGameInstance);
-	}
-}
-
-void UGameFeatureAction_AddInputContextMapping::UnregisterInputContextMappingsForGameInstance(UGameInstance* GameInstance)
-{
-	if (GameInstance != nullptr)
-	{
-		GameInstance->OnLocalPlayerAddedEvent.RemoveAll(this);
-		GameInstance->OnLocalPlayerRemovedEvent.RemoveAll(this);
 
-		for (auto LocalPlayerIterator{ GameInstance->GetLocalPlayerIterator() }; LocalPlayerIterator; ++LocalPlayerIterator)
-		{
-			UnregisterInputMappingContextsForLocalPlayer(*LocalPlayerIterator);
-		}
-	}
+	Registry->RegisterMappingContexts(this, MappingContexts);
 }
 
-void UGameFeatureAction_AddInputContextMapping::UnregisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer)
+void UGameFeatureAction_AddInputContextMapping::UnregisterInputMappingContexts()
 {
-	ensure(LocalPlayer);
-
-	auto* EISubsystem{ ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer) };
-	auto* Settings{ EISubsystem ? EISubsystem->GetUserSettings() : nullptr };
-
-	if (Settings)
+	if (auto* Registry{ FInputMappingContextRegistry::Get() })
 	{
-		for (const auto& Entry : InputMappings)
-		{
-			// Skip entries that don't want to be registered
-
-			if (!Entry.bRegisterWithSettings)
-			{
-				continue;
-			}
-
-			// Register this IMC with the settings!
-
-			if (auto* IMC{ Entry.InputMapping.Get() })
-			{
-				Settings->UnregisterInputMappingContext(IMC);
-			}
-		}
+		Registry->UnregisterMappingContexts(this);
 	}
 }
 
 
 void UGameFeatureAction_AddInputContextMapping::AddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
 {
+	GEINPUT_LLM_SCOPE();
+
 	auto* World{ WorldContext.World() };
 	const auto bIsGameWorld{ World ? World->IsGameWorld() : false };
 
@@ -222,17 +167,21 @@ void UGameFeatureAction_AddInputContextMapping::Reset(FPerContextData& ActiveDat
 {
 	ActiveData.ExtensionRequestHandles.Empty();
 
-	while (!ActiveData.ControllersAddedTo.IsEmpty())
-	{
-		auto ControllerPtr{ ActiveData.ControllersAddedTo.Top() };
+	// Taken out first so that removing each controller does not touch the map
+
+	const auto ControllersAddedTo{ MoveTemp(ActiveData.ControllersAddedTo) };
+	ActiveData.ControllersAddedTo.Reset();
 
-		if (ControllerPtr.IsValid())
+	for (const auto& KVP : ControllersAddedTo)
+	{
+		if (!ReleaseController(KVP.Key))
 		{
-			RemoveInputMapping(ControllerPtr.Get(), ActiveData);
+			continue;
 		}
-		else
+
+		if (auto* PlayerController{ KVP.Value.Get() })
 		{
-			ActiveData.ControllersAddedTo.Pop();
+			RemoveInputMappingFromPlayer(PlayerController);
 		}
 	}
 }
@@ -254,44 +203,126 @@ void UGameFeatureAction_AddInputContextMapping::HandleControllerExtension(AActor
 
 void UGameFeatureAction_AddInputContextMapping::AddInputMappingForPlayer(APlayerController* PlayerController, FPerContextData& ActiveData)
 {
+	GEINPUT_LLM_SCOPE();
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_AddInputMappingForPlayer);
+
 	if (auto* LocalPlayer{ PlayerController->GetLocalPlayer() })
 	{
-		if (auto* InputSystem{ LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() })
+		auto* CompositeSubsystem{ LocalPlayer->GetSubsystem<UInputMappingCompositeSubsystem>() };
+		auto* InputSystem{ LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() };
+
+		if (!InputSystem)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Failed to find `UEnhancedInputLocalPlayerSubsystem` for local player. Input mappings will not be added. Make sure you're set to use the EnhancedInput system via config file."));
+		}
+		else if (!CompositeSubsystem)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Failed to find `UInputMappingCompositeSubsystem` for local player. Input mappings will not be added."));
+		}
+		else
 		{
+			TArray<FInputMappingCompositeSource> Sources;
+			Sources.Reserve(InputMappings.Num());
+
 			for (const auto& Entry : InputMappings)
 			{
 				if (const auto* IMC{ Entry.InputMapping.Get() })
 				{
-					InputSystem->AddMappingContext(IMC, Entry.Priority);
+					Sources.Add({ IMC, Entry.Priority });
 				}
 			}
-		}
-		else
-		{
-			UE_LOG(LogGameFeatures, Error, TEXT("Failed to find `UEnhancedInputLocalPlayerSubsystem` for local player. Input mappings will not be added. Make sure you're set to use the EnhancedInput system via config file."));
+
+			CompositeSubsystem->AddMappingContexts(this, Sources);
 		}
 	}
 
-	ActiveData.ControllersAddedTo.Add(PlayerController);
+	// Repeated extension events of the same context count once
+
+	if (!ActiveData.ControllersAddedTo.Contains(PlayerController))
+	{
+		ActiveData.ControllersAddedTo.Add(PlayerController, PlayerController);
+		++ControllerRefCounts.FindOrAdd(PlayerController);
+	}
 }
 
 void UGameFeatureAction_AddInputContextMapping::RemoveInputMapping(APlayerController* PlayerController, FPerContextData& ActiveData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_RemoveInputMapping);
+
+	// Mapping contexts stay added while another context still tracks the controller
+
+	if ((ActiveData.ControllersAddedTo.Remove(PlayerController) > 0) && ReleaseController(PlayerController))
+	{
+		RemoveInputMappingFromPlayer(PlayerController);
+	}
+}
+
+void UGameFeatureAction_AddInputContextMapping::RemoveInputMappingFromPlayer(APlayerController* PlayerController)
 {
 	if (auto* LocalPlayer{ PlayerController->GetLocalPlayer() })
 	{
-		if (auto* InputSystem{ LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() })
+		if (auto* CompositeSubsystem{ LocalPlayer->GetSubsystem<UInputMappingCompositeSubsystem>() })
 		{
-			for (const auto& Entry : InputMappings)
-			{
-				if (const auto* IMC{ Entry.InputMapping.Get() })
-				{
-					InputSystem->RemoveMappingContext(IMC);
-				}
-			}
+			CompositeSubsystem->RemoveMappingContexts(this);
+		}
+	}
+}
+
+bool UGameFeatureAction_AddInputContextMapping::ReleaseController(const TObjectKey<APlayerController>& ControllerKey)
+{
+	auto* RefCount{ ControllerRefCounts.Find(ControllerKey) };
+
+	if (RefCount && (--(*RefCount) > 0))
+	{
+		return false;
+	}
+
+	ControllerRefCounts.Remove(ControllerKey);
+
+	return true;
+}
+
+
+#if !UE_BUILD_SHIPPING
+int32 UGameFeatureAction_AddInputContextMapping::GetNumTrackedControllers(int32* OutNumStale) const
+{
+	auto NumTracked{ 0 };
+	auto NumStale{ 0 };
+
+	for (const auto& KVP : ContextData)
+	{
+		for (const auto& Pair : KVP.Value.ControllersAddedTo)
+		{
+			++NumTracked;
+			NumStale += Pair.Value.IsValid() ? 0 : 1;
 		}
 	}
 
-	ActiveData.ControllersAddedTo.Remove(PlayerController);
+	if (OutNumStale)
+	{
+		*OutNumStale = NumStale;
+	}
+
+	return NumTracked;
 }
 
+bool UGameFeatureAction_AddInputContextMapping::IsAddedToController(const APlayerController* PlayerController) const
+{
+	if (!PlayerController)
+	{
+		return false;
+	}
+
+	for (const auto& KVP : ContextData)
+	{
+		if (KVP.Value.ControllersAddedTo.Contains(PlayerController))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
 #undef LOCTEXT_NAMESPACE
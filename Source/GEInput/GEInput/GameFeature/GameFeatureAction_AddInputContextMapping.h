@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFeature/GameFeatureAction_WorldActionBase.h"
+#include "UObject/ObjectKey.h"
 
 #include "GameFeatureAction_AddInputContextMapping.generated.h"
 
@@ -44,7 +45,7 @@ public:
  * Adds InputMappingContext to local players' EnhancedInput system.
  * Expects that local players are set up to use the EnhancedInput system.
  */
-UCLASS(meta = (DisplayName = "Add Input Mapping"))
+UCLASS(MinimalAPI, meta = (DisplayName = "Add Input Mapping"))
 class UGameFeatureAction_AddInputContextMapping final : public UGameFeatureAction_WorldActionBase
 {
 	GENERATED_BODY()
@@ -59,21 +60,27 @@ protected:
 	struct FPerContextData
 	{
 		TArray<TSharedPtr<FComponentRequestHandle>> ExtensionRequestHandles;
-		TArray<TWeakObjectPtr<APlayerController>> ControllersAddedTo;
+
+		//
+		// Controllers with added mapping contexts, keyed by object so that repeated extension events track them once
+		//
+		TMap<TObjectKey<APlayerController>, TWeakObjectPtr<APlayerController>> ControllersAddedTo;
 	};
 
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
 
 	//
-	// Delegate for when the game instance is changed to register IMC's
+	// Number of contexts that added mapping contexts to each controller, mapping contexts are removed with the last one
 	//
-	FDelegateHandle RegisterInputContextMappingsForGameInstanceHandle;
+	TMap<TObjectKey<APlayerController>, int32> ControllerRefCounts;
 
 protected:
 	UPROPERTY(EditAnywhere, Category = "Input")
 	TArray<FInputMappingContextAndPriority> InputMappings;
 
 public:
+	const TArray<FInputMappingContextAndPriority>& GetInputMappings() const { return InputMappings; }
+
 	virtual void OnGameFeatureRegistering() override;
 	virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
 	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
@@ -81,45 +88,40 @@ public:
 
 private:
 	/** 
-	 * Registers owned Input Mapping Contexts to the Input Registry Subsystem. 
-	 * Also binds onto the start of GameInstances and the adding/removal of Local Players. 
+	 * Registers owned Input Mapping Contexts with the user settings of every local player through FInputMappingContextRegistry. 
 	 */
 	void RegisterInputMappingContexts();
 
 	/** 
-	 * Registers owned Input Mapping Contexts to the Input Registry Subsystem for a specified GameInstance. 
-	 * This also gets called by a GameInstance Start. 
-	 */
-	void RegisterInputContextMappingsForGameInstance(UGameInstance* GameInstance);
-
-	/** 
-	 * Registers owned Input Mapping Contexts to the Input Registry Subsystem for a specified Local Player. 
-	 * This also gets called when a Local Player is added. 
-	 */
-	void RegisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer);
-
-	/** 
-	 * Unregisters owned Input Mapping Contexts from the Input Registry Subsystem. 
-	 * Also unbinds from the start of GameInstances and the adding/removal of Local Players. 
+	 * Unregisters owned Input Mapping Contexts from FInputMappingContextRegistry. 
 	 */
 	void UnregisterInputMappingContexts();
 
-	/** 
-	 * Unregisters owned Input Mapping Contexts from the Input Registry Subsystem for a specified GameInstance. 
-	 */
-	void UnregisterInputContextMappingsForGameInstance(UGameInstance* GameInstance);
-
-	/** 
-	 * Unregisters owned Input Mapping Contexts from the Input Registry Subsystem for a specified Local Player. 
-	 * This also gets called when a Local Player is removed. 
-	 */
-	void UnregisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer);
-
 	virtual void AddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
 
 	void Reset(FPerContextData& ActiveData);
 	void HandleControllerExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext);
 	void AddInputMappingForPlayer(APlayerController* PlayerController, FPerContextData& ActiveData);
 	void RemoveInputMapping(APlayerController* PlayerController, FPerContextData& ActiveData);
+	void RemoveInputMappingFromPlayer(APlayerController* PlayerController);
+
+	/**
+	 * Releases the reference of a context to the controller and returns true if it was the last one
+	 */
+	bool ReleaseController(const TObjectKey<APlayerController>& ControllerKey);
+
+#if !UE_BUILD_SHIPPING
+public:
+	/**
+	 * Returns number of controller entries tracked over all contexts.
+	 * Optionally returns how many of them point to destroyed controllers.
+	 */
+	GEINPUT_API int32 GetNumTrackedControllers(int32* OutNumStale = nullptr) const;
+
+	/**
+	 * Returns true if this action has added its mapping contexts to the controller in any context
+	 */
+	bool IsAddedToController(const APlayerController* PlayerController) const;
+#endif
 
 };
@@ -3,11 +3,17 @@
 #include "GameFeatureAction_AddInputProcessors.h"
 
 #include "InputProcessComponent.h"
+#include "Processor/InputProcessor.h"
+#include "Replication/InputReplicationComponent.h"
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
 
 #include "Components/GameFrameworkComponentManager.h"
 #include "GameFramework/Actor.h"
 
 #if WITH_EDITOR
+#include "Development/InputFeatureValidator.h"
 #include "Misc/DataValidation.h"
 #endif
 
@@ -35,6 +41,8 @@ EDataValidationResult UGameFeatureAction_AddInputProcessors::IsDataValid(FDataVa
 		++Index;
 	}
 
+	FInputFeatureValidator::ValidateOwningFeature(this, Context);
+
 	return Result;
 }
 #endif
@@ -42,6 +50,10 @@ EDataValidationResult UGameFeatureAction_AddInputProcessors::IsDataValid(FDataVa
 
 void UGameFeatureAction_AddInputProcessors::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
 {
+	GEINPUT_LLM_SCOPE();
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputProcessors_Activating);
+	GEINPUT_TRACE_FEATURE_ACTION_CHANGED(this, true);
+
 	auto& ActiveData{ ContextData.FindOrAdd(Context) };
 
 	if (!ensure(ActiveData.ExtensionRequestHandles.IsEmpty()) || 
@@ -50,11 +62,16 @@ void UGameFeatureAction_AddInputProcessors::OnGameFeatureActivating(FGameFeature
 		Reset(ActiveData);
 	}
 
+	BuildInputProcessorsByActorClass();
+
 	Super::OnGameFeatureActivating(Context);
 }
 
 void UGameFeatureAction_AddInputProcessors::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
 {
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputProcessors_Deactivating);
+	GEINPUT_TRACE_FEATURE_ACTION_CHANGED(this, false);
+
 	Super::OnGameFeatureDeactivating(Context);
 
 	auto* ActiveData{ ContextData.Find(Context) };
@@ -68,6 +85,8 @@ void UGameFeatureAction_AddInputProcessors::OnGameFeatureDeactivating(FGameFeatu
 
 void UGameFeatureAction_AddInputProcessors::AddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
 {
+	GEINPUT_LLM_SCOPE();
+
 	auto* World{ WorldContext.World() };
 	const auto bIsGameWorld{ World ? World->IsGameWorld() : false };
 
@@ -78,16 +97,15 @@ void UGameFeatureAction_AddInputProcessors::AddToWorld(const FWorldContext& Worl
 
 	if (ComponentManager && bIsGameWorld)
 	{
+		// One handler per actor class, each actor receives a single callback that adds all of its processors
+
 		auto EntryIndex{ 0 };
-		for (const auto& Entry : InputProcessors)
+		for (const auto& Entry : InputProcessorsByActorClass)
 		{
-			if (auto* Manager{ UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance) })
-			{
-				auto NewDelegate{ UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, EntryIndex, ChangeContext) };
-				auto ExtensionRequestHandle{ Manager->AddExtensionHandler(Entry.ActorClass, NewDelegate) };
+			auto NewDelegate{ UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, EntryIndex, ChangeContext) };
+			auto ExtensionRequestHandle{ ComponentManager->AddExtensionHandler(Entry.ActorClass, NewDelegate) };
 
-				ActiveData.ExtensionRequestHandles.Add(ExtensionRequestHandle);
-			}
+			ActiveData.ExtensionRequestHandles.Add(ExtensionRequestHandle);
 
 			EntryIndex++;
 		}
@@ -99,17 +117,41 @@ void UGameFeatureAction_AddInputProcessors::Reset(FPerContextData& ActiveData)
 {
 	ActiveData.ExtensionRequestHandles.Empty();
 
-	while (!ActiveData.ActorsAddedTo.IsEmpty())
+	// Every entry is going away, so processors are removed regardless of the remaining entries
+
+	for (const auto& KVP : ActiveData.ActorsAddedTo)
 	{
-		auto ActorPtr{ ActiveData.ActorsAddedTo.Top() };
+		if (auto* Actor{ KVP.Value.Actor.Get() })
+		{
+			RemoveAllInputProcessorsForActor(Actor);
+		}
+	}
+
+	ActiveData.ActorsAddedTo.Reset();
+}
 
-		if (ActorPtr.IsValid())
+void UGameFeatureAction_AddInputProcessors::BuildInputProcessorsByActorClass()
+{
+	InputProcessorsByActorClass.Reset();
+
+	for (const auto& Entry : InputProcessors)
+	{
+		if (Entry.ActorClass.IsNull())
 		{
-			RemoveInputProcessorsForActor(ActorPtr.Get(), ActiveData);
+			continue;
 		}
-		else
+
+		auto* Merged{ InputProcessorsByActorClass.FindByPredicate([&Entry](const FInputProcessorsToAdd& Each) { return Each.ActorClass == Entry.ActorClass; }) };
+
+		if (!Merged)
 		{
-			ActiveData.ActorsAddedTo.Pop();
+			Merged = &InputProcessorsByActorClass.AddDefaulted_GetRef();
+			Merged->ActorClass = Entry.ActorClass;
+		}
+
+		for (const auto& Processor : Entry.Processors)
+		{
+			Merged->Processors.AddUnique(Processor);
 		}
 	}
 }
@@ -118,25 +160,39 @@ void UGameFeatureAction_AddInputProcessors::HandleActorExtension(AActor* Actor,
 {
 	auto* ActiveData{ ContextData.Find(ChangeContext) };
 
-	if (InputProcessors.IsValidIndex(EntryIndex) && ActiveData)
+	if (InputProcessorsByActorClass.IsValidIndex(EntryIndex) && ActiveData)
 	{
-		const auto& Entry{ InputProcessors[EntryIndex] };
-
 		if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 		{
-			RemoveInputProcessorsForActor(Actor, *ActiveData);
+			RemoveInputProcessorsForActor(Actor, EntryIndex, *ActiveData);
 		}
 		else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == UInputProcessComponent::NAME_InputComponentReady))
 		{
-			AddInputProcessorsForActor(Actor, Entry, *ActiveData);
+			AddInputProcessorsForActor(Actor, EntryIndex, *ActiveData);
 		}
 	}
 }
 
-void UGameFeatureAction_AddInputProcessors::AddInputProcessorsForActor(AActor* Actor, const FInputProcessorsToAdd& InputProcessorsToAdd, FPerContextData& ActiveData)
+void UGameFeatureAction_AddInputProcessors::AddInputProcessorsForActor(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
 {
+	GEINPUT_LLM_SCOPE();
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_AddInputProcessorsForActor);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputProcessorsForActor);
+
 	check(Actor);
 
+	const auto& InputProcessorsToAdd{ InputProcessorsByActorClass[EntryIndex] };
+
+	auto TrackActor
+	{
+		[Actor, EntryIndex, &ActiveData]()
+		{
+			auto& Tracked{ ActiveData.ActorsAddedTo.FindOrAdd(Actor) };
+			Tracked.Actor = Actor;
+			Tracked.EntryIndices.AddUnique(EntryIndex);
+		}
+	};
+
 	if (Actor->HasLocalNetOwner())
 	{
 		auto* InputComponent{ Cast<UInputProcessComponent>(Actor->InputComponent) };
@@ -146,29 +202,126 @@ void UGameFeatureAction_AddInputProcessors::AddInputProcessorsForActor(AActor* A
 		{
 			for (const auto& Entry : InputProcessorsToAdd.Processors)
 			{
+				if (!Entry.IsValid())
+				{
+					GEInputStats::RecordSynchronousLoad();
+				}
+
 				auto* ProcessorToAdd{ Entry.IsValid() ? Entry.Get() : Entry.LoadSynchronous() };
 
 				InputComponent->AddInputProcessor(ProcessorToAdd);
 			}
 		}
 
-		ActiveData.ActorsAddedTo.Add(Actor);
+		TrackActor();
+	}
+	else if (Actor->HasAuthority())
+	{
+		// Processors marked bRunOnServer also run on the server, fed by the owning client's input
+
+		UInputProcessComponent* ServerInputComponent{ nullptr };
+
+		for (const auto& Entry : InputProcessorsToAdd.Processors)
+		{
+			if (!Entry.IsValid())
+			{
+				GEInputStats::RecordSynchronousLoad();
+			}
+
+			auto* ProcessorToAdd{ Entry.IsValid() ? Entry.Get() : Entry.LoadSynchronous() };
+			const auto* ProcessorCDO{ ProcessorToAdd ? ProcessorToAdd->GetDefaultObject<UInputProcessor>() : nullptr };
+
+			if (!ProcessorCDO || !ProcessorCDO->ShouldRunOnServer())
+			{
+				continue;
+			}
+
+			if (!ServerInputComponent)
+			{
+				auto* ReplicationComponent{ UInputReplicationComponent::FindOrAddReplicationComponent(Actor) };
+				ServerInputComponent = ReplicationComponent ? ReplicationComponent->GetOrCreateServerInputComponent() : nullptr;
+			}
+
+			if (ServerInputComponent)
+			{
+				ServerInputComponent->AddInputProcessor(ProcessorToAdd);
+			}
+		}
+
+		if (ServerInputComponent)
+		{
+			TrackActor();
+		}
 	}
 }
 
-void UGameFeatureAction_AddInputProcessors::RemoveInputProcessorsForActor(AActor* Actor, FPerContextData& ActiveData)
+void UGameFeatureAction_AddInputProcessors::RemoveInputProcessorsForActor(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
 {
 	check(Actor);
 
-	auto* InputComponent{ Cast<UInputProcessComponent>(Actor->InputComponent) };
-	InputComponent = InputComponent ? InputComponent : Actor->FindComponentByClass<UInputProcessComponent>();
+	auto* Tracked{ ActiveData.ActorsAddedTo.Find(Actor) };
+
+	if (!Tracked)
+	{
+		return;
+	}
+
+	Tracked->EntryIndices.RemoveSwap(EntryIndex);
+
+	if (Tracked->EntryIndices.IsEmpty())
+	{
+		ActiveData.ActorsAddedTo.Remove(Actor);
+
+		RemoveAllInputProcessorsForActor(Actor);
+	}
+}
+
+void UGameFeatureAction_AddInputProcessors::RemoveAllInputProcessorsForActor(AActor* Actor)
+{
+	// Mirrors AddInputProcessorsForActor, the authority only added processors to the server input component
+
+	UInputProcessComponent* InputComponent{ nullptr };
+
+	if (Actor->HasLocalNetOwner())
+	{
+		InputComponent = Cast<UInputProcessComponent>(Actor->InputComponent);
+		InputComponent = InputComponent ? InputComponent : Actor->FindComponentByClass<UInputProcessComponent>();
+	}
+	else if (Actor->HasAuthority())
+	{
+		const auto* ReplicationComponent{ Actor->FindComponentByClass<UInputReplicationComponent>() };
+		InputComponent = ReplicationComponent ? ReplicationComponent->GetServerInputComponent() : nullptr;
+	}
 
 	if (InputComponent)
 	{
 		InputComponent->RemoveAllInputProcessors();
 	}
+}
 
-	ActiveData.ActorsAddedTo.Remove(Actor);
+
+#if !UE_BUILD_SHIPPING
+int32 UGameFeatureAction_AddInputProcessors::GetNumTrackedActors(int32* OutNumStale) const
+{
+	auto NumTracked{ 0 };
+	auto NumStale{ 0 };
+
+	for (const auto& KVP : ContextData)
+	{
+		for (const auto& Pair : KVP.Value.ActorsAddedTo)
+		{
+			++NumTracked;
+			NumStale += Pair.Value.Actor.IsValid() ? 0 : 1;
+		}
+	}
+
+	if (OutNumStale)
+	{
+		*OutNumStale = NumStale;
+	}
+
+	return NumTracked;
 }
+#endif
 
 #undef LOCTEXT_NAMESPACE
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFeature/GameFeatureAction_WorldActionBase.h"
+#include "UObject/ObjectKey.h"
 
 #include "GameFeatureAction_AddInputProcessors.generated.h"
 
@@ -39,7 +40,7 @@ public:
 /**
  * GameFeatureAction to grant InputProcessor
  */
-UCLASS(meta = (DisplayName = "Add Input Processor"))
+UCLASS(MinimalAPI, meta = (DisplayName = "Add Input Processor"))
 class UGameFeatureAction_AddInputProcessors final : public UGameFeatureAction_WorldActionBase
 {
 	GENERATED_BODY()
@@ -51,19 +52,36 @@ public:
 #endif // WITH_EDITOR
 
 private:
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		//
+		// Merged entries that added processors to the actor, processors are removed with the last one
+		//
+		TArray<int32, TInlineAllocator<2>> EntryIndices;
+	};
+
 	struct FPerContextData
 	{
 		TArray<TSharedPtr<FComponentRequestHandle>> ExtensionRequestHandles;
-		TArray<TWeakObjectPtr<AActor>> ActorsAddedTo;
+		TMap<TObjectKey<AActor>, FTrackedActor> ActorsAddedTo;
 	};
 
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
 
+	//
+	// InputProcessors merged by actor class on activation, extension handlers index into it
+	//
+	TArray<FInputProcessorsToAdd> InputProcessorsByActorClass;
+
 protected:
 	UPROPERTY(EditAnywhere, Category = "Input", meta = (AssetBundles = "Client,Server"))
 	TArray<FInputProcessorsToAdd> InputProcessors;
 
 public:
+	const TArray<FInputProcessorsToAdd>& GetInputProcessors() const { return InputProcessors; }
+
 	virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
 	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
 
@@ -71,8 +89,19 @@ public:
 
 private:
 	void Reset(FPerContextData& ActiveData);
+	void BuildInputProcessorsByActorClass();
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
-	void AddInputProcessorsForActor(AActor* Actor, const FInputProcessorsToAdd& InputProcessorsToAdd, FPerContextData& ActiveData);
-	void RemoveInputProcessorsForActor(AActor* Actor, FPerContextData& ActiveData);
+	void AddInputProcessorsForActor(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
+	void RemoveInputProcessorsForActor(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
+	void RemoveAllInputProcessorsForActor(AActor* Actor);
+
+#if !UE_BUILD_SHIPPING
+public:
+	/**
+	 * Returns number of actor entries tracked over all contexts.
+	 * Optionally returns how many of them point to destroyed actors.
+	 */
+	GEINPUT_API int32 GetNumTrackedActors(int32* OutNumStale = nullptr) const;
+#endif
 
 };
@@ -3,6 +3,13 @@
 #include "GEInputTags_Input.h"
 
 
+////////////////////////////////////
+// Input.Device
+
+UE_DEFINE_GAMEPLAY_TAG(TAG_Input_MouseAndKeyboard		, "Input.MouseAndKeyboard");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Input_Gamepad				, "Input.Gamepad");
+
+
 ////////////////////////////////////
 // Input.Move
 
@@ -5,6 +5,13 @@
 #include "NativeGameplayTags.h"
 
 
+////////////////////////////////////
+// Input.Device
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Input_MouseAndKeyboard);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Input_Gamepad);
+
+
 ////////////////////////////////////
 // Input.Move
 
@@ -3,17 +3,151 @@
 #include "InputProcessComponent.h"
 
 #include "Processor/InputProcessor.h"
+#include "Replication/InputReplicationComponent.h"
+#include "Device/ActiveInputDeviceSubsystem.h"
+#include "Intent/InputIntentBus.h"
+#include "Filter/InputFilter.h"
+#include "Filter/InputFilterSubsystem.h"
+#include "Mapping/InputMappingCompositeSubsystem.h"
+#include "Record/InputRecorder.h"
+#include "Record/InputPlayer.h"
+#include "Latency/InputLatencyTracker.h"
+#include "Development/InputAllocationCounter.h"
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+#include "GEInputLogs.h"
 
 #include "Components/GameFrameworkComponentManager.h"
+#include "GameplayTagsManager.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/LocalPlayer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessComponent)
 
 
+namespace GEInputDispatch
+{
+	//
+	// Maximum number of fixed rate simulation steps run in one frame
+	//
+	constexpr int32 MaxSimulationStepsPerFrame{ 8 };
+
+	//
+	// Number of events per input tag the dispatch queues are presized for
+	//
+	constexpr int32 NumPresizedEventsPerTag{ 4 };
+
+#if !UE_BUILD_SHIPPING
+	static int32 AssertNoAllocations{ 0 };
+	static FAutoConsoleVariableRef CVarAssertNoAllocations(
+		TEXT("GEInput.Dispatch.AssertNoAllocations"),
+		AssertNoAllocations,
+		TEXT("Checks that the dispatch path, from DispatchInputEvent, InjectInputEvent, playback, fixed rate steps and the filter stage down to the processors, ")
+		TEXT("does not allocate once the component is in steady state.\n")
+		TEXT("Requires -GEInputCountAllocations on the command line.\n")
+		TEXT("0: Disabled, 1: Log and ensure, 2: Fatal"));
+
+	static int32 SteadyStateFrames{ 300 };
+	static FAutoConsoleVariableRef CVarSteadyStateFrames(
+		TEXT("GEInput.Dispatch.SteadyStateFrames"),
+		SteadyStateFrames,
+		TEXT("Number of frames after the processors of a component changed before its dispatch is considered steady state."));
+
+	static bool bCheckingAllocations{ false };
+
+	/**
+	 * Counts the heap allocations made while an entry point of the dispatch path runs in steady state and reports them when it returns.
+	 * Entry points reached from inside another one count into the outer one.
+	 */
+	class FAllocationCheckScope
+	{
+	public:
+		FAllocationCheckScope(const TCHAR* InEntryPoint, const UObject* InOwner, bool bSteadyState, const FGameplayTag& InInputTag, ETriggerEvent InTriggerEvent)
+		{
+			if ((AssertNoAllocations <= 0) || bCheckingAllocations)
+			{
+				return;
+			}
+
+			if (!FInputAllocationScope::IsCounting())
+			{
+				static bool bWarnedNotCounting{ false };
+
+				UE_CLOG(!bWarnedNotCounting, LogGameCore_Input, Warning, TEXT("GEInput.Dispatch.AssertNoAllocations requires -GEInputCountAllocations on the command line"));
+				bWarnedNotCounting = true;
+				return;
+			}
+
+			if (bSteadyState)
+			{
+				EntryPoint = InEntryPoint;
+				Owner = InOwner;
+				InputTag = InInputTag;
+				TriggerEvent = InTriggerEvent;
+
+				bCheckingAllocations = true;
+				Scope.Emplace();
+			}
+		}
+
+		~FAllocationCheckScope()
+		{
+			if (!Scope.IsSet())
+			{
+				return;
+			}
+
+			const auto NumAllocations{ Scope->GetNumAllocations() };
+
+			Scope.Reset();
+			bCheckingAllocations = false;
+
+			if (NumAllocations == 0)
+			{
+				return;
+			}
+
+			UE_LOG(LogGameCore_Input, Error, TEXT("%s of %s made %llu heap allocation(s) while handling %s (%s) in steady state"),
+				EntryPoint, *GetPathNameSafe(Owner), NumAllocations, *InputTag.ToString(), *UEnum::GetValueAsString(TriggerEvent));
+
+			if (AssertNoAllocations >= 2)
+			{
+				UE_LOG(LogGameCore_Input, Fatal, TEXT("Heap allocation in the input dispatch path (GEInput.Dispatch.AssertNoAllocations=2)"));
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("Heap allocation in the input dispatch path, see the log for details"));
+			}
+		}
+
+	private:
+		TOptional<FInputAllocationScope> Scope;
+
+		const TCHAR* EntryPoint{ nullptr };
+		const UObject* Owner{ nullptr };
+		FGameplayTag InputTag;
+		ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+	};
+#endif
+}
+
+#if !UE_BUILD_SHIPPING
+#define GEINPUT_DISPATCH_ALLOCATION_CHECK(EntryPoint, InputTag, TriggerEvent) \
+	const GEInputDispatch::FAllocationCheckScope ANONYMOUS_VARIABLE(AllocationCheck)(TEXT(EntryPoint), this, (GFrameCounter - LastProcessorsChangedFrame > static_cast<uint64>(GEInputDispatch::SteadyStateFrames)), InputTag, TriggerEvent)
+#else
+#define GEINPUT_DISPATCH_ALLOCATION_CHECK(EntryPoint, InputTag, TriggerEvent)
+#endif
+
+
 const FName UInputProcessComponent::NAME_InputComponentReady("InputComponentReady");
 
 UInputProcessComponent::UInputProcessComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 
@@ -26,6 +160,9 @@ void UInputProcessComponent::OnRegister()
 
 void UInputProcessComponent::OnUnregister()
 {
+	StopInputRecording();
+	StopInputPlayback();
+
 	RemoveAllInputProcessors();
 
 	Super::OnUnregister();
@@ -33,14 +170,51 @@ void UInputProcessComponent::OnUnregister()
 
 void UInputProcessComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	StopInputRecording();
+	StopInputPlayback();
+
 	RemoveAllInputProcessors();
 
 	Super::EndPlay(EndPlayReason);
 }
 
+void UInputProcessComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (Player.IsValid())
+	{
+		TickInputPlayback();
+	}
+
+	if (!FixedRateProcessors.IsEmpty())
+	{
+		TickFixedRateProcessors(DeltaTime);
+	}
+
+	if (!DeferredWork.IsEmpty())
+	{
+		RunDeferredWork();
+
+		if (DeferredWork.IsEmpty())
+		{
+			UpdateComponentTickEnabled();
+		}
+	}
+}
+
+void UInputProcessComponent::UpdateComponentTickEnabled()
+{
+	SetComponentTickEnabled(Player.IsValid() || !FixedRateProcessors.IsEmpty() || !DeferredWork.IsEmpty());
+}
+
 
 void UInputProcessComponent::AddInputProcessor(TSubclassOf<UInputProcessor> InClass)
 {
+	GEINPUT_LLM_SCOPE();
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_AddInputProcessor);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_AddInputProcessor);
+
 	auto* Owner{ GetOwner() };
 	check(Owner);
 
@@ -60,14 +234,45 @@ void UInputProcessComponent::AddInputProcessor(TSubclassOf<UInputProcessor> InCl
 	
 	// Create new processor
 
+	const auto NumBindingsBefore{ GetActionEventBindings().Num() };
+
 	auto* NewProcessor{ NewObject<UInputProcessor>(Owner, InClass) };
 	NewProcessor->Initialize(this);
 
+	if (!NewProcessor->GetSubscribedInputTags().IsEmpty())
+	{
+		if (auto* Subsystem{ BindMappingSubsystem() })
+		{
+			NewProcessor->BindSubscribedInputActions(this, Subsystem->GetInputActionsByTag());
+		}
+	}
+
 	Processors.Emplace(InClass, NewProcessor);
+
+	// Simulations and streams are added first so that the routes resolve their indexes
+
+	AddFixedRateProcessor(NewProcessor);
+	AddFilterStreams(NewProcessor);
+	AddInputRoutes(NewProcessor);
+
+	LastProcessorsChangedFrame = GFrameCounter;
+
+	const auto NumBindingsAdded{ GetActionEventBindings().Num() - NumBindingsBefore };
+
+	GEInputStats::AddActiveProcessors(1);
+	GEInputStats::AddActiveBindings(NumBindingsAdded);
+
+	GEINPUT_TRACE_PROCESSOR_ADDED(this, InClass.Get(), NumBindingsAdded);
 }
 
 void UInputProcessComponent::RemoveAllInputProcessors()
 {
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_RemoveAllInputProcessors);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_RemoveAllInputProcessors);
+	GEINPUT_TRACE_PROCESSORS_REMOVED(this, Processors.Num());
+
+	const auto NumBindingsBefore{ GetActionEventBindings().Num() };
+
 	for (const auto& KVP : Processors)
 	{
 		if (auto Processor{ KVP.Value })
@@ -76,5 +281,1081 @@ void UInputProcessComponent::RemoveAllInputProcessors()
 		}
 	}
 
+	GEInputStats::AddActiveProcessors(-Processors.Num());
+	GEInputStats::AddActiveBindings(GetActionEventBindings().Num() - NumBindingsBefore);
+
 	Processors.Empty();
+	InputRoutes.Reset();
+	++InputRoutesSerial;
+	FixedRateProcessors.Reset();
+	DeferredWork.Reset();
+	FilterStreams.Reset();
+	PendingFilteredEvents.Reset();
+	NumFilteredEvents = 0;
+
+	if (auto* Subsystem{ FilterSubsystem.Get() })
+	{
+		Subsystem->UnregisterComponent(this);
+	}
+
+	FilterSubsystem.Reset();
+
+	UnbindMappingSubsystem();
+
+	LastProcessorsChangedFrame = GFrameCounter;
+
+	UpdateComponentTickEnabled();
+}
+
+
+APlayerController* UInputProcessComponent::GetOwningPlayerController() const
+{
+	auto* Owner{ GetOwner() };
+	auto* Pawn{ Cast<APawn>(Owner) };
+
+	return Pawn ? Cast<APlayerController>(Pawn->GetController()) : Cast<APlayerController>(Owner);
+}
+
+ULocalPlayer* UInputProcessComponent::GetOwningLocalPlayer() const
+{
+	auto* PlayerController{ GetOwningPlayerController() };
+
+	return PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+}
+
+
+// Subscriptions
+
+UInputMappingCompositeSubsystem* UInputProcessComponent::BindMappingSubsystem()
+{
+	auto* Subsystem{ MappingSubsystem.Get() };
+
+	if (!Subsystem)
+	{
+		auto* LocalPlayer{ GetOwningLocalPlayer() };
+
+		Subsystem = LocalPlayer ? LocalPlayer->GetSubsystem<UInputMappingCompositeSubsystem>() : nullptr;
+
+		if (Subsystem)
+		{
+			MappingSubsystem = Subsystem;
+			InputActionsByTagChangedHandle = Subsystem->OnInputActionsByTagChanged.AddUObject(this, &ThisClass::UpdateSubscribedInputActions);
+		}
+	}
+
+	return Subsystem;
+}
+
+void UInputProcessComponent::UnbindMappingSubsystem()
+{
+	if (auto* Subsystem{ MappingSubsystem.Get() })
+	{
+		Subsystem->OnInputActionsByTagChanged.Remove(InputActionsByTagChangedHandle);
+	}
+
+	MappingSubsystem.Reset();
+	InputActionsByTagChangedHandle.Reset();
+}
+
+void UInputProcessComponent::UpdateSubscribedInputActions(const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& InputActionsByTag)
+{
+	GEINPUT_LLM_SCOPE();
+
+	const auto NumBindingsBefore{ GetActionEventBindings().Num() };
+
+	auto bAnySubscriptions{ false };
+
+	for (const auto& KVP : Processors)
+	{
+		auto* Processor{ KVP.Value.Get() };
+
+		if (Processor && !Processor->GetSubscribedInputTags().IsEmpty())
+		{
+			Processor->BindSubscribedInputActions(this, InputActionsByTag);
+			bAnySubscriptions = true;
+		}
+	}
+
+	if (!bAnySubscriptions)
+	{
+		return;
+	}
+
+	GEInputStats::AddActiveBindings(GetActionEventBindings().Num() - NumBindingsBefore);
+
+	RebuildInputRoutes();
+
+	LastProcessorsChangedFrame = GFrameCounter;
+}
+
+
+// Intents
+
+UInputIntentBus* UInputProcessComponent::GetInputIntentBus()
+{
+	auto* Bus{ InputIntentBus.Get() };
+
+	if (!Bus)
+	{
+		auto* LocalPlayer{ GetOwningLocalPlayer() };
+
+		Bus = LocalPlayer ? LocalPlayer->GetSubsystem<UInputIntentBus>() : nullptr;
+		InputIntentBus = Bus;
+	}
+
+	return Bus;
+}
+
+
+// Dispatch
+
+void UInputProcessComponent::DispatchInputEvent(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	GEINPUT_LLM_SCOPE();
+	GEINPUT_DISPATCH_ALLOCATION_CHECK("DispatchInputEvent", InputTag, TriggerEvent);
+
+	check(Processor);
+
+	// Live events are ignored while playing back recorded events
+
+	if (Player.IsValid())
+	{
+		return;
+	}
+
+	const auto* Route{ InputRoutes.Find(InputTag) };
+	const auto DeviceFamily{ Route ? Route->DeviceFamily : EInputDeviceFamily::None };
+
+	const auto* BoundTarget{ Route ? Route->Bound.FindByPredicate([Processor](const FInputRouteTarget& Each) { return Each.Processor == Processor; }) : nullptr };
+	const auto Target{ BoundTarget ? *BoundTarget : MakeInputRouteTarget(Processor, 0, InputTag) };
+
+	// Every processor bound to the tag dispatches the event, only the first one bound for it records it and forwards it to the subscribers,
+	// so that each subscriber receives it once even if the source itself is filtered out
+
+	const auto bIsSource{ !Route || IsInputEventSource(*Route, Processor, static_cast<uint8>(TriggerEvent)) };
+
+	if (bIsSource && Recorder.IsValid())
+	{
+		Recorder->RecordEvent(GFrameCounter, FPlatformTime::Seconds(), InputTag, TriggerEvent, InputActionValue);
+	}
+
+	const auto RoutesSerial{ InputRoutesSerial };
+
+	DispatchToBoundProcessor(Target, TriggerEvent, InputTag, InputActionValue, DeviceFamily);
+
+	// Handlers may add processors, which invalidates the route
+
+	if (bIsSource && Route && (RoutesSerial == InputRoutesSerial))
+	{
+		ForwardToSubscribers(*Route, TriggerEvent, InputTag, InputActionValue);
+	}
+}
+
+void UInputProcessComponent::InjectInputEvent(ETriggerEvent TriggerEvent, FGameplayTag InputTag, const FInputActionValue& InputActionValue)
+{
+	GEINPUT_LLM_SCOPE();
+	GEINPUT_DISPATCH_ALLOCATION_CHECK("InjectInputEvent", InputTag, TriggerEvent);
+
+	const auto* Route{ InputRoutes.Find(InputTag) };
+
+	if (!Route)
+	{
+		return;
+	}
+
+	const auto RoutesSerial{ InputRoutesSerial };
+	const auto EventFlag{ static_cast<uint8>(TriggerEvent) };
+	const auto NumBound{ Route->Bound.Num() };
+	const auto NumTargets{ NumBound + Route->Subscribed.Num() };
+
+	for (int32 Index{ 0 }; (Index < NumTargets) && (RoutesSerial == InputRoutesSerial); ++Index)
+	{
+		const auto& Target{ (Index < NumBound) ? Route->Bound[Index] : Route->Subscribed[Index - NumBound] };
+
+		if ((Target.TriggerEvents & EventFlag) != 0)
+		{
+			RouteInputEvent(Target, TriggerEvent, InputTag, InputActionValue);
+		}
+	}
+}
+
+bool UInputProcessComponent::IsInputEventSource(const FInputRoute& Route, const UInputProcessor* Processor, uint8 EventFlag)
+{
+	const auto* Source{ Route.Bound.FindByPredicate([EventFlag](const FInputRouteTarget& Each) { return (Each.TriggerEvents & EventFlag) != 0; }) };
+
+	return !Source || (Source->Processor == Processor);
+}
+
+void UInputProcessComponent::DispatchToBoundProcessor(const FInputRouteTarget& Target, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue, EInputDeviceFamily DeviceFamily)
+{
+	const auto* Processor{ Target.Processor };
+
+	if (!PassesActiveDeviceFilter(Processor, TriggerEvent, DeviceFamily))
+	{
+		return;
+	}
+
+	if (auto* Replication{ InputReplication.Get() }; Replication && Processor->ShouldRunOnServer())
+	{
+		Replication->CaptureInputEvent(TriggerEvent, InputTag, InputActionValue);
+	}
+
+#if GEINPUT_LATENCY_ENABLED
+	if (FInputLatencyTracker::IsEnabled())
+	{
+		FInputLatencyTracker::NotifyHandler(GetOwner());
+	}
+#endif
+
+	RouteInputEvent(Target, TriggerEvent, InputTag, InputActionValue);
+}
+
+void UInputProcessComponent::ReplayInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	GEINPUT_DISPATCH_ALLOCATION_CHECK("ReplayInputEvent", InputTag, TriggerEvent);
+
+	const auto* Route{ InputRoutes.Find(InputTag) };
+
+	if (!Route)
+	{
+		return;
+	}
+
+	const auto RoutesSerial{ InputRoutesSerial };
+	const auto EventFlag{ static_cast<uint8>(TriggerEvent) };
+
+	for (int32 Index{ 0 }; (RoutesSerial == InputRoutesSerial) && (Index < Route->Bound.Num()); ++Index)
+	{
+		const auto& Target{ Route->Bound[Index] };
+
+		if ((Target.TriggerEvents & EventFlag) != 0)
+		{
+			DispatchToBoundProcessor(Target, TriggerEvent, InputTag, InputActionValue, Route->DeviceFamily);
+		}
+	}
+
+	if (RoutesSerial == InputRoutesSerial)
+	{
+		ForwardToSubscribers(*Route, TriggerEvent, InputTag, InputActionValue);
+	}
+}
+
+void UInputProcessComponent::ForwardToSubscribers(const FInputRoute& Route, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	const auto RoutesSerial{ InputRoutesSerial };
+	const auto EventFlag{ static_cast<uint8>(TriggerEvent) };
+
+	for (int32 Index{ 0 }; (RoutesSerial == InputRoutesSerial) && (Index < Route.Subscribed.Num()); ++Index)
+	{
+		const auto& Target{ Route.Subscribed[Index] };
+
+		if (((Target.TriggerEvents & EventFlag) != 0) && PassesActiveDeviceFilter(Target.Processor, TriggerEvent, Route.DeviceFamily))
+		{
+			RouteInputEvent(Target, TriggerEvent, InputTag, InputActionValue);
+		}
+	}
+}
+
+void UInputProcessComponent::AddInputRoutes(UInputProcessor* Processor)
+{
+	++InputRoutesSerial;
+
+	const auto TriggerEvents{ Processor->GetBoundTriggerEvents() };
+
+	for (const auto& KVP : Processor->GetInputActions())
+	{
+		if (KVP.Key.IsValid() && KVP.Value)
+		{
+			FindOrAddInputRoute(KVP.Key).Bound.Add(MakeInputRouteTarget(Processor, TriggerEvents, KVP.Key));
+		}
+	}
+
+	for (const auto& KVP : Processor->GetSubscribedInputActions())
+	{
+		if (KVP.Key.IsValid() && KVP.Value)
+		{
+			FindOrAddInputRoute(KVP.Key).Bound.Add(MakeInputRouteTarget(Processor, TriggerEvents, KVP.Key));
+		}
+	}
+
+	// Subscriptions are expanded to every registered child tag here so that dispatch never matches tags
+
+	const auto& TagsManager{ UGameplayTagsManager::Get() };
+
+	for (const auto& ParentTag : Processor->GetSubscribedInputTags())
+	{
+		auto SubscribedTags{ TagsManager.RequestGameplayTagChildren(ParentTag) };
+		SubscribedTags.AddTag(ParentTag);
+
+		for (const auto& InputTag : SubscribedTags)
+		{
+			auto& Route{ FindOrAddInputRoute(InputTag) };
+
+			const auto bAlreadyRouted
+			{
+				Route.Bound.ContainsByPredicate([Processor](const FInputRouteTarget& Each) { return Each.Processor == Processor; }) ||
+				Route.Subscribed.ContainsByPredicate([Processor](const FInputRouteTarget& Each) { return Each.Processor == Processor; })
+			};
+
+			if (!bAlreadyRouted)
+			{
+				Route.Subscribed.Add(MakeInputRouteTarget(Processor, TriggerEvents, InputTag));
+			}
+		}
+	}
+}
+
+void UInputProcessComponent::RebuildInputRoutes()
+{
+	InputRoutes.Reset();
+	++InputRoutesSerial;
+
+	for (const auto& KVP : Processors)
+	{
+		if (auto* Processor{ KVP.Value.Get() })
+		{
+			AddInputRoutes(Processor);
+		}
+	}
+}
+
+UInputProcessComponent::FInputRoute& UInputProcessComponent::FindOrAddInputRoute(const FGameplayTag& InputTag)
+{
+	if (auto* Route{ InputRoutes.Find(InputTag) })
+	{
+		return *Route;
+	}
+
+	auto& NewRoute{ InputRoutes.Add(InputTag) };
+	NewRoute.DeviceFamily = GetInputDeviceFamilyForTag(InputTag);
+
+	return NewRoute;
+}
+
+UInputProcessComponent::FInputRouteTarget UInputProcessComponent::MakeInputRouteTarget(UInputProcessor* Processor, uint8 TriggerEvents, const FGameplayTag& InputTag) const
+{
+	FInputRouteTarget NewTarget;
+	NewTarget.Processor = Processor;
+	NewTarget.TriggerEvents = TriggerEvents;
+	NewTarget.FilterStreamIndex = FilterStreams.IndexOfByPredicate([Processor, &InputTag](const FFilterStream& Each) { return (Each.Processor == Processor) && (Each.InputTag == InputTag); });
+	NewTarget.FixedRateIndex = FindFixedRateProcessor(Processor);
+
+	return NewTarget;
+}
+
+bool UInputProcessComponent::PassesActiveDeviceFilter(const UInputProcessor* Processor, ETriggerEvent TriggerEvent, EInputDeviceFamily DeviceFamily)
+{
+	// Releases always pass so that processors never keep input of the previous device held
+
+	if ((DeviceFamily == EInputDeviceFamily::None) || !Processor->ShouldDispatchActiveDeviceOnly() || (TriggerEvent == ETriggerEvent::Completed) || (TriggerEvent == ETriggerEvent::Canceled))
+	{
+		return true;
+	}
+
+	auto* Subsystem{ ActiveDeviceSubsystem.Get() };
+
+	if (!Subsystem)
+	{
+		auto* LocalPlayer{ GetOwningLocalPlayer() };
+
+		Subsystem = LocalPlayer ? LocalPlayer->GetSubsystem<UActiveInputDeviceSubsystem>() : nullptr;
+		ActiveDeviceSubsystem = Subsystem;
+	}
+
+	const auto ActiveDeviceFamily{ Subsystem ? Subsystem->GetActiveDeviceFamily() : EInputDeviceFamily::None };
+
+	return (ActiveDeviceFamily == EInputDeviceFamily::None) || (ActiveDeviceFamily == DeviceFamily);
+}
+
+void UInputProcessComponent::RouteInputEvent(const FInputRouteTarget& Target, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	if (Target.FilterStreamIndex != INDEX_NONE)
+	{
+		QueueFilteredEvent(Target.FilterStreamIndex, TriggerEvent, InputActionValue);
+		return;
+	}
+
+	RouteFilteredInputEvent(Target.Processor, Target.FixedRateIndex, TriggerEvent, InputTag, InputActionValue);
+}
+
+void UInputProcessComponent::RouteFilteredInputEvent(UInputProcessor* Processor, int32 FixedRateIndex, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	if (FixedRateIndex != INDEX_NONE)
+	{
+		QueueFixedRateEvent(FixedRateProcessors[FixedRateIndex], TriggerEvent, InputTag, InputActionValue);
+		return;
+	}
+
+	DeliverInputEvent(Processor, TriggerEvent, InputTag, InputActionValue);
+}
+
+void UInputProcessComponent::DeliverInputEvent(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	if (InputHistory.Num() > 0)
+	{
+		RecordInputHistory(Processor, TriggerEvent, InputTag, InputActionValue);
+	}
+
+	Processor->ProcessInputEvent(TriggerEvent, InputTag, InputActionValue);
+}
+
+
+// Fixed Rate Simulation
+
+void UInputProcessComponent::AddFixedRateProcessor(UInputProcessor* Processor)
+{
+	const auto Rate{ Processor->GetFixedSimulationRate() };
+
+	if (Rate <= 0.0f)
+	{
+		return;
+	}
+
+	auto& NewEntry{ FixedRateProcessors.AddDefaulted_GetRef() };
+	NewEntry.Processor = Processor;
+	NewEntry.StepSeconds = 1.0 / Rate;
+	// Presized for Triggered and Ongoing of every bound tag so that queueing does not allocate while dispatching
+
+	const auto NumTags{ Processor->GetInputActions().Num() + Processor->GetSubscribedInputActions().Num() };
+
+	NewEntry.Inputs.Reserve(NumTags * 2);
+	NewEntry.Events.Reserve(FMath::Max(NumTags, 1) * GEInputDispatch::NumPresizedEventsPerTag);
+
+	// Steps must run after the controller processed the input of the frame
+
+	auto* PlayerController{ GetOwningPlayerController() };
+
+	if (PlayerController && (PlayerController != GetOwner()))
+	{
+		PrimaryComponentTick.AddPrerequisite(PlayerController, PlayerController->PrimaryActorTick);
+	}
+
+	UpdateComponentTickEnabled();
+}
+
+int32 UInputProcessComponent::FindFixedRateProcessor(const UInputProcessor* Processor) const
+{
+	return FixedRateProcessors.IndexOfByPredicate([Processor](const FFixedRateProcessor& Each) { return Each.Processor == Processor; });
+}
+
+void UInputProcessComponent::QueueFixedRateEvent(FFixedRateProcessor& FixedRate, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	// Discrete events are delivered once on the next step
+
+	if ((TriggerEvent != ETriggerEvent::Triggered) && (TriggerEvent != ETriggerEvent::Ongoing))
+	{
+		FixedRate.Events.Add({ InputTag, TriggerEvent, InputActionValue });
+		return;
+	}
+
+	auto* Input{ FixedRate.Inputs.FindByPredicate([&InputTag, TriggerEvent](const FFixedRateInput& Each) { return (Each.InputTag == InputTag) && (Each.TriggerEvent == TriggerEvent); }) };
+
+	if (!Input)
+	{
+		Input = &FixedRate.Inputs.AddDefaulted_GetRef();
+		Input->InputTag = InputTag;
+		Input->TriggerEvent = TriggerEvent;
+		Input->bAccumulate = FixedRate.Processor->ShouldAccumulateInput(InputTag);
+	}
+
+	// Deltas (e.g. mouse) are summed until the next step, other values hold the latest value
+
+	Input->Value = (Input->bAccumulate && Input->bPending) ? (Input->Value + InputActionValue) : InputActionValue;
+	Input->bPending = true;
+	Input->LastReceivedFrame = GFrameCounter;
+}
+
+void UInputProcessComponent::TickFixedRateProcessors(float DeltaTime)
+{
+	GEINPUT_DISPATCH_ALLOCATION_CHECK("TickFixedRateProcessors", FGameplayTag::EmptyTag, ETriggerEvent::None);
+
+	for (auto& FixedRate : FixedRateProcessors)
+	{
+		FixedRate.Accumulator += DeltaTime;
+
+		auto NumSteps{ 0 };
+
+		while ((FixedRate.Accumulator >= FixedRate.StepSeconds) && (NumSteps < GEInputDispatch::MaxSimulationStepsPerFrame))
+		{
+			FixedRate.Accumulator -= FixedRate.StepSeconds;
+			++NumSteps;
+
+			StepFixedRateProcessor(FixedRate);
+		}
+
+		// Drop the time that could not be simulated instead of spiraling
+
+		if (NumSteps >= GEInputDispatch::MaxSimulationStepsPerFrame)
+		{
+			FixedRate.Accumulator = FMath::Fmod(FixedRate.Accumulator, FixedRate.StepSeconds);
+		}
+	}
+}
+
+void UInputProcessComponent::StepFixedRateProcessor(FFixedRateProcessor& FixedRate)
+{
+	auto* Processor{ FixedRate.Processor };
+
+	// Started first, then continuous input, then Canceled/Completed so that releases end the step
+
+	for (const auto& Event : FixedRate.Events)
+	{
+		if (Event.TriggerEvent == ETriggerEvent::Started)
+		{
+			DeliverInputEvent(Processor, Event.TriggerEvent, Event.InputTag, Event.Value);
+		}
+	}
+
+	for (auto& Input : FixedRate.Inputs)
+	{
+		if (Input.bAccumulate)
+		{
+			if (Input.bPending)
+			{
+				DeliverInputEvent(Processor, Input.TriggerEvent, Input.InputTag, Input.Value);
+			}
+		}
+
+		// Held values repeat on every step of a frame that received them and stop when the input stops
+
+		else if (Input.bPending || (Input.LastReceivedFrame == GFrameCounter))
+		{
+			DeliverInputEvent(Processor, Input.TriggerEvent, Input.InputTag, Input.Value);
+		}
+
+		Input.bPending = false;
+	}
+
+	for (const auto& Event : FixedRate.Events)
+	{
+		if (Event.TriggerEvent != ETriggerEvent::Started)
+		{
+			DeliverInputEvent(Processor, Event.TriggerEvent, Event.InputTag, Event.Value);
+		}
+	}
+
+	FixedRate.Events.Reset();
+}
+
+
+// Deferred Work
+
+void UInputProcessComponent::ScheduleDeferredWork(UInputProcessor* Processor, int32 WorkId, int32 Priority)
+{
+	GEINPUT_LLM_SCOPE();
+
+	check(Processor);
+
+	const auto bAlreadyQueued
+	{
+		DeferredWork.ContainsByPredicate([Processor, WorkId](const FDeferredWork& Each) { return (Each.Processor == Processor) && (Each.WorkId == WorkId); })
+	};
+
+	if (bAlreadyQueued)
+	{
+		return;
+	}
+
+	auto& NewWork{ DeferredWork.AddDefaulted_GetRef() };
+	NewWork.Processor = Processor;
+	NewWork.WorkId = WorkId;
+	NewWork.Priority = Priority;
+	NewWork.ScheduledFrame = GFrameCounter;
+
+	if (DeferredWork.Num() == 1)
+	{
+		UpdateComponentTickEnabled();
+	}
+}
+
+void UInputProcessComponent::RunDeferredWork()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_RunDeferredWork);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_RunDeferredWork);
+
+	const auto Frame{ GFrameCounter };
+
+	// Aging keeps low priority work from starving behind a steady stream of high priority work
+
+	DeferredWork.StableSort(
+		[Frame](const FDeferredWork& A, const FDeferredWork& B)
+		{
+			return (A.Priority + static_cast<int64>(Frame - A.ScheduledFrame)) > (B.Priority + static_cast<int64>(Frame - B.ScheduledFrame));
+		});
+
+	const auto StartTime{ FPlatformTime::Seconds() };
+	const auto BudgetSeconds{ DeferredWorkBudgetMs * 0.001 };
+
+	// Work scheduled by the running work is appended and waits for the next frame.
+	// The queue is emptied if the work removes the processors.
+
+	const auto NumWork{ DeferredWork.Num() };
+	auto NumRun{ 0 };
+
+	for (int32 Index{ 0 }; (Index < NumWork) && (Index < DeferredWork.Num()); ++Index)
+	{
+		const auto Work{ DeferredWork[Index] };
+
+		if (!Work.Processor)
+		{
+			continue;
+		}
+
+		// At least one work runs per frame, and work waiting too long runs regardless of the budget
+
+		const auto bStarving{ (Frame - Work.ScheduledFrame) >= static_cast<uint64>(DeferredWorkMaxWaitFrames) };
+
+		if ((NumRun > 0) && !bStarving && ((FPlatformTime::Seconds() - StartTime) >= BudgetSeconds))
+		{
+			continue;
+		}
+
+		DeferredWork[Index].Processor = nullptr;
+		++NumRun;
+
+		Work.Processor->ExecuteDeferredWork(Work.WorkId);
+	}
+
+	DeferredWork.RemoveAll([](const FDeferredWork& Each) { return Each.Processor == nullptr; });
+
+	GEInputStats::RecordDeferredWork(NumRun, DeferredWork.Num());
+}
+
+
+// Filters
+
+void UInputProcessComponent::AddFilterStreams(UInputProcessor* Processor)
+{
+	for (const auto& KVP : Processor->GetInputFilters())
+	{
+		if (!KVP.Key.IsValid() || KVP.Value.IsEmpty())
+		{
+			continue;
+		}
+
+		auto& NewStream{ FilterStreams.AddDefaulted_GetRef() };
+		NewStream.Processor = Processor;
+		NewStream.FixedRateIndex = FindFixedRateProcessor(Processor);
+		NewStream.InputTag = KVP.Key;
+		NewStream.Filters = &KVP.Value;
+		NewStream.States.SetNum(KVP.Value.Num());
+	}
+
+	// Presized so that the queue does not grow while dispatching, it keeps its allocation between frames
+
+	PendingFilteredEvents.Reserve(FilterStreams.Num() * GEInputDispatch::NumPresizedEventsPerTag);
+
+	if (FilterStreams.IsEmpty() || FilterSubsystem.IsValid())
+	{
+		return;
+	}
+
+	if (auto* Subsystem{ UWorld::GetSubsystem<UInputFilterSubsystem>(GetWorld()) })
+	{
+		Subsystem->RegisterComponent(this);
+		FilterSubsystem = Subsystem;
+	}
+}
+
+void UInputProcessComponent::QueueFilteredEvent(int32 StreamIndex, ETriggerEvent TriggerEvent, const FInputActionValue& InputActionValue)
+{
+	GEINPUT_LLM_SCOPE();
+
+	auto& Stream{ FilterStreams[StreamIndex] };
+
+	const auto* World{ GetWorld() };
+	const auto Now{ World ? World->GetTimeSeconds() : FPlatformTime::Seconds() };
+
+	auto& NewEvent{ PendingFilteredEvents.AddDefaulted_GetRef() };
+	NewEvent.StreamIndex = StreamIndex;
+	NewEvent.TriggerEvent = TriggerEvent;
+	NewEvent.Value = InputActionValue;
+	NewEvent.DeltaSeconds = (Stream.LastEventTime < 0.0) ? 0.0f : static_cast<float>(Now - Stream.LastEventTime);
+
+	// Releases restart the stream for the next press
+
+	const auto bRelease{ (TriggerEvent == ETriggerEvent::Completed) || (TriggerEvent == ETriggerEvent::Canceled) };
+	Stream.LastEventTime = bRelease ? -1.0 : Now;
+
+	// Without a running filter stage the event is filtered and dispatched immediately
+
+	auto* Subsystem{ FilterSubsystem.Get() };
+
+	if (!Subsystem || !Subsystem->IsRunning())
+	{
+		ApplyInputFilters();
+
+		if (!bFlushingFilteredEvents)
+		{
+			FlushFilteredEvents();
+		}
+	}
+}
+
+void UInputProcessComponent::ApplyInputFilters()
+{
+	for (; NumFilteredEvents < PendingFilteredEvents.Num(); ++NumFilteredEvents)
+	{
+		auto& Event{ PendingFilteredEvents[NumFilteredEvents] };
+		auto& Stream{ FilterStreams[Event.StreamIndex] };
+
+		// Releases pass unfiltered and restart the filters for the next press
+
+		if ((Event.TriggerEvent == ETriggerEvent::Completed) || (Event.TriggerEvent == ETriggerEvent::Canceled))
+		{
+			for (auto& State : Stream.States)
+			{
+				State.Reset();
+			}
+
+			continue;
+		}
+
+		auto Value{ Event.Value.Get<FVector>() };
+
+		for (int32 Index{ 0 }; Index < Stream.States.Num(); ++Index)
+		{
+			Value = (*Stream.Filters)[Index]->Apply(Value, Event.DeltaSeconds, Stream.States[Index]);
+		}
+
+		Event.Value = FInputActionValue(Event.Value.GetValueType(), Value);
+	}
+}
+
+void UInputProcessComponent::FlushFilteredEvents()
+{
+	GEINPUT_DISPATCH_ALLOCATION_CHECK("FlushFilteredEvents", FGameplayTag::EmptyTag, ETriggerEvent::None);
+
+	TGuardValue<bool> FlushingGuard(bFlushingFilteredEvents, true);
+
+	// Processors may queue further events or remove all processors while handling these.
+	// Events they queue are delivered in this flush only if they were filtered immediately.
+
+	int32 NumFlushed{ 0 };
+
+	for (; (NumFlushed < NumFilteredEvents) && (NumFlushed < PendingFilteredEvents.Num()); ++NumFlushed)
+	{
+		const auto Event{ PendingFilteredEvents[NumFlushed] };
+		const auto& Stream{ FilterStreams[Event.StreamIndex] };
+
+		RouteFilteredInputEvent(Stream.Processor, Stream.FixedRateIndex, Event.TriggerEvent, Stream.InputTag, Event.Value);
+	}
+
+	NumFlushed = FMath::Min(NumFlushed, PendingFilteredEvents.Num());
+
+	// Reset keeps the allocation for the next frame, removing only part of the queue is rare
+
+	if (NumFlushed == PendingFilteredEvents.Num())
+	{
+		PendingFilteredEvents.Reset();
+	}
+	else
+	{
+		PendingFilteredEvents.RemoveAt(0, NumFlushed);
+	}
+
+	NumFilteredEvents = FMath::Max(NumFilteredEvents - NumFlushed, 0);
+}
+
+
+// Snapshots
+
+void UInputProcessComponent::InitializeSnapshots(int32 NumFrames, int32 MaxHistoryEvents)
+{
+	GEINPUT_LLM_SCOPE();
+
+	SnapshotFrames.Init(MAX_uint32, FMath::Max(NumFrames, 1));
+	InputHistory.SetNum(FMath::Max(MaxHistoryEvents, 1));
+	InputHistoryHead = 0;
+	InputHistoryNum = 0;
+
+	// Force the layout and the buffer to be rebuilt for the new ring size
+
+	SnapshotLayoutFrame = MAX_uint64;
+	UpdateSnapshotLayout();
+}
+
+void UInputProcessComponent::UpdateSnapshotLayout()
+{
+	if (SnapshotLayoutFrame == LastProcessorsChangedFrame)
+	{
+		return;
+	}
+
+	GEINPUT_LLM_SCOPE();
+
+	SnapshotLayoutFrame = LastProcessorsChangedFrame;
+
+	SnapshotLayout.Reset();
+	SnapshotStride = 0;
+
+	for (const auto& KVP : Processors)
+	{
+		if (auto* Processor{ KVP.Value.Get() })
+		{
+			if (const auto View{ Processor->GetStateView() }; View.IsValid())
+			{
+				SnapshotLayout.Add({ Processor, SnapshotStride, View.Size });
+				SnapshotStride += Align(View.Size, 16);
+			}
+		}
+	}
+
+	// Snapshots and history of the previous processors can not be restored anymore
+
+	SnapshotBuffer.SetNumZeroed(SnapshotStride * SnapshotFrames.Num());
+
+	for (auto& Frame : SnapshotFrames)
+	{
+		Frame = MAX_uint32;
+	}
+
+	InputHistoryHead = 0;
+	InputHistoryNum = 0;
+}
+
+bool UInputProcessComponent::SaveSnapshot(uint32 Frame)
+{
+	if (SnapshotFrames.IsEmpty())
+	{
+		return false;
+	}
+
+	UpdateSnapshotLayout();
+	WriteSnapshot(Frame);
+
+	CurrentSnapshotFrame = Frame;
+
+	return true;
+}
+
+void UInputProcessComponent::WriteSnapshot(uint32 Frame)
+{
+	const auto SlotIndex{ static_cast<int32>(Frame % static_cast<uint32>(SnapshotFrames.Num())) };
+	auto* SlotData{ SnapshotBuffer.GetData() + (SlotIndex * SnapshotStride) };
+
+	for (const auto& Entry : SnapshotLayout)
+	{
+		const auto View{ Entry.Processor->GetStateView() };
+		check(View.Size == Entry.Size);
+
+		FMemory::Memcpy(SlotData + Entry.Offset, View.Data, Entry.Size);
+	}
+
+	SnapshotFrames[SlotIndex] = Frame;
+}
+
+bool UInputProcessComponent::RestoreSnapshot(uint32 Frame)
+{
+	UpdateSnapshotLayout();
+
+	if (!HasSnapshot(Frame))
+	{
+		return false;
+	}
+
+	const auto SlotIndex{ static_cast<int32>(Frame % static_cast<uint32>(SnapshotFrames.Num())) };
+	const auto* SlotData{ SnapshotBuffer.GetData() + (SlotIndex * SnapshotStride) };
+
+	for (const auto& Entry : SnapshotLayout)
+	{
+		const auto View{ Entry.Processor->GetStateView() };
+		check(View.Size == Entry.Size);
+
+		FMemory::Memcpy(View.Data, SlotData + Entry.Offset, Entry.Size);
+	}
+
+	for (const auto& Entry : SnapshotLayout)
+	{
+		Entry.Processor->PostRestoreState();
+	}
+
+	return true;
+}
+
+bool UInputProcessComponent::HasSnapshot(uint32 Frame) const
+{
+	return !SnapshotFrames.IsEmpty() && (SnapshotFrames[Frame % static_cast<uint32>(SnapshotFrames.Num())] == Frame);
+}
+
+void UInputProcessComponent::RecordInputHistory(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	if (bResimulating || (SnapshotLayoutFrame != LastProcessorsChangedFrame))
+	{
+		return;
+	}
+
+	auto& Event{ InputHistory[InputHistoryHead] };
+	Event.Frame = CurrentSnapshotFrame;
+	Event.Processor = Processor;
+	Event.TriggerEvent = TriggerEvent;
+	Event.InputTag = InputTag;
+	Event.Value = InputActionValue;
+
+	InputHistoryHead = (InputHistoryHead + 1) % InputHistory.Num();
+	InputHistoryNum = FMath::Min(InputHistoryNum + 1, InputHistory.Num());
+}
+
+bool UInputProcessComponent::ResimulateFrom(uint32 Frame)
+{
+	const auto Capacity{ InputHistory.Num() };
+	const auto FirstIndex{ (InputHistoryHead - InputHistoryNum + Capacity) % FMath::Max(Capacity, 1) };
+
+	// Events of the frame may have been overwritten if the history is full
+
+	if ((InputHistoryNum == Capacity) && (Capacity > 0) && (InputHistory[FirstIndex].Frame >= Frame))
+	{
+		return false;
+	}
+
+	if (!RestoreSnapshot(Frame))
+	{
+		return false;
+	}
+
+	TGuardValue<bool> ResimulatingGuard(bResimulating, true);
+
+	const auto NumFrames{ static_cast<uint32>(SnapshotFrames.Num()) };
+	auto SimulatedFrame{ Frame };
+
+	const auto AdvanceTo{ [this, &SimulatedFrame, NumFrames](uint32 TargetFrame)
+		{
+			// Save the corrected state at the start of every replayed frame that still has a snapshot
+
+			for (auto Each{ FMath::Max(SimulatedFrame + 1, (TargetFrame >= NumFrames) ? (TargetFrame - NumFrames + 1) : 0u) }; Each <= TargetFrame; ++Each)
+			{
+				if (HasSnapshot(Each))
+				{
+					WriteSnapshot(Each);
+				}
+			}
+
+			SimulatedFrame = TargetFrame;
+		} };
+
+	for (int32 Offset{ 0 }; Offset < InputHistoryNum; ++Offset)
+	{
+		const auto& Event{ InputHistory[(FirstIndex + Offset) % Capacity] };
+
+		if (Event.Frame < Frame)
+		{
+			continue;
+		}
+
+		if (Event.Frame > SimulatedFrame)
+		{
+			AdvanceTo(Event.Frame);
+		}
+
+		Event.Processor->ProcessInputEvent(Event.TriggerEvent, Event.InputTag, Event.Value);
+	}
+
+	if (CurrentSnapshotFrame > SimulatedFrame)
+	{
+		AdvanceTo(CurrentSnapshotFrame);
+	}
+
+	return true;
+}
+
+
+// Recording
+
+bool UInputProcessComponent::StartInputRecording(const FString& Filename)
+{
+	GEINPUT_LLM_SCOPE();
+
+	StopInputRecording();
+
+	auto NewRecorder{ MakeShared<FInputRecorder>() };
+
+	if (NewRecorder->Open(Filename))
+	{
+		NewRecorder->ReserveTags(InputRoutes.Num());
+
+		Recorder = MoveTemp(NewRecorder);
+		return true;
+	}
+
+	return false;
+}
+
+void UInputProcessComponent::StopInputRecording()
+{
+	if (Recorder.IsValid())
+	{
+		Recorder->Close();
+		Recorder.Reset();
+	}
+}
+
+bool UInputProcessComponent::IsRecordingInput() const
+{
+	return Recorder.IsValid();
+}
+
+bool UInputProcessComponent::StartInputPlayback(const FString& Filename)
+{
+	GEINPUT_LLM_SCOPE();
+
+	StopInputPlayback();
+
+	auto NewPlayer{ MakeShared<FInputPlayer>() };
+
+	if (NewPlayer->Open(Filename))
+	{
+		Player = MoveTemp(NewPlayer);
+		PendingPlaybackEvent = MakeShared<FInputRecordEvent>();
+		PlaybackStartFrame = GFrameCounter;
+
+		if (!Player->ReadNextEvent(*PendingPlaybackEvent))
+		{
+			StopInputPlayback();
+			return false;
+		}
+
+		UpdateComponentTickEnabled();
+		return true;
+	}
+
+	return false;
+}
+
+void UInputProcessComponent::StopInputPlayback()
+{
+	if (Player.IsValid())
+	{
+		Player->Close();
+		Player.Reset();
+		PendingPlaybackEvent.Reset();
+
+		UpdateComponentTickEnabled();
+	}
+}
+
+bool UInputProcessComponent::IsPlayingBackInput() const
+{
+	return Player.IsValid();
+}
+
+void UInputProcessComponent::TickInputPlayback()
+{
+	GEINPUT_LLM_SCOPE();
+
+	check(Player.IsValid() && PendingPlaybackEvent.IsValid());
+
+	const auto PlaybackFrame{ static_cast<uint32>(GFrameCounter - PlaybackStartFrame) };
+
+	// Dispatch all events recorded up to the current frame, live events are ignored meanwhile
+
+	while (PendingPlaybackEvent->Frame <= PlaybackFrame)
+	{
+		ReplayInputEvent(PendingPlaybackEvent->TriggerEvent, PendingPlaybackEvent->InputTag, PendingPlaybackEvent->Value);
+
+		if (!Player.IsValid() || !Player->ReadNextEvent(*PendingPlaybackEvent))
+		{
+			StopInputPlayback();
+			break;
+		}
+	}
 }
@@ -6,15 +6,30 @@
 
 #include "GameplayTagContainer.h"
 
+#include "Device/InputDeviceTypes.h"
+
 #include "InputProcessComponent.generated.h"
 
 class UInputProcessor;
+class UInputReplicationComponent;
+class UActiveInputDeviceSubsystem;
+class UInputIntentBus;
+class UInputFilterSubsystem;
+class UInputMappingCompositeSubsystem;
+class UInputAction;
+class FInputFilter;
+struct FInputFilterState;
+class ULocalPlayer;
+class APlayerController;
+class FInputRecorder;
+class FInputPlayer;
+struct FInputRecordEvent;
 
 
 /**
  * EnhancedInputComponent with additional InputProcessor functionality
  */
-UCLASS(Config = Input)
+UCLASS(MinimalAPI, Config = Input)
 class UInputProcessComponent : public UEnhancedInputComponent
 {
 	GENERATED_BODY()
@@ -30,11 +45,23 @@ public:
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	/**
+	 * Ticks only while playing back or running fixed rate processors
+	 */
+	void UpdateComponentTickEnabled();
 
 protected:
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Processors")
 	TMap<TSubclassOf<UInputProcessor>, TObjectPtr<UInputProcessor>> Processors;
 
+	//
+	// Frame on which a processor was last added or removed, dispatch is considered steady state some frames after it
+	//
+	uint64 LastProcessorsChangedFrame{ 0 };
+
 public:
 	UFUNCTION(BlueprintCallable, Category = "Processors")
 	void AddInputProcessor(TSubclassOf<UInputProcessor> InClass);
@@ -42,4 +69,469 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Processors")
 	void RemoveAllInputProcessors();
 
+	const TMap<TSubclassOf<UInputProcessor>, TObjectPtr<UInputProcessor>>& GetInputProcessors() const { return Processors; }
+
+	uint64 GetLastProcessorsChangedFrame() const { return LastProcessorsChangedFrame; }
+
+	/**
+	 * Returns the player controller that owns or controls the owner
+	 */
+	APlayerController* GetOwningPlayerController() const;
+
+	/**
+	 * Returns the local player controlling the owner, null on the server and for AI
+	 */
+	ULocalPlayer* GetOwningLocalPlayer() const;
+
+
+	////////////////////////////////////////////////////////////
+	// Subscriptions
+protected:
+	//
+	// Mapping subsystem of the owning local player that provides the input actions of subscribed child tags
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UInputMappingCompositeSubsystem> MappingSubsystem;
+
+	FDelegateHandle InputActionsByTagChangedHandle;
+
+protected:
+	/**
+	 * Resolves the mapping subsystem of the owning local player and listens for changes of its input actions, null on the server and for AI
+	 */
+	UInputMappingCompositeSubsystem* BindMappingSubsystem();
+
+	void UnbindMappingSubsystem();
+
+public:
+	/**
+	 * Binds the input actions of the child tags subscribed to by the processors and rebuilds the routing table
+	 */
+	void UpdateSubscribedInputActions(const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& InputActionsByTag);
+
+
+	////////////////////////////////////////////////////////////
+	// Intents
+protected:
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UInputIntentBus> InputIntentBus;
+
+public:
+	/**
+	 * Returns the intent bus of the owning local player, resolved on first use
+	 */
+	UInputIntentBus* GetInputIntentBus();
+
+
+	////////////////////////////////////////////////////////////
+	// Dispatch
+public:
+	/**
+	 * Entry point of every input event that reaches the processors
+	 */
+	void DispatchInputEvent(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Delivers an event to all processors that bind the input tag with the trigger event, as if it came from EnhancedInput.
+	 * Unlike DispatchInputEvent, the event skips the device filter, recording, replication capture and latency stamping.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Processors")
+	void InjectInputEvent(ETriggerEvent TriggerEvent, FGameplayTag InputTag, const FInputActionValue& InputActionValue);
+
+protected:
+	struct FInputRouteTarget
+	{
+		UInputProcessor* Processor{ nullptr };
+		uint8 TriggerEvents{ 0 };
+
+		//
+		// Filter stream of the processor for the tag, resolved when the route is built so that dispatch never searches the streams
+		//
+		int32 FilterStreamIndex{ INDEX_NONE };
+
+		//
+		// Fixed rate simulation of the processor, events are queued for its next step
+		//
+		int32 FixedRateIndex{ INDEX_NONE };
+	};
+
+	//
+	// Processors that receive the events of an input tag
+	//
+	struct FInputRoute
+	{
+		EInputDeviceFamily DeviceFamily{ EInputDeviceFamily::None };
+
+		//
+		// Processors that bind the tag to an input action, the first one bound for an event forwards it to the subscribers
+		//
+		TArray<FInputRouteTarget, TInlineAllocator<2>> Bound;
+
+		//
+		// Processors that receive the tag through a subscription to one of its parent tags
+		//
+		TArray<FInputRouteTarget, TInlineAllocator<2>> Subscribed;
+	};
+
+	//
+	// Routing table of every tag bound by or subscribed to by the processors, updated when processors are added
+	//
+	TMap<FGameplayTag, FInputRoute> InputRoutes;
+
+	//
+	// Incremented whenever the routing table changes, references into it are invalid afterwards
+	//
+	uint32 InputRoutesSerial{ 0 };
+
+	//
+	// Active device tracker of the owning local player, resolved on first use
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UActiveInputDeviceSubsystem> ActiveDeviceSubsystem;
+
+protected:
+	/**
+	 * Adds the tags bound by the processor and the registered child tags of its subscriptions to the routing table
+	 */
+	void AddInputRoutes(UInputProcessor* Processor);
+
+	/**
+	 * Rebuilds the routing table from all processors
+	 */
+	void RebuildInputRoutes();
+
+	FInputRoute& FindOrAddInputRoute(const FGameplayTag& InputTag);
+
+	/**
+	 * Returns the route target of the processor for the tag with the indexes of its filter stream and fixed rate simulation
+	 */
+	FInputRouteTarget MakeInputRouteTarget(UInputProcessor* Processor, uint8 TriggerEvents, const FGameplayTag& InputTag) const;
+
+	/**
+	 * Returns true if the processor is the first one bound for the event, which records it and forwards it to the subscribers
+	 */
+	static bool IsInputEventSource(const FInputRoute& Route, const UInputProcessor* Processor, uint8 EventFlag);
+
+	/**
+	 * Applies the device filter of a bound processor, captures the event for replication and routes it
+	 */
+	void DispatchToBoundProcessor(const FInputRouteTarget& Target, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue, EInputDeviceFamily DeviceFamily);
+
+	/**
+	 * Dispatches a recorded event to every bound processor and subscriber through the same stages as a live event, without recording it again
+	 */
+	void ReplayInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Routes the event to every subscriber of the route that passes its own device filter
+	 */
+	void ForwardToSubscribers(const FInputRoute& Route, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Returns false if the event belongs to a device family the player is not using
+	 */
+	bool PassesActiveDeviceFilter(const UInputProcessor* Processor, ETriggerEvent TriggerEvent, EInputDeviceFamily DeviceFamily);
+
+	/**
+	 * Queues the event for the filter stage if the processor filters the input tag, otherwise routes it to simulation
+	 */
+	void RouteInputEvent(const FInputRouteTarget& Target, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Queues the event for fixed rate processors, otherwise delivers it immediately
+	 */
+	void RouteFilteredInputEvent(UInputProcessor* Processor, int32 FixedRateIndex, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Passes the event to the processor
+	 */
+	void DeliverInputEvent(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+
+	////////////////////////////////////////////////////////////
+	// Fixed Rate Simulation
+protected:
+	//
+	// Triggered or Ongoing input resampled at the simulation rate
+	//
+	struct FFixedRateInput
+	{
+		FGameplayTag InputTag;
+		ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+		FInputActionValue Value;
+		uint64 LastReceivedFrame{ 0 };
+		bool bAccumulate{ false };
+		bool bPending{ false };
+	};
+
+	//
+	// Started, Canceled or Completed event delivered once on the next step
+	//
+	struct FFixedRateEvent
+	{
+		FGameplayTag InputTag;
+		ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+		FInputActionValue Value;
+	};
+
+	struct FFixedRateProcessor
+	{
+		UInputProcessor* Processor{ nullptr };
+		double StepSeconds{ 0.0 };
+		double Accumulator{ 0.0 };
+		TArray<FFixedRateInput> Inputs;
+		TArray<FFixedRateEvent> Events;
+	};
+
+	TArray<FFixedRateProcessor> FixedRateProcessors;
+
+protected:
+	void AddFixedRateProcessor(UInputProcessor* Processor);
+	int32 FindFixedRateProcessor(const UInputProcessor* Processor) const;
+	void QueueFixedRateEvent(FFixedRateProcessor& FixedRate, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+	void TickFixedRateProcessors(float DeltaTime);
+	void StepFixedRateProcessor(FFixedRateProcessor& FixedRate);
+
+
+	////////////////////////////////////////////////////////////
+	// Deferred Work
+protected:
+	struct FDeferredWork
+	{
+		UInputProcessor* Processor{ nullptr };
+		int32 WorkId{ 0 };
+		int32 Priority{ 0 };
+		uint64 ScheduledFrame{ 0 };
+	};
+
+	//
+	// Time in milliseconds that deferred work may use per frame, remaining work is carried over to the next frame
+	//
+	UPROPERTY(Config)
+	float DeferredWorkBudgetMs{ 1.0f };
+
+	//
+	// Number of frames after which deferred work runs even if the budget is exhausted
+	//
+	UPROPERTY(Config)
+	int32 DeferredWorkMaxWaitFrames{ 8 };
+
+	TArray<FDeferredWork> DeferredWork;
+
+public:
+	/**
+	 * Queues work of the processor to run in the component tick within the frame budget.
+	 * Work with the same id already queued for the processor is not added again.
+	 * 
+	 * Tips:
+	 *	Work with higher priority runs first, and waiting work gains one priority per frame.
+	 */
+	void ScheduleDeferredWork(UInputProcessor* Processor, int32 WorkId, int32 Priority);
+
+	bool HasDeferredWork() const { return !DeferredWork.IsEmpty(); }
+
+protected:
+	void RunDeferredWork();
+
+
+	////////////////////////////////////////////////////////////
+	// Filters
+protected:
+	//
+	// Filters and their states applied to one input tag of one processor
+	//
+	struct FFilterStream
+	{
+		UInputProcessor* Processor{ nullptr };
+		int32 FixedRateIndex{ INDEX_NONE };
+		FGameplayTag InputTag;
+		const TArray<TSharedRef<const FInputFilter>, TInlineAllocator<2>>* Filters{ nullptr };
+		TArray<FInputFilterState, TInlineAllocator<2>> States;
+		double LastEventTime{ -1.0 };
+	};
+
+	struct FFilteredEvent
+	{
+		int32 StreamIndex{ INDEX_NONE };
+		ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+		FInputActionValue Value;
+		float DeltaSeconds{ 0.0f };
+	};
+
+	TArray<FFilterStream> FilterStreams;
+
+	//
+	// Events waiting for the filter stage, in the order they were received
+	//
+	TArray<FFilteredEvent> PendingFilteredEvents;
+
+	//
+	// Number of events at the front of PendingFilteredEvents that were already filtered
+	//
+	int32 NumFilteredEvents{ 0 };
+
+	bool bFlushingFilteredEvents{ false };
+
+	//
+	// Filter stage of the world the component is registered to
+	//
+	TWeakObjectPtr<UInputFilterSubsystem> FilterSubsystem;
+
+public:
+	bool HasPendingFilteredEvents() const { return !PendingFilteredEvents.IsEmpty(); }
+
+	/**
+	 * Applies the filters to the queued events.
+	 * Safe to call from worker threads in parallel with other components.
+	 */
+	void ApplyInputFilters();
+
+	/**
+	 * Dispatches the queued events after they were filtered
+	 */
+	void FlushFilteredEvents();
+
+protected:
+	void AddFilterStreams(UInputProcessor* Processor);
+	void QueueFilteredEvent(int32 StreamIndex, ETriggerEvent TriggerEvent, const FInputActionValue& InputActionValue);
+
+
+	////////////////////////////////////////////////////////////
+	// Replication
+protected:
+	//
+	// Component that sends events of processors marked bRunOnServer to the server
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UInputReplicationComponent> InputReplication;
+
+public:
+	void SetInputReplication(UInputReplicationComponent* InInputReplication) { InputReplication = InInputReplication; }
+
+
+	////////////////////////////////////////////////////////////
+	// Snapshots
+protected:
+	struct FSnapshotLayoutEntry
+	{
+		UInputProcessor* Processor{ nullptr };
+		int32 Offset{ 0 };
+		int32 Size{ 0 };
+	};
+
+	struct FInputHistoryEvent
+	{
+		uint32 Frame{ 0 };
+		UInputProcessor* Processor{ nullptr };
+		ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+		FGameplayTag InputTag;
+		FInputActionValue Value;
+	};
+
+	//
+	// Location of each processor state inside a snapshot
+	//
+	TArray<FSnapshotLayoutEntry> SnapshotLayout;
+
+	int32 SnapshotStride{ 0 };
+
+	uint64 SnapshotLayoutFrame{ MAX_uint64 };
+
+	//
+	// Preallocated ring of snapshots, SnapshotStride bytes per frame
+	//
+	TArray<uint8> SnapshotBuffer;
+
+	//
+	// Frame stored in each slot of the snapshot ring, MAX_uint32 if empty
+	//
+	TArray<uint32> SnapshotFrames;
+
+	//
+	// Preallocated ring of events dispatched since the oldest snapshot
+	//
+	TArray<FInputHistoryEvent> InputHistory;
+
+	int32 InputHistoryHead{ 0 };
+	int32 InputHistoryNum{ 0 };
+
+	//
+	// Frame of the last saved snapshot, events dispatched afterwards belong to it
+	//
+	uint32 CurrentSnapshotFrame{ 0 };
+
+	bool bResimulating{ false };
+
+public:
+	/**
+	 * Preallocates the snapshot ring and the input history.
+	 * Snapshots are disabled until this is called.
+	 */
+	void InitializeSnapshots(int32 NumFrames = 16, int32 MaxHistoryEvents = 1024);
+
+	/**
+	 * Copies the state of every processor into the snapshot of the frame.
+	 * Events dispatched after this call are recorded for the frame.
+	 */
+	bool SaveSnapshot(uint32 Frame);
+
+	/**
+	 * Copies the state saved for the frame back into the processors
+	 */
+	bool RestoreSnapshot(uint32 Frame);
+
+	/**
+	 * Restores the frame and replays the recorded events up to the latest frame,
+	 * saving the corrected snapshots of the replayed frames on the way
+	 */
+	bool ResimulateFrom(uint32 Frame);
+
+	bool HasSnapshot(uint32 Frame) const;
+
+protected:
+	void UpdateSnapshotLayout();
+	void RecordInputHistory(UInputProcessor* Processor, ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+	void WriteSnapshot(uint32 Frame);
+
+
+	////////////////////////////////////////////////////////////
+	// Recording
+protected:
+	TSharedPtr<FInputRecorder> Recorder;
+
+	TSharedPtr<FInputPlayer> Player;
+
+	TSharedPtr<FInputRecordEvent> PendingPlaybackEvent;
+
+	uint64 PlaybackStartFrame{ 0 };
+
+public:
+	/**
+	 * Starts recording every event reaching the processors to the file
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Recording")
+	bool StartInputRecording(const FString& Filename);
+
+	UFUNCTION(BlueprintCallable, Category = "Recording")
+	void StopInputRecording();
+
+	UFUNCTION(BlueprintPure, Category = "Recording")
+	bool IsRecordingInput() const;
+
+	/**
+	 * Starts replaying the recorded file through the dispatch path.
+	 * Live input events are ignored while playing back.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Recording")
+	bool StartInputPlayback(const FString& Filename);
+
+	UFUNCTION(BlueprintCallable, Category = "Recording")
+	void StopInputPlayback();
+
+	UFUNCTION(BlueprintPure, Category = "Recording")
+	bool IsPlayingBackInput() const;
+
+protected:
+	void TickInputPlayback();
+
 };
@@ -0,0 +1,157 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputIntentBus.h"
+
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+
+#include "GameplayTagsManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputIntentBus)
+
+
+void UInputIntentBus::Deinitialize()
+{
+	Subscribers.Empty();
+	PendingSubscriptions.Empty();
+
+	Super::Deinitialize();
+}
+
+
+FDelegateHandle UInputIntentBus::Subscribe(const FGameplayTag& IntentTag, FInputIntentDelegate Delegate, bool bIncludeChildTags)
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (!IntentTag.IsValid() || !Delegate.IsBound())
+	{
+		return FDelegateHandle();
+	}
+
+	FPendingSubscription Subscription;
+	Subscription.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Subscription.IntentTag = IntentTag;
+	Subscription.bIncludeChildTags = bIncludeChildTags;
+	Subscription.Delegate = MoveTemp(Delegate);
+
+	const auto Handle{ Subscription.Handle };
+
+	// The subscriber arrays must not change while they are iterated
+
+	if (PublishDepth > 0)
+	{
+		PendingSubscriptions.Add(MoveTemp(Subscription));
+	}
+	else
+	{
+		AddSubscription(Subscription);
+	}
+
+	return Handle;
+}
+
+void UInputIntentBus::Unsubscribe(FDelegateHandle Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	PendingSubscriptions.RemoveAll([Handle](const FPendingSubscription& Each) { return Each.Handle == Handle; });
+
+	for (auto It{ Subscribers.CreateIterator() }; It; ++It)
+	{
+		auto& TagSubscribers{ It.Value() };
+
+		if (PublishDepth > 0)
+		{
+			for (auto& Subscriber : TagSubscribers)
+			{
+				if (Subscriber.Handle == Handle)
+				{
+					Subscriber.Delegate.Unbind();
+					bHasUnboundSubscribers = true;
+				}
+			}
+		}
+		else
+		{
+			TagSubscribers.RemoveAll([Handle](const FSubscriber& Each) { return Each.Handle == Handle; });
+
+			if (TagSubscribers.IsEmpty())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+void UInputIntentBus::Publish(const FInputIntent& Intent)
+{
+	GEInputStats::RecordPublishedIntent();
+
+	const auto* TagSubscribers{ Subscribers.Find(Intent.IntentTag) };
+
+	if (!TagSubscribers)
+	{
+		return;
+	}
+
+	++PublishDepth;
+
+	for (const auto& Subscriber : *TagSubscribers)
+	{
+		Subscriber.Delegate.ExecuteIfBound(Intent);
+	}
+
+	--PublishDepth;
+
+	if ((PublishDepth == 0) && (bHasUnboundSubscribers || !PendingSubscriptions.IsEmpty()))
+	{
+		FlushPendingChanges();
+	}
+}
+
+
+void UInputIntentBus::AddSubscription(const FPendingSubscription& Subscription)
+{
+	FGameplayTagContainer IntentTags{ Subscription.IntentTag };
+
+	if (Subscription.bIncludeChildTags)
+	{
+		IntentTags.AppendTags(UGameplayTagsManager::Get().RequestGameplayTagChildren(Subscription.IntentTag));
+	}
+
+	for (const auto& IntentTag : IntentTags)
+	{
+		Subscribers.FindOrAdd(IntentTag).Add({ Subscription.Handle, Subscription.Delegate });
+	}
+}
+
+void UInputIntentBus::FlushPendingChanges()
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (bHasUnboundSubscribers)
+	{
+		bHasUnboundSubscribers = false;
+
+		for (auto It{ Subscribers.CreateIterator() }; It; ++It)
+		{
+			auto& TagSubscribers{ It.Value() };
+			TagSubscribers.RemoveAll([](const FSubscriber& Each) { return !Each.Delegate.IsBound(); });
+
+			if (TagSubscribers.IsEmpty())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	auto Subscriptions{ MoveTemp(PendingSubscriptions) };
+
+	for (const auto& Subscription : Subscriptions)
+	{
+		AddSubscription(Subscription);
+	}
+}
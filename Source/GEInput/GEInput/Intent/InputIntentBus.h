@@ -0,0 +1,82 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "Intent/InputIntentTypes.h"
+
+#include "InputIntentBus.generated.h"
+
+
+/**
+ * Per local player bus on which processors publish processed input for other systems (abilities, camera, UI)
+ *
+ * Tips:
+ *	Subscriptions to a parent tag are expanded to its registered child tags when subscribing,
+ *	so publishing is a single table lookup and does not allocate.
+ *	Subscribing and unsubscribing while publishing is allowed and takes effect after the outermost publish.
+ */
+UCLASS()
+class GEINPUT_API UInputIntentBus : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+public:
+	UInputIntentBus() {}
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	struct FSubscriber
+	{
+		FDelegateHandle Handle;
+		FInputIntentDelegate Delegate;
+	};
+
+	struct FPendingSubscription
+	{
+		FDelegateHandle Handle;
+		FGameplayTag IntentTag;
+		bool bIncludeChildTags{ true };
+		FInputIntentDelegate Delegate;
+	};
+
+	//
+	// Subscribers of each intent tag, a subscription to a parent tag appears under each child tag
+	//
+	TMap<FGameplayTag, TArray<FSubscriber, TInlineAllocator<4>>> Subscribers;
+
+	//
+	// Subscriptions made while publishing, added after the outermost publish
+	//
+	TArray<FPendingSubscription> PendingSubscriptions;
+
+	int32 PublishDepth{ 0 };
+
+	//
+	// True if subscribers were unbound while publishing and must be removed
+	//
+	bool bHasUnboundSubscribers{ false };
+
+public:
+	/**
+	 * Calls the delegate for every intent published with the tag, or one of its child tags if bIncludeChildTags
+	 */
+	FDelegateHandle Subscribe(const FGameplayTag& IntentTag, FInputIntentDelegate Delegate, bool bIncludeChildTags = true);
+
+	void Unsubscribe(FDelegateHandle Handle);
+
+	/**
+	 * Delivers the intent to the subscribers of its tag
+	 */
+	void Publish(const FInputIntent& Intent);
+
+	UFUNCTION(BlueprintCallable, Category = "Intent")
+	void PublishIntent(FGameplayTag IntentTag, FVector Value, int32 Data = 0) { Publish(FInputIntent(IntentTag, Value, Data)); }
+
+protected:
+	void AddSubscription(const FPendingSubscription& Subscription);
+	void FlushPendingChanges();
+
+};
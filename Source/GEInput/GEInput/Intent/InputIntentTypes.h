@@ -0,0 +1,41 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "InputIntentTypes.generated.h"
+
+
+/**
+ * Processed input published on UInputIntentBus
+ *
+ * Tips:
+ *	The payload is a fixed size value so that publishing never allocates.
+ *	Use Value for axes or deltas and Data for indices or flags defined by the intent.
+ */
+USTRUCT(BlueprintType)
+struct GEINPUT_API FInputIntent
+{
+	GENERATED_BODY()
+public:
+	FInputIntent() {}
+
+	FInputIntent(const FGameplayTag& InIntentTag, const FVector& InValue = FVector::ZeroVector, int32 InData = 0)
+		: IntentTag(InIntentTag), Value(InValue), Data(InData)
+	{}
+
+public:
+	UPROPERTY(BlueprintReadWrite, Category = "Intent")
+	FGameplayTag IntentTag;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Intent")
+	FVector Value{ FVector::ZeroVector };
+
+	UPROPERTY(BlueprintReadWrite, Category = "Intent")
+	int32 Data{ 0 };
+
+};
+
+
+DECLARE_DELEGATE_OneParam(FInputIntentDelegate, const FInputIntent&);
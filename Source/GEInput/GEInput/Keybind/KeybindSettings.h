@@ -4,6 +4,8 @@
 
 #include "PlayerMappableKeySettings.h"
 
+#include "GameplayTagContainer.h"
+
 #include "KeybindSettings.generated.h"
 
 
@@ -24,10 +26,18 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Settings")
 	FText Tooltip{ FText::GetEmpty() };
 
+	//
+	// Input tag of the action. Processors that subscribe to a parent of the tag bind the action with it.
+	//
+	UPROPERTY(EditAnywhere, Category = "Settings", meta = (Categories = "Input"))
+	FGameplayTag InputTag;
+
 public:
 	/**
 	 * Returns the tooltip that should be displayed on the settings screen for this key
 	 */
 	const FText& GetTooltipText() const { return Tooltip; }
 
+	const FGameplayTag& GetInputTag() const { return InputTag; }
+
 };
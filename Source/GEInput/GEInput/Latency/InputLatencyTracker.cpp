@@ -0,0 +1,463 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputLatencyTracker.h"
+
+#include "GEInputStats.h"
+#include "GEInputTrace.h"
+#include "Device/InputDeviceTypes.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+
+
+// FInputLatencyHistogram
+
+const uint32 FInputLatencyHistogram::BucketUpperBounds[FInputLatencyHistogram::NumBuckets]
+{
+	250, 500, 1000, 2000, 4000, 8000, 16000, 33000, 50000, 66000, 100000, MAX_uint32
+};
+
+void FInputLatencyHistogram::AddSample(uint32 Microseconds)
+{
+	for (int32 Index{ 0 }; Index < NumBuckets; ++Index)
+	{
+		if (Microseconds < BucketUpperBounds[Index] || (Index == NumBuckets - 1))
+		{
+			++Buckets[Index];
+			break;
+		}
+	}
+
+	++NumSamples;
+	SumMicroseconds += Microseconds;
+	MaxMicroseconds = FMath::Max(MaxMicroseconds, Microseconds);
+}
+
+void FInputLatencyHistogram::Reset()
+{
+	*this = FInputLatencyHistogram();
+}
+
+double FInputLatencyHistogram::GetAverageMilliseconds() const
+{
+	return (NumSamples > 0) ? (static_cast<double>(SumMicroseconds) / NumSamples) / 1000.0 : 0.0;
+}
+
+double FInputLatencyHistogram::GetPercentileMilliseconds(double Percentile) const
+{
+	if (NumSamples == 0)
+	{
+		return 0.0;
+	}
+
+	const auto Target{ static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * NumSamples)) };
+	uint32 Cumulative{ 0 };
+
+	for (int32 Index{ 0 }; Index < NumBuckets; ++Index)
+	{
+		Cumulative += Buckets[Index];
+
+		if (Cumulative >= Target)
+		{
+			const auto UpperBound{ (Index == NumBuckets - 1) ? MaxMicroseconds : BucketUpperBounds[Index] };
+			return static_cast<double>(UpperBound) / 1000.0;
+		}
+	}
+
+	return static_cast<double>(MaxMicroseconds) / 1000.0;
+}
+
+
+#if GEINPUT_LATENCY_ENABLED
+
+namespace GEInputLatency
+{
+	static bool bEnabled{ false };
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("GEInput.Latency.Enable"),
+		bEnabled,
+		TEXT("Stamps input from platform message to effect and exposes per-stage latency histograms through stats, CSV and trace."));
+
+	constexpr int32 MaxUsers{ 8 };
+
+	//
+	// Number of frames a handled input waits for its effect before being dropped
+	//
+	constexpr uint64 MaxEffectFrames{ 4 };
+
+	//
+	// Time an input waits for a handler before being dropped
+	//
+	constexpr double MaxPendingSeconds{ 1.0 };
+
+	struct FSample
+	{
+		uint64 ArrivalCycles{ 0 };
+		uint64 EvaluationCycles{ 0 };
+		uint64 EvaluationFrame{ 0 };
+		uint64 HandlerCycles{ 0 };
+		uint64 HandlerFrame{ 0 };
+
+		EInputLatencyEffect Effect{ EInputLatencyEffect::None };
+		TWeakObjectPtr<const APawn> Pawn;
+		FRotator BaselineRotation{ ForceInit };
+
+		void Reset() { *this = FSample(); }
+	};
+
+	static FSample Samples[MaxUsers];
+
+	//
+	// Oldest platform input per user that no evaluation has consumed yet
+	//
+	static uint64 PendingArrivalCycles[MaxUsers];
+	static FInputLatencyHistogram Histograms[static_cast<int32>(EInputLatencyStage::MAX)];
+
+	static FDelegateHandle PostEngineInitHandle;
+	static FDelegateHandle PostActorTickHandle;
+
+	/**
+	 * Stamps the arrival of platform input messages routed by Slate
+	 */
+	class FPreProcessor : public IInputProcessor
+	{
+	public:
+		virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+		virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override { return Stamp(InKeyEvent.GetUserIndex()); }
+		virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override { return Stamp(InKeyEvent.GetUserIndex()); }
+		virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override { return Stamp(InAnalogInputEvent.GetUserIndex()); }
+		virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return Stamp(MouseEvent.GetUserIndex()); }
+		virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return Stamp(MouseEvent.GetUserIndex()); }
+		virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return Stamp(MouseEvent.GetUserIndex()); }
+
+		virtual const TCHAR* GetDebugName() const override { return TEXT("GEInputLatency"); }
+
+	private:
+		static bool Stamp(int32 UserIndex)
+		{
+			if (bEnabled)
+			{
+				FInputLatencyTracker::NotifyPlatformInput(UserIndex);
+			}
+
+			// Never consume the input
+
+			return false;
+		}
+	};
+
+	static TSharedPtr<FPreProcessor> PreProcessor;
+
+	static FSample* FindSample(int32 UserIndex)
+	{
+		return ((UserIndex >= 0) && (UserIndex < MaxUsers)) ? &Samples[UserIndex] : nullptr;
+	}
+
+	static int32 GetUserIndex(const APlayerController* PlayerController)
+	{
+		// Slate stamps arrivals with the user index of the platform user, not the controller id
+
+		return GetSlateUserIndex(PlayerController ? PlayerController->GetLocalPlayer() : nullptr);
+	}
+
+	/**
+	 * Moves the pending arrival of the user into the sample if it is free, the arrival is consumed either way
+	 */
+	static void ConsumeArrival(int32 UserIndex, FSample& Sample, uint64 EvaluationCycles)
+	{
+		auto& ArrivalCycles{ PendingArrivalCycles[UserIndex] };
+
+		if (ArrivalCycles == 0)
+		{
+			return;
+		}
+
+		// A sample still waiting for its effect keeps measuring, the input evaluated meanwhile is not sampled
+
+		if (Sample.HandlerCycles == 0)
+		{
+			Sample.Reset();
+			Sample.ArrivalCycles = ArrivalCycles;
+			Sample.EvaluationCycles = EvaluationCycles;
+			Sample.EvaluationFrame = GFrameCounter;
+		}
+
+		ArrivalCycles = 0;
+	}
+
+	static int32 GetUserIndex(const AActor* Actor)
+	{
+		if (const auto* PlayerController{ Cast<APlayerController>(Actor) })
+		{
+			return GetUserIndex(PlayerController);
+		}
+
+		if (const auto* Pawn{ Cast<APawn>(Actor) })
+		{
+			return GetUserIndex(Cast<APlayerController>(Pawn->GetController()));
+		}
+
+		return INDEX_NONE;
+	}
+
+	static void RecordStage(EInputLatencyStage Stage, uint64 FromCycles, uint64 ToCycles)
+	{
+		const auto Milliseconds{ FPlatformTime::ToMilliseconds64(ToCycles - FromCycles) };
+		const auto Microseconds{ static_cast<uint32>(FMath::Min(Milliseconds * 1000.0, static_cast<double>(MAX_uint32))) };
+
+		Histograms[static_cast<int32>(Stage)].AddSample(Microseconds);
+
+		GEInputStats::RecordLatencySample(Stage, static_cast<float>(Milliseconds));
+		GEINPUT_TRACE_LATENCY_SAMPLE(static_cast<uint8>(Stage), Microseconds);
+	}
+
+	static void CompleteSample(FSample& Sample, uint64 EffectCycles)
+	{
+		RecordStage(EInputLatencyStage::HandlerToEffect, Sample.HandlerCycles, EffectCycles);
+		RecordStage(EInputLatencyStage::Total, Sample.ArrivalCycles, EffectCycles);
+
+		Sample.Reset();
+	}
+
+	static void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+	{
+		if (!bEnabled)
+		{
+			return;
+		}
+
+		const auto NowCycles{ FPlatformTime::Cycles64() };
+
+		// Drop inputs that were never evaluated
+
+		for (auto& ArrivalCycles : PendingArrivalCycles)
+		{
+			if ((ArrivalCycles != 0) && (FPlatformTime::ToSeconds64(NowCycles - ArrivalCycles) > MaxPendingSeconds))
+			{
+				ArrivalCycles = 0;
+			}
+		}
+
+		for (auto& Sample : Samples)
+		{
+			if (Sample.ArrivalCycles == 0)
+			{
+				continue;
+			}
+
+			// Drop inputs whose evaluation did not reach a processor, a later handler belongs to a later arrival
+
+			if (Sample.HandlerCycles == 0)
+			{
+				if (Sample.EvaluationFrame != GFrameCounter)
+				{
+					Sample.Reset();
+				}
+
+				continue;
+			}
+
+			// Check if the effect has landed
+
+			const auto* Pawn{ Sample.Pawn.Get() };
+			auto bLanded{ false };
+
+			if (Pawn && (Sample.Effect == EInputLatencyEffect::ControlRotation))
+			{
+				bLanded = !Pawn->GetControlRotation().Equals(Sample.BaselineRotation, KINDA_SMALL_NUMBER);
+			}
+			else if (Pawn && (Sample.Effect == EInputLatencyEffect::MovementConsumed))
+			{
+				bLanded = Pawn->GetPendingMovementInputVector().IsNearlyZero();
+			}
+
+			if (bLanded)
+			{
+				CompleteSample(Sample, NowCycles);
+			}
+			else if ((GFrameCounter - Sample.HandlerFrame) >= MaxEffectFrames)
+			{
+				Sample.Reset();
+			}
+		}
+	}
+
+	static void RegisterPreProcessor()
+	{
+		if (!PreProcessor.IsValid() && FSlateApplication::IsInitialized())
+		{
+			PreProcessor = MakeShared<FPreProcessor>();
+			FSlateApplication::Get().RegisterInputPreProcessor(PreProcessor, 0);
+		}
+	}
+
+	static FAutoConsoleCommandWithOutputDevice CCmdDumpLatency(
+		TEXT("GEInput.DumpLatency"),
+		TEXT("Prints the input latency histograms of each stage."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FInputLatencyTracker::Dump));
+
+	static FAutoConsoleCommand CCmdResetLatency(
+		TEXT("GEInput.ResetLatency"),
+		TEXT("Resets the input latency histograms."),
+		FConsoleCommandDelegate::CreateStatic(&FInputLatencyTracker::ResetHistograms));
+}
+
+
+bool FInputLatencyTracker::IsEnabled()
+{
+	return GEInputLatency::bEnabled;
+}
+
+void FInputLatencyTracker::Startup()
+{
+	GEInputLatency::PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&GEInputLatency::RegisterPreProcessor);
+	GEInputLatency::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&GEInputLatency::HandlePostActorTick);
+}
+
+void FInputLatencyTracker::Shutdown()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(GEInputLatency::PostEngineInitHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(GEInputLatency::PostActorTickHandle);
+
+	if (GEInputLatency::PreProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(GEInputLatency::PreProcessor);
+	}
+
+	GEInputLatency::PreProcessor.Reset();
+}
+
+
+void FInputLatencyTracker::NotifyPlatformInput(int32 UserIndex)
+{
+	if (GEInputLatency::FindSample(UserIndex))
+	{
+		// Keep the oldest input that has not been evaluated yet
+
+		auto& ArrivalCycles{ GEInputLatency::PendingArrivalCycles[UserIndex] };
+
+		if (ArrivalCycles == 0)
+		{
+			ArrivalCycles = FPlatformTime::Cycles64();
+		}
+	}
+}
+
+void FInputLatencyTracker::NotifyEvaluation(const APlayerController* PlayerController)
+{
+	if (!GEInputLatency::bEnabled)
+	{
+		return;
+	}
+
+	const auto UserIndex{ GEInputLatency::GetUserIndex(PlayerController) };
+
+	if (auto* Sample{ GEInputLatency::FindSample(UserIndex) })
+	{
+		GEInputLatency::ConsumeArrival(UserIndex, *Sample, FPlatformTime::Cycles64());
+	}
+}
+
+void FInputLatencyTracker::NotifyHandler(const AActor* InputOwner)
+{
+	if (!GEInputLatency::bEnabled)
+	{
+		return;
+	}
+
+	const auto UserIndex{ GEInputLatency::GetUserIndex(InputOwner) };
+
+	if (auto* Sample{ GEInputLatency::FindSample(UserIndex) })
+	{
+		const auto NowCycles{ FPlatformTime::Cycles64() };
+
+		// Without UInstrumentedPlayerInput the handler consumes the arrival and stamps the evaluation
+
+		if ((Sample->HandlerCycles == 0) && (Sample->EvaluationFrame != GFrameCounter))
+		{
+			GEInputLatency::ConsumeArrival(UserIndex, *Sample, NowCycles);
+		}
+
+		// Only the handlers of the frame that evaluated the arrival are paired with it
+
+		if ((Sample->ArrivalCycles != 0) && (Sample->HandlerCycles == 0) && (Sample->EvaluationFrame == GFrameCounter))
+		{
+			Sample->HandlerCycles = NowCycles;
+			Sample->HandlerFrame = GFrameCounter;
+
+			GEInputLatency::RecordStage(EInputLatencyStage::ArrivalToEvaluation, Sample->ArrivalCycles, Sample->EvaluationCycles);
+			GEInputLatency::RecordStage(EInputLatencyStage::EvaluationToHandler, Sample->EvaluationCycles, Sample->HandlerCycles);
+		}
+	}
+}
+
+void FInputLatencyTracker::NotifyEffectPending(const APawn* Pawn, EInputLatencyEffect Effect)
+{
+	if (!GEInputLatency::bEnabled || !Pawn)
+	{
+		return;
+	}
+
+	if (auto* Sample{ GEInputLatency::FindSample(GEInputLatency::GetUserIndex(Pawn)) })
+	{
+		if ((Sample->HandlerCycles != 0) && (Sample->Effect == EInputLatencyEffect::None))
+		{
+			Sample->Effect = Effect;
+			Sample->Pawn = Pawn;
+			Sample->BaselineRotation = Pawn->GetControlRotation();
+		}
+	}
+}
+
+
+const FInputLatencyHistogram& FInputLatencyTracker::GetHistogram(EInputLatencyStage Stage)
+{
+	return GEInputLatency::Histograms[static_cast<int32>(Stage)];
+}
+
+void FInputLatencyTracker::ResetHistograms()
+{
+	for (auto& Histogram : GEInputLatency::Histograms)
+	{
+		Histogram.Reset();
+	}
+}
+
+void FInputLatencyTracker::Dump(FOutputDevice& Ar)
+{
+	static const TCHAR* StageNames[]{ TEXT("ArrivalToEvaluation"), TEXT("EvaluationToHandler"), TEXT("HandlerToEffect"), TEXT("Total") };
+
+	for (int32 StageIndex{ 0 }; StageIndex < static_cast<int32>(EInputLatencyStage::MAX); ++StageIndex)
+	{
+		const auto& Histogram{ GEInputLatency::Histograms[StageIndex] };
+
+		Ar.Logf(TEXT("%s: Samples=%u Avg=%.3fms P50<=%.3fms P95<=%.3fms P99<=%.3fms Max=%.3fms"),
+			StageNames[StageIndex], Histogram.NumSamples, Histogram.GetAverageMilliseconds(),
+			Histogram.GetPercentileMilliseconds(0.5), Histogram.GetPercentileMilliseconds(0.95), Histogram.GetPercentileMilliseconds(0.99),
+			Histogram.MaxMicroseconds / 1000.0);
+
+		FString Buckets;
+		for (int32 Bucket{ 0 }; Bucket < FInputLatencyHistogram::NumBuckets; ++Bucket)
+		{
+			if (Bucket < FInputLatencyHistogram::NumBuckets - 1)
+			{
+				Buckets += FString::Printf(TEXT(" <%.2fms:%u"), FInputLatencyHistogram::BucketUpperBounds[Bucket] / 1000.0, Histogram.Buckets[Bucket]);
+			}
+			else
+			{
+				Buckets += FString::Printf(TEXT(" rest:%u"), Histogram.Buckets[Bucket]);
+			}
+		}
+
+		Ar.Logf(TEXT("   %s"), *Buckets);
+	}
+}
+
+#endif // GEINPUT_LATENCY_ENABLED
@@ -0,0 +1,101 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//
+// Whether input latency instrumentation is compiled in
+//
+#define GEINPUT_LATENCY_ENABLED !UE_BUILD_SHIPPING
+
+class AActor;
+class APawn;
+class APlayerController;
+class UWorld;
+
+/**
+ * Stages measured by FInputLatencyTracker
+ */
+enum class EInputLatencyStage : uint8
+{
+	ArrivalToEvaluation,	// Platform message received by Slate -> EnhancedInput starts evaluating the player's input
+	EvaluationToHandler,	// EnhancedInput evaluation -> UInputProcessor handler runs
+	HandlerToEffect,		// UInputProcessor handler -> Controller rotation applied or movement input consumed
+	Total,					// Platform message received by Slate -> Effect landed
+	MAX
+};
+
+/**
+ * Effect awaited after a processor handled an input
+ */
+enum class EInputLatencyEffect : uint8
+{
+	None,
+	ControlRotation,
+	MovementConsumed,
+};
+
+
+/**
+ * Fixed bucket histogram of latency samples in microseconds
+ */
+struct GEINPUT_API FInputLatencyHistogram
+{
+public:
+	static constexpr int32 NumBuckets{ 12 };
+
+	//
+	// Upper bound (exclusive) of each bucket in microseconds, the last bucket is unbounded
+	//
+	static const uint32 BucketUpperBounds[NumBuckets];
+
+	uint32 Buckets[NumBuckets]{};
+	uint32 NumSamples{ 0 };
+	uint64 SumMicroseconds{ 0 };
+	uint32 MaxMicroseconds{ 0 };
+
+public:
+	void AddSample(uint32 Microseconds);
+	void Reset();
+
+	double GetAverageMilliseconds() const;
+
+	/**
+	 * Returns the upper bound of the bucket that contains the percentile (0-1) in milliseconds
+	 */
+	double GetPercentileMilliseconds(double Percentile) const;
+};
+
+
+#if GEINPUT_LATENCY_ENABLED
+
+/**
+ * Stamps input from the moment Slate receives the platform message until its effect lands on the controller or pawn
+ *
+ * Tips:
+ *	Disabled by default, enable with "GEInput.Latency.Enable 1".
+ *	The EnhancedInput evaluation stage requires UInstrumentedPlayerInput as the player input class,
+ *	otherwise the evaluation is stamped when the processor handler runs.
+ */
+class GEINPUT_API FInputLatencyTracker
+{
+public:
+	static bool IsEnabled();
+
+	static void Startup();
+	static void Shutdown();
+
+	static void NotifyPlatformInput(int32 UserIndex);
+	static void NotifyEvaluation(const APlayerController* PlayerController);
+	static void NotifyHandler(const AActor* InputOwner);
+	static void NotifyEffectPending(const APawn* Pawn, EInputLatencyEffect Effect);
+
+	static const FInputLatencyHistogram& GetHistogram(EInputLatencyStage Stage);
+	static void ResetHistograms();
+
+	static void Dump(FOutputDevice& Ar);
+
+};
+
+#endif // GEINPUT_LATENCY_ENABLED
@@ -0,0 +1,28 @@
+// Copyright (C) 2024 owoDra
+
+#include "InstrumentedPlayerInput.h"
+
+#include "Latency/InputLatencyTracker.h"
+
+#include "GameFramework/PlayerController.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InstrumentedPlayerInput)
+
+
+UInstrumentedPlayerInput::UInstrumentedPlayerInput(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+void UInstrumentedPlayerInput::ProcessInputStack(const TArray<UInputComponent*>& InputComponentStack, const float DeltaTime, const bool bGamePaused)
+{
+#if GEINPUT_LATENCY_ENABLED
+	if (FInputLatencyTracker::IsEnabled())
+	{
+		FInputLatencyTracker::NotifyEvaluation(GetOuterAPlayerController());
+	}
+#endif
+
+	Super::ProcessInputStack(InputComponentStack, DeltaTime, bGamePaused);
+}
@@ -0,0 +1,27 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "EnhancedPlayerInput.h"
+
+#include "InstrumentedPlayerInput.generated.h"
+
+
+/**
+ * EnhancedPlayerInput that stamps the start of input evaluation for FInputLatencyTracker
+ *
+ * Tips:
+ *	Set as "DefaultPlayerInputClass" in the [/Script/Engine.InputSettings] section of DefaultInput.ini
+ *	to measure the ArrivalToEvaluation stage separately from the EvaluationToHandler stage.
+ */
+UCLASS(Config = Input, Transient)
+class GEINPUT_API UInstrumentedPlayerInput : public UEnhancedPlayerInput
+{
+	GENERATED_BODY()
+public:
+	UInstrumentedPlayerInput(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	virtual void ProcessInputStack(const TArray<UInputComponent*>& InputComponentStack, const float DeltaTime, const bool bGamePaused) override;
+
+};
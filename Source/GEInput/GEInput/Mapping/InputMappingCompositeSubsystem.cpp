@@ -0,0 +1,526 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputMappingCompositeSubsystem.h"
+
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+
+#include "Keybind/KeybindSettings.h"
+
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "EnhancedInputSubsystems.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+#include "InputMappingContext.h"
+#include "InputAction.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputMappingCompositeSubsystem)
+
+
+namespace GEInputMappingComposite
+{
+	static bool bEnabled{ false };
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("GEInput.Mapping.Composite"),
+		bEnabled,
+		TEXT("Merges the mapping contexts added by game features into one cached composite context per combination of contexts and priorities.\n")
+		TEXT("The composite is added at the highest priority of its sources, so a mapping context added outside of game features with a priority ")
+		TEXT("between the lowest and highest feature priority no longer sits between the feature contexts. Leave disabled if a player relies on such interleaving."));
+
+	static int32 MaxCachedComposites{ 8 };
+	static FAutoConsoleVariableRef CVarMaxCachedComposites(
+		TEXT("GEInput.Mapping.MaxCachedComposites"),
+		MaxCachedComposites,
+		TEXT("Number of composite mapping contexts kept per local player, the least recently used one is discarded first."));
+}
+
+
+// UInputMappingCompositeSubsystem
+
+void UInputMappingCompositeSubsystem::Deinitialize()
+{
+	UnbindUserSettings();
+
+	SourcesByOwner.Empty();
+	CachedComposites.Empty();
+	AppliedComposite = nullptr;
+	InputActionsByTag.Empty();
+	OnInputActionsByTagChanged.Clear();
+
+	Super::Deinitialize();
+}
+
+bool UInputMappingCompositeSubsystem::IsCompositeEnabled()
+{
+	return GEInputMappingComposite::bEnabled;
+}
+
+
+void UInputMappingCompositeSubsystem::AddMappingContexts(const UObject* Owner, TConstArrayView<FInputMappingCompositeSource> Sources)
+{
+	GEINPUT_LLM_SCOPE();
+
+	auto* InputSystem{ GetInputSystem() };
+
+	if (!InputSystem)
+	{
+		return;
+	}
+
+	UpdateMode(InputSystem);
+
+	auto& OwnerSources{ SourcesByOwner.FindOrAdd(Owner) };
+
+	// Contexts no longer added by the owner are removed, the others are only added again
+
+	if (!bCompositeMode)
+	{
+		TArray<FInputMappingCompositeSource> RemovedSources;
+
+		for (const auto& Source : OwnerSources)
+		{
+			if (!Sources.ContainsByPredicate([&Source](const FInputMappingCompositeSource& Other) { return Other.MappingContext == Source.MappingContext; }))
+			{
+				RemovedSources.Add(Source);
+			}
+		}
+
+		RemoveSeparateContexts(InputSystem, RemovedSources);
+	}
+
+	OwnerSources.Reset();
+	OwnerSources.Append(Sources.GetData(), Sources.Num());
+
+	if (bCompositeMode)
+	{
+		ApplyComposite(InputSystem);
+	}
+	else
+	{
+		AddSeparateContexts(InputSystem, OwnerSources);
+	}
+
+	UpdateInputActionsByTag();
+}
+
+void UInputMappingCompositeSubsystem::RemoveMappingContexts(const UObject* Owner)
+{
+	auto* InputSystem{ GetInputSystem() };
+
+	if (InputSystem)
+	{
+		UpdateMode(InputSystem);
+	}
+
+	TArray<FInputMappingCompositeSource> OwnerSources;
+
+	if (!SourcesByOwner.RemoveAndCopyValue(Owner, OwnerSources))
+	{
+		return;
+	}
+
+	UpdateInputActionsByTag();
+
+	if (!InputSystem)
+	{
+		return;
+	}
+
+	if (bCompositeMode)
+	{
+		ApplyComposite(InputSystem);
+	}
+	else
+	{
+		RemoveSeparateContexts(InputSystem, OwnerSources);
+	}
+}
+
+
+void UInputMappingCompositeSubsystem::CollectInputActionsByTag(const UInputMappingContext* MappingContext, TMap<FGameplayTag, TObjectPtr<const UInputAction>>& OutInputActions)
+{
+	if (!MappingContext)
+	{
+		return;
+	}
+
+	for (const auto& Mapping : MappingContext->GetMappings())
+	{
+		const auto* KeybindSettings{ Cast<UKeybindSettings>(Mapping.GetPlayerMappableKeySettings()) };
+
+		if (Mapping.Action && KeybindSettings && KeybindSettings->GetInputTag().IsValid())
+		{
+			if (!OutInputActions.Contains(KeybindSettings->GetInputTag()))
+			{
+				OutInputActions.Add(KeybindSettings->GetInputTag(), Mapping.Action);
+			}
+		}
+	}
+}
+
+void UInputMappingCompositeSubsystem::UpdateInputActionsByTag()
+{
+	// Higher priority contexts are collected first so that their action is kept for a tag
+
+	TArray<FInputMappingCompositeSource> Sources;
+
+	for (const auto& KVP : SourcesByOwner)
+	{
+		Sources.Append(KVP.Value);
+	}
+
+	Sources.StableSort([](const FInputMappingCompositeSource& A, const FInputMappingCompositeSource& B) { return A.Priority > B.Priority; });
+
+	TMap<FGameplayTag, TObjectPtr<const UInputAction>> NewInputActions;
+
+	for (const auto& Source : Sources)
+	{
+		CollectInputActionsByTag(Source.MappingContext.Get(), NewInputActions);
+	}
+
+	if (NewInputActions.OrderIndependentCompareEqual(InputActionsByTag))
+	{
+		return;
+	}
+
+	InputActionsByTag = MoveTemp(NewInputActions);
+
+	OnInputActionsByTagChanged.Broadcast(InputActionsByTag);
+}
+
+
+void UInputMappingCompositeSubsystem::UpdateMode(UEnhancedInputLocalPlayerSubsystem* InputSystem)
+{
+	const auto bWantsComposite{ IsCompositeEnabled() };
+
+	if (bWantsComposite == bCompositeMode)
+	{
+		return;
+	}
+
+	if (bCompositeMode)
+	{
+		RemoveComposite(InputSystem);
+
+		bCompositeMode = false;
+
+		for (const auto& KVP : SourcesByOwner)
+		{
+			AddSeparateContexts(InputSystem, KVP.Value);
+		}
+	}
+	else
+	{
+		for (const auto& KVP : SourcesByOwner)
+		{
+			RemoveSeparateContexts(InputSystem, KVP.Value);
+		}
+
+		bCompositeMode = true;
+
+		ApplyComposite(InputSystem);
+	}
+}
+
+void UInputMappingCompositeSubsystem::AddSeparateContexts(UEnhancedInputLocalPlayerSubsystem* InputSystem, TConstArrayView<FInputMappingCompositeSource> Sources)
+{
+	for (const auto& Source : Sources)
+	{
+		if (const auto* MappingContext{ Source.MappingContext.Get() })
+		{
+			InputSystem->AddMappingContext(MappingContext, Source.Priority);
+			GEInputStats::RecordMappingContextRebuild();
+
+			TraceMappingContextChanged(MappingContext, Source.Priority, true);
+		}
+	}
+}
+
+void UInputMappingCompositeSubsystem::RemoveSeparateContexts(UEnhancedInputLocalPlayerSubsystem* InputSystem, TConstArrayView<FInputMappingCompositeSource> Sources)
+{
+	for (const auto& Source : Sources)
+	{
+		if (const auto* MappingContext{ Source.MappingContext.Get() })
+		{
+			InputSystem->RemoveMappingContext(MappingContext);
+			GEInputStats::RecordMappingContextRebuild();
+
+			TraceMappingContextChanged(MappingContext, Source.Priority, false);
+		}
+	}
+}
+
+
+void UInputMappingCompositeSubsystem::ApplyComposite(UEnhancedInputLocalPlayerSubsystem* InputSystem)
+{
+	// A context added by several owners is merged once with its highest priority
+
+	TMap<const UInputMappingContext*, int32> UniqueSources;
+
+	for (const auto& KVP : SourcesByOwner)
+	{
+		for (const auto& Source : KVP.Value)
+		{
+			if (const auto* MappingContext{ Source.MappingContext.Get() })
+			{
+				auto& Priority{ UniqueSources.FindOrAdd(MappingContext, Source.Priority) };
+				Priority = FMath::Max(Priority, Source.Priority);
+			}
+		}
+	}
+
+	if (UniqueSources.IsEmpty())
+	{
+		RemoveComposite(InputSystem);
+		return;
+	}
+
+	TArray<FInputMappingCompositeSource> Sources;
+	Sources.Reserve(UniqueSources.Num());
+
+	for (const auto& KVP : UniqueSources)
+	{
+		Sources.Add({ KVP.Key, KVP.Value });
+	}
+
+	const auto& Composite{ FindOrAddComposite(MoveTemp(Sources)) };
+
+	// Same combination as the applied one, nothing to rebuild
+
+	if (Composite.MappingContext == AppliedComposite)
+	{
+		return;
+	}
+
+	RemoveComposite(InputSystem);
+
+	InputSystem->AddMappingContext(Composite.MappingContext, Composite.Priority);
+	GEInputStats::RecordMappingContextRebuild();
+
+	TraceMappingContextChanged(Composite.MappingContext, Composite.Priority, true);
+
+	AppliedComposite = Composite.MappingContext;
+}
+
+void UInputMappingCompositeSubsystem::RemoveComposite(UEnhancedInputLocalPlayerSubsystem* InputSystem)
+{
+	if (AppliedComposite)
+	{
+		InputSystem->RemoveMappingContext(AppliedComposite);
+		GEInputStats::RecordMappingContextRebuild();
+
+		TraceMappingContextChanged(AppliedComposite, 0, false);
+
+		AppliedComposite = nullptr;
+	}
+}
+
+
+const FInputMappingComposite& UInputMappingCompositeSubsystem::FindOrAddComposite(TArray<FInputMappingCompositeSource>&& Sources)
+{
+	// Key the combination independently of the order in which the owners added their contexts
+
+	TArray<TPair<FObjectKey, int32>> Key;
+	Key.Reserve(Sources.Num());
+
+	for (const auto& Source : Sources)
+	{
+		Key.Emplace(FObjectKey(Source.MappingContext.Get()), Source.Priority);
+	}
+
+	Key.Sort([](const TPair<FObjectKey, int32>& A, const TPair<FObjectKey, int32>& B) { return A.Key < B.Key; });
+
+	auto Hash{ GetTypeHash(Key.Num()) };
+
+	for (const auto& Pair : Key)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+	}
+
+	for (auto& Composite : CachedComposites)
+	{
+		if ((Composite.Hash == Hash) && (Composite.Sources == Key) && Composite.MappingContext)
+		{
+			Composite.LastUsed = ++UseCounter;
+			return Composite;
+		}
+	}
+
+	// Discard the least recently used composite that is not applied
+
+	if (CachedComposites.Num() >= FMath::Max(GEInputMappingComposite::MaxCachedComposites, 1))
+	{
+		auto OldestIndex{ INDEX_NONE };
+
+		for (auto Index{ 0 }; Index < CachedComposites.Num(); ++Index)
+		{
+			const auto& Composite{ CachedComposites[Index] };
+
+			if ((Composite.MappingContext != AppliedComposite) && ((OldestIndex == INDEX_NONE) || (Composite.LastUsed < CachedComposites[OldestIndex].LastUsed)))
+			{
+				OldestIndex = Index;
+			}
+		}
+
+		if (OldestIndex != INDEX_NONE)
+		{
+			CachedComposites.RemoveAtSwap(OldestIndex);
+		}
+	}
+
+	auto& NewComposite{ CachedComposites.AddDefaulted_GetRef() };
+	NewComposite.Hash = Hash;
+	NewComposite.Sources = MoveTemp(Key);
+	NewComposite.LastUsed = ++UseCounter;
+	NewComposite.MappingContext = BuildComposite(Sources);
+
+	for (const auto& Source : Sources)
+	{
+		NewComposite.Priority = FMath::Max(NewComposite.Priority, Source.Priority);
+	}
+
+	return NewComposite;
+}
+
+UInputMappingContext* UInputMappingCompositeSubsystem::BuildComposite(TArray<FInputMappingCompositeSource>& Sources)
+{
+	GEINPUT_LLM_SCOPE();
+
+	Sources.StableSort([](const FInputMappingCompositeSource& A, const FInputMappingCompositeSource& B) { return A.Priority > B.Priority; });
+
+	auto* Composite{ NewObject<UInputMappingContext>(this, NAME_None, RF_Transient) };
+
+	const auto* KeyProfile{ BindUserSettings() };
+
+	// Keys consumed by the actions of a context are not mapped by lower priority contexts.
+	// Mappings keep their default key since EnhancedInput applies the remaps of the composite itself.
+
+	TSet<FKey> ConsumedKeys;
+
+	for (const auto& Source : Sources)
+	{
+		const auto* MappingContext{ Source.MappingContext.Get() };
+
+		if (!MappingContext)
+		{
+			continue;
+		}
+
+		TArray<FKey> ContextConsumedKeys;
+
+		for (const auto& Mapping : MappingContext->GetMappings())
+		{
+			const auto PlayerMappedKey{ GetPlayerMappedKey(KeyProfile, Mapping) };
+
+			if (!Mapping.Action || ConsumedKeys.Contains(PlayerMappedKey))
+			{
+				continue;
+			}
+
+			Composite->MapKey(Mapping.Action, Mapping.Key) = Mapping;
+
+			if (Mapping.Action->bConsumeInput)
+			{
+				ContextConsumedKeys.Add(PlayerMappedKey);
+			}
+		}
+
+		ConsumedKeys.Append(ContextConsumedKeys);
+	}
+
+	return Composite;
+}
+
+FKey UInputMappingCompositeSubsystem::GetPlayerMappedKey(const UEnhancedPlayerMappableKeyProfile* KeyProfile, const FEnhancedActionKeyMapping& Mapping)
+{
+	if (!KeyProfile || !Mapping.IsPlayerMappable())
+	{
+		return Mapping.Key;
+	}
+
+	if (const auto* MappingRow{ KeyProfile->FindKeyMappingRow(Mapping.GetMappingName()) })
+	{
+		for (const auto& PlayerMapping : MappingRow->Mappings)
+		{
+			if (PlayerMapping.GetDefaultKey() == Mapping.Key)
+			{
+				return PlayerMapping.GetCurrentKey();
+			}
+		}
+	}
+
+	return Mapping.Key;
+}
+
+const UEnhancedPlayerMappableKeyProfile* UInputMappingCompositeSubsystem::BindUserSettings()
+{
+	auto* InputSystem{ GetInputSystem() };
+	auto* Settings{ InputSystem ? InputSystem->GetUserSettings() : nullptr };
+
+	if (Settings != BoundUserSettings.Get())
+	{
+		UnbindUserSettings();
+
+		if (Settings)
+		{
+			Settings->OnSettingsChanged.AddUniqueDynamic(this, &ThisClass::HandleUserSettingsChanged);
+			Settings->OnKeyProfileChanged.AddUniqueDynamic(this, &ThisClass::HandleKeyProfileChanged);
+
+			BoundUserSettings = Settings;
+		}
+	}
+
+	return Settings ? Settings->GetCurrentKeyProfile() : nullptr;
+}
+
+void UInputMappingCompositeSubsystem::UnbindUserSettings()
+{
+	if (auto* Settings{ BoundUserSettings.Get() })
+	{
+		Settings->OnSettingsChanged.RemoveDynamic(this, &ThisClass::HandleUserSettingsChanged);
+		Settings->OnKeyProfileChanged.RemoveDynamic(this, &ThisClass::HandleKeyProfileChanged);
+	}
+
+	BoundUserSettings.Reset();
+}
+
+void UInputMappingCompositeSubsystem::HandleUserSettingsChanged(UEnhancedInputUserSettings* Settings)
+{
+	InvalidateComposites();
+}
+
+void UInputMappingCompositeSubsystem::HandleKeyProfileChanged(const UEnhancedPlayerMappableKeyProfile* NewProfile)
+{
+	InvalidateComposites();
+}
+
+void UInputMappingCompositeSubsystem::InvalidateComposites()
+{
+	// The applied composite stays referenced by AppliedComposite until it is replaced
+
+	CachedComposites.Reset();
+
+	auto* InputSystem{ GetInputSystem() };
+
+	if (InputSystem && bCompositeMode)
+	{
+		ApplyComposite(InputSystem);
+	}
+}
+
+
+UEnhancedInputLocalPlayerSubsystem* UInputMappingCompositeSubsystem::GetInputSystem() const
+{
+	return ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer());
+}
+
+void UInputMappingCompositeSubsystem::TraceMappingContextChanged(const UInputMappingContext* MappingContext, int32 Priority, bool bAdded) const
+{
+#if GEINPUT_TRACE_ENABLED
+	const auto* LocalPlayer{ GetLocalPlayer() };
+	const auto* PlayerController{ LocalPlayer ? LocalPlayer->PlayerController.Get() : nullptr };
+
+	GEINPUT_TRACE_MAPPING_CONTEXT_CHANGED(PlayerController, MappingContext, Priority, bAdded);
+#endif
+}
@@ -0,0 +1,202 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayTagContainer.h"
+
+#include "InputMappingCompositeSubsystem.generated.h"
+
+class UInputMappingContext;
+class UInputAction;
+class UEnhancedInputLocalPlayerSubsystem;
+class UEnhancedInputUserSettings;
+class UEnhancedPlayerMappableKeyProfile;
+struct FEnhancedActionKeyMapping;
+struct FKey;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FInputActionsByTagChangedDelegate, const TMap<FGameplayTag, TObjectPtr<const UInputAction>>&);
+
+
+/**
+ * Mapping context and priority added by a game feature
+ */
+struct FInputMappingCompositeSource
+{
+public:
+	TWeakObjectPtr<const UInputMappingContext> MappingContext;
+
+	int32 Priority{ 0 };
+};
+
+
+/**
+ * Flattened mapping context built from a combination of mapping contexts and priorities
+ */
+USTRUCT()
+struct FInputMappingComposite
+{
+	GENERATED_BODY()
+public:
+	FInputMappingComposite() {}
+
+public:
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> MappingContext{ nullptr };
+
+	int32 Priority{ 0 };
+
+	//
+	// Hash of Sources, compared before the sources themselves
+	//
+	uint32 Hash{ 0 };
+
+	//
+	// Mapping contexts and priorities the composite was built from, sorted by mapping context
+	//
+	TArray<TPair<FObjectKey, int32>> Sources;
+
+	uint64 LastUsed{ 0 };
+};
+
+
+/**
+ * Adds the mapping contexts of the game features to the EnhancedInput subsystem of a local player
+ *
+ * Tips:
+ *	With GEInput.Mapping.Composite enabled, the mapping contexts of all features are merged into one composite context
+ *	cached by the combination of mapping contexts and priorities, so that a combination that recurs (for example when
+ *	respawning into the same mode) replaces a single context instead of removing and adding every context of every feature.
+ *	Keys consumed by a higher priority context are dropped from lower priority contexts while merging, as EnhancedInput
+ *	does when it rebuilds its mappings. The composite is added with the highest priority of its sources, so other mapping
+ *	contexts of the player with a priority inside the range of the sources are ordered below all of them.
+ *	Keys the player remapped in the current key profile of the EnhancedInput user settings are consumed instead of the default keys,
+ *	and the cached composites are discarded when the user settings or the key profile change.
+ *	Composites are built from the contexts as they are when first used, edits made to a source context while playing are not reflected.
+ */
+UCLASS()
+class GEINPUT_API UInputMappingCompositeSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+public:
+	UInputMappingCompositeSubsystem() {}
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	TMap<TObjectKey<UObject>, TArray<FInputMappingCompositeSource>> SourcesByOwner;
+
+	UPROPERTY(Transient)
+	TArray<FInputMappingComposite> CachedComposites;
+
+	//
+	// Composite currently added to the EnhancedInput subsystem
+	//
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> AppliedComposite{ nullptr };
+
+	//
+	// True if the contexts are currently added as composites rather than one by one
+	//
+	bool bCompositeMode{ false };
+
+	uint64 UseCounter{ 0 };
+
+	//
+	// User settings whose changes discard the cached composites
+	//
+	TWeakObjectPtr<UEnhancedInputUserSettings> BoundUserSettings;
+
+	//
+	// Input actions of the added mapping contexts by the input tag of their keybind settings
+	//
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, TObjectPtr<const UInputAction>> InputActionsByTag;
+
+public:
+	//
+	// Broadcast when the input actions by input tag changed
+	//
+	FInputActionsByTagChangedDelegate OnInputActionsByTagChanged;
+
+public:
+	/**
+	 * Adds the mapping contexts of the owner, replacing the ones it added before
+	 */
+	void AddMappingContexts(const UObject* Owner, TConstArrayView<FInputMappingCompositeSource> Sources);
+
+	/**
+	 * Removes the mapping contexts added by the owner
+	 */
+	void RemoveMappingContexts(const UObject* Owner);
+
+	int32 GetNumCachedComposites() const { return CachedComposites.Num(); }
+
+	const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& GetInputActionsByTag() const { return InputActionsByTag; }
+
+	/**
+	 * Adds the input actions of the mapping context whose keybind settings have an input tag, the first action found for a tag is kept
+	 */
+	static void CollectInputActionsByTag(const UInputMappingContext* MappingContext, TMap<FGameplayTag, TObjectPtr<const UInputAction>>& OutInputActions);
+
+	/**
+	 * Returns true if the mapping contexts are merged into composites
+	 */
+	static bool IsCompositeEnabled();
+
+protected:
+	/**
+	 * Switches between composite and separate contexts if GEInput.Mapping.Composite changed since the last update
+	 */
+	void UpdateMode(UEnhancedInputLocalPlayerSubsystem* InputSystem);
+
+	/**
+	 * Rebuilds the input actions by input tag from the current sources and broadcasts if they changed
+	 */
+	void UpdateInputActionsByTag();
+
+	void AddSeparateContexts(UEnhancedInputLocalPlayerSubsystem* InputSystem, TConstArrayView<FInputMappingCompositeSource> Sources);
+	void RemoveSeparateContexts(UEnhancedInputLocalPlayerSubsystem* InputSystem, TConstArrayView<FInputMappingCompositeSource> Sources);
+
+	/**
+	 * Replaces the applied composite with the composite of all current sources
+	 */
+	void ApplyComposite(UEnhancedInputLocalPlayerSubsystem* InputSystem);
+	void RemoveComposite(UEnhancedInputLocalPlayerSubsystem* InputSystem);
+
+	/**
+	 * Returns the cached composite for the sources or builds a new one
+	 */
+	const FInputMappingComposite& FindOrAddComposite(TArray<FInputMappingCompositeSource>&& Sources);
+
+	UInputMappingContext* BuildComposite(TArray<FInputMappingCompositeSource>& Sources);
+
+	/**
+	 * Returns the key the player mapped to the mapping in the key profile, or the key of the mapping if it is not remapped
+	 */
+	static FKey GetPlayerMappedKey(const UEnhancedPlayerMappableKeyProfile* KeyProfile, const FEnhancedActionKeyMapping& Mapping);
+
+	/**
+	 * Returns the current key profile of the user settings and listens for their changes
+	 */
+	const UEnhancedPlayerMappableKeyProfile* BindUserSettings();
+	void UnbindUserSettings();
+
+	UFUNCTION()
+	void HandleUserSettingsChanged(UEnhancedInputUserSettings* Settings);
+
+	UFUNCTION()
+	void HandleKeyProfileChanged(const UEnhancedPlayerMappableKeyProfile* NewProfile);
+
+	/**
+	 * Discards the cached composites and applies a composite built with the current remaps
+	 */
+	void InvalidateComposites();
+
+	UEnhancedInputLocalPlayerSubsystem* GetInputSystem() const;
+
+	void TraceMappingContextChanged(const UInputMappingContext* MappingContext, int32 Priority, bool bAdded) const;
+
+};
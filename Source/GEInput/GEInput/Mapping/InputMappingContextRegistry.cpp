@@ -0,0 +1,345 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputMappingContextRegistry.h"
+
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+#include "GEInputLogs.h"
+
+#include "AssetManager/GFCAssetManager.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
+
+
+namespace GEInputMappingRegistry
+{
+	static bool bDeferred{ false };
+	static FAutoConsoleVariableRef CVarDeferred(
+		TEXT("GEInput.MappingRegistry.Deferred"),
+		bDeferred,
+		TEXT("Collects mapping context registrations and applies them to the user settings on the next tick instead of immediately."));
+
+	static FInputMappingContextRegistry* Instance{ nullptr };
+}
+
+
+// FInputMappingContextRegistry
+
+void FInputMappingContextRegistry::Startup()
+{
+	check(!GEInputMappingRegistry::Instance);
+
+	GEInputMappingRegistry::Instance = new FInputMappingContextRegistry();
+}
+
+void FInputMappingContextRegistry::Shutdown()
+{
+	delete GEInputMappingRegistry::Instance;
+
+	GEInputMappingRegistry::Instance = nullptr;
+}
+
+FInputMappingContextRegistry* FInputMappingContextRegistry::Get()
+{
+	return GEInputMappingRegistry::Instance;
+}
+
+
+FInputMappingContextRegistry::FInputMappingContextRegistry()
+{
+	StartGameInstanceHandle = FWorldDelegates::OnStartGameInstance.AddRaw(this, &FInputMappingContextRegistry::HandleStartGameInstance);
+}
+
+FInputMappingContextRegistry::~FInputMappingContextRegistry()
+{
+	FWorldDelegates::OnStartGameInstance.Remove(StartGameInstanceHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+
+	if (GEngine)
+	{
+		for (const auto& WorldContext : GEngine->GetWorldContexts())
+		{
+			if (auto* GameInstance{ WorldContext.OwningGameInstance.Get() })
+			{
+				GameInstance->OnLocalPlayerAddedEvent.RemoveAll(this);
+				GameInstance->OnLocalPlayerRemovedEvent.RemoveAll(this);
+			}
+		}
+	}
+}
+
+
+void FInputMappingContextRegistry::RegisterMappingContexts(const UObject* Owner, TConstArrayView<TSoftObjectPtr<UInputMappingContext>> MappingContexts)
+{
+	GEINPUT_LLM_SCOPE();
+
+	check(Owner);
+
+	// Registered again by the same owner, replaces its previous contexts
+
+	UnregisterMappingContexts(Owner);
+
+	auto& OwnerContexts{ ContextsByOwner.Add(Owner) };
+
+	for (const auto& MappingContext : MappingContexts)
+	{
+		const auto& Path{ MappingContext.ToSoftObjectPath() };
+
+		if (!Path.IsNull() && !OwnerContexts.Contains(Path))
+		{
+			OwnerContexts.Add(Path);
+			AddReference(Path);
+		}
+	}
+
+	RequestFlush();
+}
+
+void FInputMappingContextRegistry::UnregisterMappingContexts(const UObject* Owner)
+{
+	TArray<FSoftObjectPath> OwnerContexts;
+
+	if (ContextsByOwner.RemoveAndCopyValue(Owner, OwnerContexts))
+	{
+		for (const auto& Path : OwnerContexts)
+		{
+			RemoveReference(Path);
+		}
+
+		RequestFlush();
+	}
+}
+
+void FInputMappingContextRegistry::AddReference(const FSoftObjectPath& Path)
+{
+	auto& Entry{ RegisteredContexts.FindOrAdd(Path) };
+
+	if (++Entry.RefCount > 1)
+	{
+		return;
+	}
+
+	// Removed and added again before the flush, cancels the removal
+
+	TObjectPtr<UInputMappingContext> PendingRemoval;
+
+	if (PendingRemovals.RemoveAndCopyValue(Path, PendingRemoval))
+	{
+		Entry.MappingContext = PendingRemoval;
+	}
+	else
+	{
+		PendingAdditions.Add(Path);
+	}
+}
+
+void FInputMappingContextRegistry::RemoveReference(const FSoftObjectPath& Path)
+{
+	auto* Entry{ RegisteredContexts.Find(Path) };
+
+	if (!ensure(Entry) || (--Entry->RefCount > 0))
+	{
+		return;
+	}
+
+	// Added and removed again before the flush, cancels the addition
+
+	if (PendingAdditions.Remove(Path) == 0 && Entry->MappingContext)
+	{
+		PendingRemovals.Add(Path, Entry->MappingContext);
+	}
+
+	RegisteredContexts.Remove(Path);
+}
+
+
+void FInputMappingContextRegistry::RequestFlush()
+{
+	if (!GEInputMappingRegistry::bDeferred)
+	{
+		Flush();
+	}
+	else if (!FlushTickerHandle.IsValid() && (GetNumPendingChanges() > 0))
+	{
+		FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FInputMappingContextRegistry::HandleFlushTicker));
+	}
+}
+
+bool FInputMappingContextRegistry::HandleFlushTicker(float DeltaTime)
+{
+	FlushTickerHandle.Reset();
+
+	Flush();
+
+	return false;
+}
+
+void FInputMappingContextRegistry::Flush()
+{
+	if (GetNumPendingChanges() <= 0)
+	{
+		return;
+	}
+
+	GEINPUT_LLM_SCOPE();
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_FlushMappingContextRegistry);
+
+	auto& AssetManager{ UGFCAssetManager::Get() };
+
+	TSet<UInputMappingContext*> ContextsToAdd;
+	ContextsToAdd.Reserve(PendingAdditions.Num());
+
+	for (const auto& Path : PendingAdditions)
+	{
+		const TSoftObjectPtr<UInputMappingContext> SoftMappingContext{ Path };
+
+		if (!SoftMappingContext.IsValid())
+		{
+			GEInputStats::RecordSynchronousLoad();
+		}
+
+		auto* Entry{ RegisteredContexts.Find(Path) };
+		auto* MappingContext{ AssetManager.GetAsset(SoftMappingContext) };
+
+		if (Entry && MappingContext)
+		{
+			Entry->MappingContext = MappingContext;
+			ContextsToAdd.Add(MappingContext);
+		}
+		else if (Entry)
+		{
+			UE_LOG(LogGameCore_Input, Warning, TEXT("Failed to load mapping context (%s) for registration with the user settings."), *Path.ToString());
+		}
+	}
+
+	TSet<UInputMappingContext*> ContextsToRemove;
+	ContextsToRemove.Reserve(PendingRemovals.Num());
+
+	for (const auto& KVP : PendingRemovals)
+	{
+		ContextsToRemove.Add(KVP.Value);
+	}
+
+	PendingAdditions.Reset();
+	PendingRemovals.Reset();
+
+	// Apply the changes to every local player in one pass
+
+	if (!GEngine)
+	{
+		return;
+	}
+
+	for (const auto& WorldContext : GEngine->GetWorldContexts())
+	{
+		if (auto* GameInstance{ WorldContext.OwningGameInstance.Get() })
+		{
+			for (auto LocalPlayerIterator{ GameInstance->GetLocalPlayerIterator() }; LocalPlayerIterator; ++LocalPlayerIterator)
+			{
+				if (auto* Settings{ GetUserSettings(*LocalPlayerIterator) })
+				{
+					if (!ContextsToRemove.IsEmpty())
+					{
+						Settings->UnregisterInputMappingContexts(ContextsToRemove);
+					}
+
+					if (!ContextsToAdd.IsEmpty())
+					{
+						Settings->RegisterInputMappingContexts(ContextsToAdd);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+void FInputMappingContextRegistry::HandleStartGameInstance(UGameInstance* GameInstance)
+{
+	if (GameInstance != nullptr && !GameInstance->OnLocalPlayerAddedEvent.IsBoundToObject(this))
+	{
+		GameInstance->OnLocalPlayerAddedEvent.AddRaw(this, &FInputMappingContextRegistry::HandleLocalPlayerAdded);
+		GameInstance->OnLocalPlayerRemovedEvent.AddRaw(this, &FInputMappingContextRegistry::HandleLocalPlayerRemoved);
+
+		for (auto LocalPlayerIterator{ GameInstance->GetLocalPlayerIterator() }; LocalPlayerIterator; ++LocalPlayerIterator)
+		{
+			HandleLocalPlayerAdded(*LocalPlayerIterator);
+		}
+	}
+}
+
+void FInputMappingContextRegistry::HandleLocalPlayerAdded(ULocalPlayer* LocalPlayer)
+{
+	GEINPUT_LLM_SCOPE();
+
+	// Pending changes are applied first so that the player receives the complete set
+
+	Flush();
+
+	if (auto* Settings{ GetUserSettings(LocalPlayer) })
+	{
+		const auto AppliedContexts{ GetAppliedContexts() };
+
+		if (!AppliedContexts.IsEmpty())
+		{
+			Settings->RegisterInputMappingContexts(AppliedContexts);
+		}
+	}
+}
+
+void FInputMappingContextRegistry::HandleLocalPlayerRemoved(ULocalPlayer* LocalPlayer)
+{
+	if (auto* Settings{ GetUserSettings(LocalPlayer) })
+	{
+		const auto AppliedContexts{ GetAppliedContexts() };
+
+		if (!AppliedContexts.IsEmpty())
+		{
+			Settings->UnregisterInputMappingContexts(AppliedContexts);
+		}
+	}
+}
+
+
+TSet<UInputMappingContext*> FInputMappingContextRegistry::GetAppliedContexts() const
+{
+	TSet<UInputMappingContext*> Result;
+	Result.Reserve(RegisteredContexts.Num());
+
+	for (const auto& KVP : RegisteredContexts)
+	{
+		if (KVP.Value.MappingContext)
+		{
+			Result.Add(KVP.Value.MappingContext);
+		}
+	}
+
+	return Result;
+}
+
+UEnhancedInputUserSettings* FInputMappingContextRegistry::GetUserSettings(const ULocalPlayer* LocalPlayer)
+{
+	auto* EISubsystem{ LocalPlayer ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer) : nullptr };
+
+	return EISubsystem ? EISubsystem->GetUserSettings() : nullptr;
+}
+
+
+void FInputMappingContextRegistry::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (auto& KVP : RegisteredContexts)
+	{
+		Collector.AddReferencedObject(KVP.Value.MappingContext);
+	}
+
+	for (auto& KVP : PendingRemovals)
+	{
+		Collector.AddReferencedObject(KVP.Value);
+	}
+}
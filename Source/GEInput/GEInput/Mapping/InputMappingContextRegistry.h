@@ -0,0 +1,111 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UInputMappingContext;
+class UEnhancedInputUserSettings;
+class UGameInstance;
+class ULocalPlayer;
+
+
+/**
+ * Registers the mapping contexts of all game features with the EnhancedInput user settings of every local player
+ *
+ * Tips:
+ *	Registrations are reference counted by mapping context, so contexts shared by several features are registered once.
+ *	Changes are applied immediately in one pass over the game instances and local players.
+ *	With "GEInput.MappingRegistry.Deferred 1" they are collected and applied on the next tick instead,
+ *	which turns the registration of many features during startup into a single update per player.
+ *	Activating a feature flushes the pending changes so that its mapping contexts are registered before they are added to the players.
+ *	Started and shut down by the module so that it is available before the first game feature is registered.
+ */
+class GEINPUT_API FInputMappingContextRegistry : public FGCObject
+{
+public:
+	static void Startup();
+	static void Shutdown();
+
+	/**
+	 * Returns the registry, or nullptr if the module is not started
+	 */
+	static FInputMappingContextRegistry* Get();
+
+protected:
+	FInputMappingContextRegistry();
+	virtual ~FInputMappingContextRegistry();
+
+protected:
+	struct FRegisteredContext
+	{
+		//
+		// Loaded mapping context, set once it is registered with the user settings
+		//
+		TObjectPtr<UInputMappingContext> MappingContext;
+
+		int32 RefCount{ 0 };
+	};
+
+	TMap<FSoftObjectPath, FRegisteredContext> RegisteredContexts;
+
+	//
+	// Mapping contexts registered by each owner
+	//
+	TMap<TObjectKey<UObject>, TArray<FSoftObjectPath>> ContextsByOwner;
+
+	//
+	// Changes not yet applied to the user settings
+	//
+	TSet<FSoftObjectPath> PendingAdditions;
+	TMap<FSoftObjectPath, TObjectPtr<UInputMappingContext>> PendingRemovals;
+
+	FDelegateHandle StartGameInstanceHandle;
+	FTSTicker::FDelegateHandle FlushTickerHandle;
+
+public:
+	/**
+	 * Adds the mapping contexts of the owner to the user settings of every local player on the next flush
+	 */
+	void RegisterMappingContexts(const UObject* Owner, TConstArrayView<TSoftObjectPtr<UInputMappingContext>> MappingContexts);
+
+	/**
+	 * Removes the mapping contexts registered by the owner that are not registered by anyone else on the next flush
+	 */
+	void UnregisterMappingContexts(const UObject* Owner);
+
+	/**
+	 * Loads the pending mapping contexts and applies all pending changes to the user settings
+	 */
+	void Flush();
+
+	int32 GetNumRegisteredContexts() const { return RegisteredContexts.Num(); }
+	int32 GetNumPendingChanges() const { return PendingAdditions.Num() + PendingRemovals.Num(); }
+
+protected:
+	void AddReference(const FSoftObjectPath& Path);
+	void RemoveReference(const FSoftObjectPath& Path);
+
+	void RequestFlush();
+	bool HandleFlushTicker(float DeltaTime);
+
+	void HandleStartGameInstance(UGameInstance* GameInstance);
+	void HandleLocalPlayerAdded(ULocalPlayer* LocalPlayer);
+	void HandleLocalPlayerRemoved(ULocalPlayer* LocalPlayer);
+
+	/**
+	 * Returns the mapping contexts registered with the user settings
+	 */
+	TSet<UInputMappingContext*> GetAppliedContexts() const;
+
+	static UEnhancedInputUserSettings* GetUserSettings(const ULocalPlayer* LocalPlayer);
+
+public:
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FInputMappingContextRegistry"); }
+
+};
@@ -3,6 +3,17 @@
 #include "InputProcessor.h"
 
 #include "InputProcessComponent.h"
+#include "Intent/InputIntentBus.h"
+#include "GEInputTrace.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+
+#include "Engine/World.h"
+
+#if WITH_EDITOR
+#include "InputAction.h"
+#include "Misc/DataValidation.h"
+#endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessor)
 
@@ -13,79 +24,386 @@ UInputProcessor::UInputProcessor(const FObjectInitializer& ObjectInitializer)
 }
 
 
+#if WITH_EDITOR
+namespace GEInputValidation
+{
+	static int32 MaxPerFrameBindings{ 8 };
+	static FAutoConsoleVariableRef CVarMaxPerFrameBindings(
+		TEXT("GEInput.Validation.MaxPerFrameBindings"),
+		MaxPerFrameBindings,
+		TEXT("Number of Triggered and Ongoing bindings of an input processor above which data validation warns."));
+
+	/**
+	 * Returns true if the Triggered event of the digital action is dispatched every frame while it is held
+	 */
+	static bool IsTriggeredEveryFrame(const UInputAction* InputAction)
+	{
+		for (const auto& Trigger : InputAction->Triggers)
+		{
+			if (Trigger && !Trigger->IsA<UInputTriggerDown>())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+#define LOCTEXT_NAMESPACE "InputProcessor"
+
+EDataValidationResult UInputProcessor::IsDataValid(FDataValidationContext& Context) const
+{
+	const auto Result{ CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid) };
+
+	// Cost warnings do not invalidate the asset
+
+	const auto Estimate{ EstimateDispatchCost() };
+
+	for (const auto& InputTag : Estimate.DigitalPerFrameTags)
+	{
+		Context.AddWarning(FText::Format(LOCTEXT("DigitalPerFrameBinding", "{0} is a digital action bound with Triggered or Ongoing, which dispatch every frame while it is held. Bind Started or add a Pressed trigger to the action instead."),
+			FText::FromString(InputTag.ToString())));
+	}
+
+	if (Estimate.NumPerFrameBindings > GetMaxPerFrameBindings())
+	{
+		Context.AddWarning(FText::Format(LOCTEXT("TooManyPerFrameBindings", "{0} bindings ({1} actions x Triggered/Ongoing) can dispatch every frame, above the budget of {2}."),
+			Estimate.NumPerFrameBindings, Estimate.NumBoundActions, GetMaxPerFrameBindings()));
+	}
+
+	return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
+
+FInputProcessorCostEstimate UInputProcessor::EstimateDispatchCost() const
+{
+	FInputProcessorCostEstimate Estimate;
+
+	const auto NumEvents{ static_cast<int32>(FMath::CountBits(GetBoundTriggerEvents())) };
+	const auto NumPerFrameEvents{ static_cast<int32>(bBind_Triggered) + static_cast<int32>(bBind_Ongoing) };
+
+	for (const auto& KVP : InputActions)
+	{
+		const auto& InputTag{ KVP.Key };
+		const auto* InputAction{ KVP.Value.Get() };
+
+		if (!InputAction || !InputTag.IsValid())
+		{
+			continue;
+		}
+
+		Estimate.NumBoundActions++;
+		Estimate.NumBindings += NumEvents;
+		Estimate.NumPerFrameBindings += NumPerFrameEvents;
+
+		// Ongoing always repeats, Triggered only with the implicit Down trigger
+
+		if ((InputAction->ValueType == EInputActionValueType::Boolean) && (bBind_Ongoing || (bBind_Triggered && GEInputValidation::IsTriggeredEveryFrame(InputAction))))
+		{
+			Estimate.DigitalPerFrameTags.Add(InputTag);
+		}
+	}
+
+	return Estimate;
+}
+
+int32 UInputProcessor::GetMaxPerFrameBindings()
+{
+	return GEInputValidation::MaxPerFrameBindings;
+}
+#endif
+
+
 void UInputProcessor::Initialize(UInputProcessComponent* InputComponent)
 {
+	GEINPUT_LLM_SCOPE();
+
 	check(InputComponent);
+
+	OwningInputComponent = InputComponent;
 	
 	for (const auto& KVP : InputActions)
+	{
+		BindInputAction(InputComponent, KVP.Value, KVP.Key);
+	}
+
+	OnInitialized(InputComponent);
+}
+
+void UInputProcessor::Deinitialize(UInputProcessComponent* InputComponent)
+{
+	OnDeinitialize(InputComponent);
+
+	if (InputComponent)
+	{
+		InputComponent->ClearBindingsForObject(this);
+	}
+
+	SubscribedInputActions.Reset();
+	SubscribedBindingHandles.Reset();
+
+	OwningInputComponent.Reset();
+}
+
+void UInputProcessor::BindSubscribedInputActions(UInputProcessComponent* InputComponent, const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& InputActionsByTag)
+{
+	GEINPUT_LLM_SCOPE();
+
+	check(InputComponent);
+
+	for (const auto& Handle : SubscribedBindingHandles)
+	{
+		InputComponent->RemoveBindingByHandle(Handle);
+	}
+
+	SubscribedBindingHandles.Reset();
+	SubscribedInputActions.Reset();
+
+	if (SubscribedInputTags.IsEmpty())
+	{
+		return;
+	}
+
+	for (const auto& KVP : InputActionsByTag)
 	{
 		const auto& InputTag{ KVP.Key };
-		const auto& InputAction{ KVP.Value };
 
-		if (InputAction && InputTag.IsValid())
+		if (InputTag.MatchesAny(SubscribedInputTags) && !InputActions.Contains(InputTag))
 		{
-			if (bBind_Triggered)
-			{
-				InputComponent->BindAction(InputAction, ETriggerEvent::Triggered, this, &ThisClass::HandleTriggered, InputTag);
-			}
+			SubscribedInputActions.Add(InputTag, KVP.Value);
 
-			if (bBind_Started)
-			{
-				InputComponent->BindAction(InputAction, ETriggerEvent::Started, this, &ThisClass::HandleStarted, InputTag);
-			}
+			BindInputAction(InputComponent, KVP.Value, InputTag, &SubscribedBindingHandles);
+		}
+	}
+}
 
-			if (bBind_Ongoing)
-			{
-				InputComponent->BindAction(InputAction, ETriggerEvent::Ongoing, this, &ThisClass::HandleOngoing, InputTag);
-			}
+void UInputProcessor::BindInputAction(UInputProcessComponent* InputComponent, const UInputAction* InputAction, const FGameplayTag& InputTag, TArray<uint32>* OutHandles)
+{
+	if (!InputAction || !InputTag.IsValid())
+	{
+		return;
+	}
 
-			if (bBind_Canceled)
+	const auto AddHandle
+	{
+		[OutHandles](const FEnhancedInputActionEventBinding& Binding)
+		{
+			if (OutHandles)
 			{
-				InputComponent->BindAction(InputAction, ETriggerEvent::Canceled, this, &ThisClass::HandleCanceled, InputTag);
+				OutHandles->Add(Binding.GetHandle());
 			}
+		}
+	};
 
-			if (bBind_Complete)
-			{
-				InputComponent->BindAction(InputAction, ETriggerEvent::Completed, this, &ThisClass::HandleComplete, InputTag);
-			}
+	if (bBind_Triggered)
+	{
+		AddHandle(InputComponent->BindAction(InputAction, ETriggerEvent::Triggered, this, &ThisClass::HandleTriggered, InputTag));
+	}
+
+	if (bBind_Started)
+	{
+		AddHandle(InputComponent->BindAction(InputAction, ETriggerEvent::Started, this, &ThisClass::HandleStarted, InputTag));
+	}
+
+	if (bBind_Ongoing)
+	{
+		AddHandle(InputComponent->BindAction(InputAction, ETriggerEvent::Ongoing, this, &ThisClass::HandleOngoing, InputTag));
+	}
+
+	if (bBind_Canceled)
+	{
+		AddHandle(InputComponent->BindAction(InputAction, ETriggerEvent::Canceled, this, &ThisClass::HandleCanceled, InputTag));
+	}
+
+	if (bBind_Complete)
+	{
+		AddHandle(InputComponent->BindAction(InputAction, ETriggerEvent::Completed, this, &ThisClass::HandleComplete, InputTag));
+	}
+}
+
+
+float UInputProcessor::GetSimulationDeltaSeconds() const
+{
+	if (FixedSimulationRate > 0.0f)
+	{
+		return 1.0f / FixedSimulationRate;
+	}
+
+	const auto* World{ GetWorld() };
+	return World ? World->GetDeltaSeconds() : 0.0f;
+}
+
+
+void UInputProcessor::PublishIntent(const FInputIntent& Intent) const
+{
+	if (auto* InputComponent{ OwningInputComponent.Get() })
+	{
+		if (auto* Bus{ InputComponent->GetInputIntentBus() })
+		{
+			Bus->Publish(Intent);
 		}
 	}
+}
 
-	OnInitialized(InputComponent);
+
+void UInputProcessor::ScheduleDeferredWork(int32 WorkId)
+{
+	if (auto* InputComponent{ OwningInputComponent.Get() })
+	{
+		InputComponent->ScheduleDeferredWork(this, WorkId, DeferredWorkPriority);
+	}
+	else
+	{
+		ExecuteDeferredWork(WorkId);
+	}
 }
 
-void UInputProcessor::Deinitialize(UInputProcessComponent* InputComponent)
+void UInputProcessor::ExecuteDeferredWork(int32 WorkId)
 {
-	OnDeinitialize(InputComponent);
+	GEINPUT_TRACE_CPUSCOPE(GEInput_ExecuteDeferredWork);
 
-	if (InputComponent)
+#if !UE_BUILD_SHIPPING
+	FInputProcessorDebugStats::FScope DebugStatsScope(GEInputDebug::IsCollectingProcessorStats() ? &DebugStats : nullptr);
+#endif
+
+	OnDeferredWork(WorkId);
+}
+
+
+bool UInputProcessor::IsBoundTo(const FGameplayTag& InputTag, ETriggerEvent TriggerEvent) const
+{
+	const auto* InputAction{ InputActions.Find(InputTag) };
+
+	if (!InputAction || !(*InputAction))
 	{
-		InputComponent->ClearBindingsForObject(this);
+		const auto* SubscribedInputAction{ SubscribedInputActions.Find(InputTag) };
+
+		if (!SubscribedInputAction || !(*SubscribedInputAction))
+		{
+			return false;
+		}
+	}
+
+	return (GetBoundTriggerEvents() & static_cast<uint8>(TriggerEvent)) != 0;
+}
+
+uint8 UInputProcessor::GetBoundTriggerEvents() const
+{
+	uint8 TriggerEvents{ 0 };
+	TriggerEvents |= bBind_Triggered ? static_cast<uint8>(ETriggerEvent::Triggered) : 0;
+	TriggerEvents |= bBind_Started ? static_cast<uint8>(ETriggerEvent::Started) : 0;
+	TriggerEvents |= bBind_Ongoing ? static_cast<uint8>(ETriggerEvent::Ongoing) : 0;
+	TriggerEvents |= bBind_Canceled ? static_cast<uint8>(ETriggerEvent::Canceled) : 0;
+	TriggerEvents |= bBind_Complete ? static_cast<uint8>(ETriggerEvent::Completed) : 0;
+	return TriggerEvents;
+}
+
+void UInputProcessor::ProcessInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GEInput_DispatchInputEvent);
+	GEINPUT_TRACE_PROCESSOR_SCOPE(GetClass(), InputTag, TriggerEvent);
+
+#if !UE_BUILD_SHIPPING
+	FInputProcessorDebugStats::FScope DebugStatsScope(GEInputDebug::IsCollectingProcessorStats() ? &DebugStats : nullptr);
+#endif
+
+	GEInputStats::RecordDispatchedEvent(TriggerEvent);
+
+	switch (TriggerEvent)
+	{
+	case ETriggerEvent::Triggered:
+		OnTriggered(InputTag, InputActionValue);
+		break;
+
+	case ETriggerEvent::Started:
+		OnStarted(InputTag, InputActionValue);
+		break;
+
+	case ETriggerEvent::Ongoing:
+		OnOngoing(InputTag, InputActionValue);
+		break;
+
+	case ETriggerEvent::Canceled:
+		OnCanceled(InputTag, InputActionValue);
+		break;
+
+	case ETriggerEvent::Completed:
+		OnComplete(InputTag, InputActionValue);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UInputProcessor::DispatchInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	if (auto* InputComponent{ OwningInputComponent.Get() })
+	{
+		InputComponent->DispatchInputEvent(this, TriggerEvent, InputTag, InputActionValue);
+	}
+	else
+	{
+		ProcessInputEvent(TriggerEvent, InputTag, InputActionValue);
 	}
 }
 
 
 void UInputProcessor::HandleTriggered(const FInputActionValue& InputActionValue, FGameplayTag InputTag)
 {
-	OnTriggered(InputTag, InputActionValue);
+	DispatchInputEvent(ETriggerEvent::Triggered, InputTag, InputActionValue);
 }
 
 void UInputProcessor::HandleStarted(const FInputActionValue& InputActionValue, FGameplayTag InputTag)
 {
-	OnStarted(InputTag, InputActionValue);
+	DispatchInputEvent(ETriggerEvent::Started, InputTag, InputActionValue);
 }
 
 void UInputProcessor::HandleOngoing(const FInputActionValue& InputActionValue, FGameplayTag InputTag)
 {
-	OnOngoing(InputTag, InputActionValue);
+	DispatchInputEvent(ETriggerEvent::Ongoing, InputTag, InputActionValue);
 }
 
 void UInputProcessor::HandleCanceled(const FInputActionValue& InputActionValue, FGameplayTag InputTag)
 {
-	OnCanceled(InputTag, InputActionValue);
+	DispatchInputEvent(ETriggerEvent::Canceled, InputTag, InputActionValue);
 }
 
 void UInputProcessor::HandleComplete(const FInputActionValue& InputActionValue, FGameplayTag InputTag)
 {
-	OnComplete(InputTag, InputActionValue);
+	DispatchInputEvent(ETriggerEvent::Completed, InputTag, InputActionValue);
+}
+
+
+#if !UE_BUILD_SHIPPING
+void UInputProcessor::SimulateBoundInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	switch (TriggerEvent)
+	{
+	case ETriggerEvent::Triggered:
+		HandleTriggered(InputActionValue, InputTag);
+		break;
+
+	case ETriggerEvent::Started:
+		HandleStarted(InputActionValue, InputTag);
+		break;
+
+	case ETriggerEvent::Ongoing:
+		HandleOngoing(InputActionValue, InputTag);
+		break;
+
+	case ETriggerEvent::Canceled:
+		HandleCanceled(InputActionValue, InputTag);
+		break;
+
+	case ETriggerEvent::Completed:
+		HandleComplete(InputActionValue, InputTag);
+		break;
+
+	default:
+		break;
+	}
 }
+#endif
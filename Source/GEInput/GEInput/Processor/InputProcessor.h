@@ -3,6 +3,14 @@
 #pragma once
 
 #include "GameplayTagContainer.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+
+#include "Processor/InputProcessorState.h"
+#include "Processor/InputProcessorCost.h"
+#include "Intent/InputIntentTypes.h"
+#include "Filter/InputFilter.h"
+#include "Development/InputProcessorDebug.h"
 
 #include "InputProcessor.generated.h"
 
@@ -20,6 +28,23 @@ class GEINPUT_API UInputProcessor : public UObject
 public:
 	UInputProcessor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	////////////////////////////////////////////////////////////
+	// Editor Only
+public:
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+
+	/**
+	 * Estimates the per-frame dispatch cost of the bindings of this processor
+	 */
+	FInputProcessorCostEstimate EstimateDispatchCost() const;
+
+	/**
+	 * Returns the number of per-frame bindings above which validation warns, set by GEInput.Validation.MaxPerFrameBindings
+	 */
+	static int32 GetMaxPerFrameBindings();
+#endif
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Input Process", meta = (ForceInlineRow, Categories = "Input"))
 	TMap<FGameplayTag, TObjectPtr<UInputAction>> InputActions;
@@ -39,10 +64,171 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Bind")
 	bool bBind_Complete{ true };
 
+	//
+	// Parent tags whose child tags are all delivered to this processor (e.g. Input.Ability).
+	// The input actions mapped to the child tags in the player's mapping contexts (by the input tag of their keybind settings)
+	// are bound with the trigger events enabled in the Bind category, events of other processors and injected input are delivered too.
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Bind", meta = (Categories = "Input"))
+	FGameplayTagContainer SubscribedInputTags;
+
+	//
+	// If true, the owning client sends the input of this processor to the server
+	// and the server runs an instance of this processor too
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Replication")
+	bool bRunOnServer{ false };
+
+	//
+	// If true, events of tags under Input.Gamepad or Input.MouseAndKeyboard are only dispatched
+	// while that device family is the player's active device
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Device")
+	bool bDispatchActiveDeviceOnly{ false };
+
+	//
+	// Rate in Hz at which this processor receives input, independent of the frame rate.
+	// Input is resampled and delivered at each simulation step. 0 delivers every event immediately.
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Simulation", meta = (ClampMin = 0, Units = "Hertz"))
+	float FixedSimulationRate{ 0.0f };
+
+	//
+	// Input tags whose values are summed between simulation steps (e.g. mouse deltas), other tags hold their latest value
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Simulation", meta = (Categories = "Input"))
+	FGameplayTagContainer AccumulatedInputTags;
+
+	//
+	// Priority of the deferred work of this processor, higher priority work runs first when the frame budget is exceeded
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Input Process|Deferred Work")
+	int32 DeferredWorkPriority{ 0 };
+
+	//
+	// Filters applied in order to the values of each input tag before they are dispatched to this processor, added natively with AddInputFilter
+	//
+	TMap<FGameplayTag, TArray<TSharedRef<const FInputFilter>, TInlineAllocator<2>>> InputFilters;
+
+protected:
+	/**
+	 * Adds a side effect free filter applied to the values of the input tag in the parallel filter stage.
+	 * Call from the constructor of native processors.
+	 */
+	template<typename TFilter, typename... TArgs>
+	void AddInputFilter(const FGameplayTag& InputTag, TArgs&&... Args)
+	{
+		InputFilters.FindOrAdd(InputTag).Add(MakeShared<TFilter>(Forward<TArgs>(Args)...));
+	}
+
+	//
+	// Component that this processor is bound to
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UInputProcessComponent> OwningInputComponent;
+
+	//
+	// Input actions bound for the child tags of SubscribedInputTags
+	//
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, TObjectPtr<const UInputAction>> SubscribedInputActions;
+
+	TArray<uint32> SubscribedBindingHandles;
+
 public:
 	void Initialize(UInputProcessComponent* InputComponent);
 	void Deinitialize(UInputProcessComponent* InputComponent);
 
+	/**
+	 * Replaces the bindings of the subscribed child tags with the input actions of the tags that match SubscribedInputTags.
+	 * Tags already bound by InputActions are skipped.
+	 */
+	void BindSubscribedInputActions(UInputProcessComponent* InputComponent, const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& InputActionsByTag);
+
+	/**
+	 * Returns true if this processor binds the input tag with the trigger event
+	 */
+	bool IsBoundTo(const FGameplayTag& InputTag, ETriggerEvent TriggerEvent) const;
+
+	/**
+	 * Returns the trigger events enabled in the Bind category as ETriggerEvent flags
+	 */
+	uint8 GetBoundTriggerEvents() const;
+
+	/**
+	 * Returns the input actions bound by this processor and their input tags
+	 */
+	const TMap<FGameplayTag, TObjectPtr<UInputAction>>& GetInputActions() const { return InputActions; }
+
+	const FGameplayTagContainer& GetSubscribedInputTags() const { return SubscribedInputTags; }
+
+	/**
+	 * Returns the input actions bound for the subscribed child tags and their input tags
+	 */
+	const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& GetSubscribedInputActions() const { return SubscribedInputActions; }
+
+	bool ShouldRunOnServer() const { return bRunOnServer; }
+
+	bool ShouldDispatchActiveDeviceOnly() const { return bDispatchActiveDeviceOnly; }
+
+	float GetFixedSimulationRate() const { return FixedSimulationRate; }
+
+	const TMap<FGameplayTag, TArray<TSharedRef<const FInputFilter>, TInlineAllocator<2>>>& GetInputFilters() const { return InputFilters; }
+
+	bool ShouldAccumulateInput(const FGameplayTag& InputTag) const { return AccumulatedInputTags.HasTagExact(InputTag); }
+
+	/**
+	 * Returns the time step the current input applies to, the fixed step if the processor runs at a fixed rate
+	 */
+	UFUNCTION(BlueprintPure, Category = "Process")
+	float GetSimulationDeltaSeconds() const;
+
+	/**
+	 * Publishes the intent on the intent bus of the player owning this processor.
+	 * Does nothing when the owner is not controlled by a local player.
+	 */
+	void PublishIntent(const FInputIntent& Intent) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Process", meta = (DisplayName = "Publish Intent"))
+	void K2_PublishIntent(FGameplayTag IntentTag, FVector Value, int32 Data = 0) { PublishIntent(FInputIntent(IntentTag, Value, Data)); }
+
+	/**
+	 * Queues expensive work (e.g. traces or target selection) to run in the component tick within the frame budget.
+	 * OnDeferredWork is called with the work id once, however many times it was scheduled before running.
+	 * 
+	 * Tips:
+	 *	Runs immediately if the processor is not bound to a component.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Process")
+	void ScheduleDeferredWork(int32 WorkId = 0);
+
+	/**
+	 * Called by UInputProcessComponent to run scheduled work
+	 */
+	void ExecuteDeferredWork(int32 WorkId);
+
+	/**
+	 * Executes the process corresponding to the trigger event.
+	 * 
+	 * Tips:
+	 *	Normally called from UInputProcessComponent::DispatchInputEvent
+	 */
+	void ProcessInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	/**
+	 * Returns the plain-old-data state saved and restored by UInputProcessComponent snapshots.
+	 * 
+	 * Tips:
+	 *	The view must point to memory owned by this processor and keep the same size while the processor is initialized.
+	 *	Use FInputProcessorStateView::Make on a struct member.
+	 */
+	virtual FInputProcessorStateView GetStateView() { return FInputProcessorStateView(); }
+
+	/**
+	 * Called after the state has been restored from a snapshot
+	 */
+	virtual void PostRestoreState() {}
+
 protected:
 	UFUNCTION(BlueprintNativeEvent, Category = "Initialization")
 	void OnInitialized(UInputProcessComponent* InputComponent);
@@ -54,12 +240,22 @@ protected:
 
 
 protected:
+	/**
+	 * Binds the input action with the trigger events enabled in the Bind category and adds the handles of the bindings
+	 */
+	void BindInputAction(UInputProcessComponent* InputComponent, const UInputAction* InputAction, const FGameplayTag& InputTag, TArray<uint32>* OutHandles = nullptr);
+
 	void HandleTriggered(const FInputActionValue& InputActionValue, FGameplayTag InputTag);
 	void HandleStarted(const FInputActionValue& InputActionValue, FGameplayTag InputTag);
 	void HandleOngoing(const FInputActionValue& InputActionValue, FGameplayTag InputTag);
 	void HandleCanceled(const FInputActionValue& InputActionValue, FGameplayTag InputTag);
 	void HandleComplete(const FInputActionValue& InputActionValue, FGameplayTag InputTag);
 
+	/**
+	 * Passes the event received from the bound action to the owning component
+	 */
+	void DispatchInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
 	UFUNCTION(BlueprintNativeEvent, Category = "Process")
 	void OnTriggered(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
 	virtual void OnTriggered_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) {}
@@ -80,4 +276,23 @@ protected:
 	void OnComplete(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
 	virtual void OnComplete_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue) {}
 
+	UFUNCTION(BlueprintNativeEvent, Category = "Process")
+	void OnDeferredWork(int32 WorkId);
+	virtual void OnDeferredWork_Implementation(int32 WorkId) {}
+
+
+#if !UE_BUILD_SHIPPING
+protected:
+	FInputProcessorDebugStats DebugStats;
+
+public:
+	FInputProcessorDebugStats& GetDebugStats() { return DebugStats; }
+
+	/**
+	 * Passes the event through the handler bound to the input action, as if EnhancedInput had triggered it.
+	 * Used by benchmarks and tests to measure the same path as live input.
+	 */
+	void SimulateBoundInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+#endif
+
 };
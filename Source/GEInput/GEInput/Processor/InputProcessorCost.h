@@ -0,0 +1,43 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+
+/**
+ * Estimated dispatch cost of an input processor, computed from its bindings at authoring time
+ *
+ * Tips:
+ *	Triggered and Ongoing events can be dispatched every frame while their action is held,
+ *	the other trigger events are dispatched once per press.
+ */
+struct GEINPUT_API FInputProcessorCostEstimate
+{
+public:
+	//
+	// Number of valid input actions
+	//
+	int32 NumBoundActions{ 0 };
+
+	//
+	// Number of action and trigger event pairs bound to the component
+	//
+	int32 NumBindings{ 0 };
+
+	//
+	// Number of bindings that can be dispatched every frame
+	//
+	int32 NumPerFrameBindings{ 0 };
+
+	//
+	// Input tags of digital actions bound with per-frame trigger events
+	//
+	TArray<FGameplayTag> DigitalPerFrameTags;
+
+public:
+	/**
+	 * Returns the worst case number of events dispatched in a frame in which every action is held
+	 */
+	int32 GetMaxEventsPerFrame() const { return NumPerFrameBindings; }
+};
@@ -0,0 +1,36 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <type_traits>
+
+
+/**
+ * View of the plain-old-data state of a processor saved in UInputProcessComponent snapshots
+ *
+ * Tips:
+ *	The state is copied with memcpy, so it must not contain pointers to heap memory or UObjects.
+ */
+struct FInputProcessorStateView
+{
+public:
+	FInputProcessorStateView() {}
+	FInputProcessorStateView(void* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+public:
+	void* Data{ nullptr };
+
+	int32 Size{ 0 };
+
+public:
+	bool IsValid() const { return Data && (Size > 0); }
+
+	template<typename T>
+	static FInputProcessorStateView Make(T& State)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Processor snapshot state must be trivially copyable");
+		return FInputProcessorStateView(&State, sizeof(T));
+	}
+};
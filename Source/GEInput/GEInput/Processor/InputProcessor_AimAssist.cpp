@@ -0,0 +1,203 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "InputProcessor_AimAssist.h"
+
+#include "AimAssist/AimAssistTargetComponent.h"
+#include "AimAssist/AimAssistTargetSubsystem.h"
+
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessor_AimAssist)
+
+
+UInputProcessor_AimAssist::UInputProcessor_AimAssist(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+void UInputProcessor_AimAssist::OnInitialized_Implementation(UInputProcessComponent* InputComponent)
+{
+	Super::OnInitialized_Implementation(InputComponent);
+
+	Candidates.Reset();
+	LastCandidateRefreshTime = -1.0;
+}
+
+void UInputProcessor_AimAssist::OnDeinitialize_Implementation(UInputProcessComponent* InputComponent)
+{
+	Candidates.Reset();
+
+	Super::OnDeinitialize_Implementation(InputComponent);
+}
+
+void UInputProcessor_AimAssist::OnDeferredWork_Implementation(int32 WorkId)
+{
+	if (WorkId == WorkId_RefreshCandidates)
+	{
+		RefreshCandidates();
+	}
+}
+
+
+void UInputProcessor_AimAssist::Input_LookPad(const FInputActionValue& InputActionValue)
+{
+	auto Value{ InputActionValue.Get<FVector2D>() };
+
+	// Candidates are refreshed in the component tick within the deferred work budget
+
+	const auto* World{ GetWorld() };
+	const auto Now{ World ? World->GetTimeSeconds() : 0.0 };
+
+	if ((LastCandidateRefreshTime < 0.0) || ((Now - LastCandidateRefreshTime) >= (1.0 / CandidateRefreshRate)))
+	{
+		ScheduleDeferredWork(WorkId_RefreshCandidates);
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+
+	if (Value.IsNearlyZero() || Candidates.IsEmpty() || !GetViewPoint(ViewLocation, ViewRotation))
+	{
+		Super::Input_LookPad(InputActionValue);
+		return;
+	}
+
+	// Find the candidate closest to the view direction relative to its angular size
+
+	const auto ViewDirection{ ViewRotation.Vector() };
+
+	auto BestNormalizedAngle{ TNumericLimits<double>::Max() };
+	auto BestToTarget{ FVector::ZeroVector };
+
+	for (const auto& Candidate : Candidates)
+	{
+		const auto* Target{ Candidate.Get() };
+
+		if (!Target || !Target->IsAimAssistEnabled())
+		{
+			continue;
+		}
+
+		const auto ToTarget{ Target->GetComponentLocation() - ViewLocation };
+		const auto Distance{ ToTarget.Size() };
+
+		if ((Distance <= UE_KINDA_SMALL_NUMBER) || (Distance > MaxTargetDistance))
+		{
+			continue;
+		}
+
+		const auto Angle{ FMath::Acos(FMath::Clamp(FVector::DotProduct(ViewDirection, ToTarget / Distance), -1.0, 1.0)) };
+		const auto AngularRadius{ FMath::Atan2(static_cast<double>(Target->GetTargetRadius()), Distance) };
+		const auto NormalizedAngle{ Angle / AngularRadius };
+
+		if (NormalizedAngle < BestNormalizedAngle)
+		{
+			BestNormalizedAngle = NormalizedAngle;
+			BestToTarget = ToTarget;
+		}
+	}
+
+	// Friction slows the look down near the target
+
+	if (BestNormalizedAngle < FrictionRadiusScale)
+	{
+		Value *= FMath::Lerp(static_cast<double>(FrictionScale), 1.0, BestNormalizedAngle / FrictionRadiusScale);
+	}
+
+	Super::Input_LookPad(FInputActionValue(Value));
+
+	// Magnetism pulls the view towards the target while the player is looking.
+	// Applied to the control rotation directly so that it does not depend on the input scales.
+
+	if ((BestNormalizedAngle < MagnetismRadiusScale) && Pawn.IsValid())
+	{
+		if (auto* Controller{ Pawn->GetController() })
+		{
+			const auto Alpha{ FMath::Clamp(MagnetismStrength * GetSimulationDeltaSeconds() * (1.0 - BestNormalizedAngle / MagnetismRadiusScale), 0.0, 1.0) };
+			const auto DeltaRotation{ (BestToTarget.Rotation() - ViewRotation).GetNormalized() };
+
+			Controller->SetControlRotation(Controller->GetControlRotation() + FRotator(DeltaRotation.Pitch * Alpha, DeltaRotation.Yaw * Alpha, 0.0));
+		}
+	}
+}
+
+bool UInputProcessor_AimAssist::CanTarget(const UAimAssistTargetComponent* Target) const
+{
+	return Target->GetOwner() != Pawn.Get();
+}
+
+bool UInputProcessor_AimAssist::GetViewPoint(FVector& OutLocation, FRotator& OutRotation) const
+{
+	const auto* Controller{ Pawn.IsValid() ? Pawn->GetController() : nullptr };
+
+	if (!Controller)
+	{
+		return false;
+	}
+
+	Controller->GetPlayerViewPoint(OutLocation, OutRotation);
+	return true;
+}
+
+void UInputProcessor_AimAssist::RefreshCandidates()
+{
+	auto* World{ GetWorld() };
+
+	LastCandidateRefreshTime = World ? World->GetTimeSeconds() : 0.0;
+
+	Candidates.Reset();
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+
+	auto* Subsystem{ UWorld::GetSubsystem<UAimAssistTargetSubsystem>(World) };
+
+	if (!Subsystem || !GetViewPoint(ViewLocation, ViewRotation))
+	{
+		return;
+	}
+
+	const auto ViewDirection{ ViewRotation.Vector() };
+	const auto MinDot{ FMath::Cos(FMath::DegreesToRadians(CandidateConeAngle)) };
+
+	// Keep the candidates closest to the view direction
+
+	TArray<TPair<double, UAimAssistTargetComponent*>, TInlineAllocator<MaxCandidates>> Best;
+
+	Subsystem->ForEachTargetInRadius(ViewLocation, MaxTargetDistance,
+		[&](UAimAssistTargetComponent* Target, const FVector& Location)
+		{
+			const auto Dot{ FVector::DotProduct(ViewDirection, (Location - ViewLocation).GetSafeNormal()) };
+
+			if ((Dot < MinDot) || !CanTarget(Target))
+			{
+				return;
+			}
+
+			if (Best.Num() < MaxCandidates)
+			{
+				Best.Emplace(Dot, Target);
+				return;
+			}
+
+			auto WorstIndex{ 0 };
+
+			for (int32 Index{ 1 }; Index < Best.Num(); ++Index)
+			{
+				WorstIndex = (Best[Index].Key < Best[WorstIndex].Key) ? Index : WorstIndex;
+			}
+
+			if (Dot > Best[WorstIndex].Key)
+			{
+				Best[WorstIndex] = TPair<double, UAimAssistTargetComponent*>(Dot, Target);
+			}
+		});
+
+	for (const auto& Entry : Best)
+	{
+		Candidates.Add(Entry.Value);
+	}
+}
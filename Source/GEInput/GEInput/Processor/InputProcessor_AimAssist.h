@@ -0,0 +1,97 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "InputProcessor_MoveAndLook.h"
+
+#include "InputProcessor_AimAssist.generated.h"
+
+class UAimAssistTargetComponent;
+
+
+/**
+ * Move and look processor that adds friction and magnetism to the gamepad look near aim assist targets
+ *
+ * Tips:
+ *	Candidates are gathered from UAimAssistTargetSubsystem as deferred work at CandidateRefreshRate,
+ *	each look event only tests the cached candidates against the view.
+ */
+UCLASS()
+class GEINPUT_API UInputProcessor_AimAssist : public UInputProcessor_MoveAndLook
+{
+	GENERATED_BODY()
+public:
+	UInputProcessor_AimAssist(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	static constexpr int32 MaxCandidates{ 8 };
+	static constexpr int32 WorkId_RefreshCandidates{ 0 };
+
+	//
+	// Maximum distance in cm of targets that are assisted
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist", meta = (ClampMin = 0, Units = "Centimeters"))
+	float MaxTargetDistance{ 5000.0f };
+
+	//
+	// Half angle of the view cone in which candidates are gathered
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist", meta = (ClampMin = 0, ClampMax = 90, Units = "Degrees"))
+	float CandidateConeAngle{ 20.0f };
+
+	//
+	// Rate in Hz at which candidates are gathered from the target index
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist", meta = (ClampMin = 1, Units = "Hertz"))
+	float CandidateRefreshRate{ 10.0f };
+
+	//
+	// Size of the friction zone relative to the angular size of the target
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist|Friction", meta = (ClampMin = 0))
+	float FrictionRadiusScale{ 2.5f };
+
+	//
+	// Look input scale on the center of the target, rising to 1 at the edge of the friction zone
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist|Friction", meta = (ClampMin = 0, ClampMax = 1))
+	float FrictionScale{ 0.4f };
+
+	//
+	// Size of the magnetism zone relative to the angular size of the target
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist|Magnetism", meta = (ClampMin = 0))
+	float MagnetismRadiusScale{ 3.0f };
+
+	//
+	// Fraction of the angle to the target closed per second while looking
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Aim Assist|Magnetism", meta = (ClampMin = 0))
+	float MagnetismStrength{ 4.0f };
+
+	//
+	// Targets closest to the view direction gathered on the last refresh
+	//
+	TArray<TWeakObjectPtr<UAimAssistTargetComponent>, TInlineAllocator<MaxCandidates>> Candidates;
+
+	double LastCandidateRefreshTime{ -1.0 };
+
+public:
+	virtual void OnInitialized_Implementation(UInputProcessComponent* InputComponent) override;
+	virtual void OnDeinitialize_Implementation(UInputProcessComponent* InputComponent) override;
+
+protected:
+	virtual void OnDeferredWork_Implementation(int32 WorkId) override;
+
+	virtual void Input_LookPad(const FInputActionValue& InputActionValue) override;
+
+	/**
+	 * Returns false to exclude the target from aim assist (e.g. teammates)
+	 */
+	virtual bool CanTarget(const UAimAssistTargetComponent* Target) const;
+
+	bool GetViewPoint(FVector& OutLocation, FRotator& OutRotation) const;
+
+	void RefreshCandidates();
+
+};
@@ -4,6 +4,7 @@
 
 #include "InputProcessComponent.h"
 #include "GameplayTag/GEInputTags_Input.h"
+#include "Latency/InputLatencyTracker.h"
 
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Pawn.h"
@@ -19,11 +20,14 @@ UInputProcessor_MoveAndLook::UInputProcessor_MoveAndLook(const FObjectInitialize
 	bBind_Ongoing = false;
 	bBind_Canceled = false;
 	bBind_Complete = false;
+	bDispatchActiveDeviceOnly = true;
 
 	InputActions.Emplace(TAG_Input_Gamepad_Look, nullptr);
 	InputActions.Emplace(TAG_Input_Gamepad_Move, nullptr);
 	InputActions.Emplace(TAG_Input_MouseAndKeyboard_Look, nullptr);
 	InputActions.Emplace(TAG_Input_MouseAndKeyboard_Move, nullptr);
+
+	AccumulatedInputTags.AddTag(TAG_Input_MouseAndKeyboard_Look);
 }
 
 
@@ -44,6 +48,7 @@ void UInputProcessor_MoveAndLook::OnInitialized_Implementation(UInputProcessComp
 void UInputProcessor_MoveAndLook::OnDeinitialize_Implementation(UInputProcessComponent* InputComponent)
 {
 	Pawn.Reset();
+	PadLookFilter.Reset();
 }
 
 void UInputProcessor_MoveAndLook::OnTriggered_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
@@ -53,14 +58,26 @@ void UInputProcessor_MoveAndLook::OnTriggered_Implementation(const FGameplayTag&
 		if (InputTag == TAG_Input_Gamepad_Move || InputTag == TAG_Input_MouseAndKeyboard_Move)
 		{
 			Input_Move(InputActionValue);
+
+#if GEINPUT_LATENCY_ENABLED
+			FInputLatencyTracker::NotifyEffectPending(Pawn.Get(), EInputLatencyEffect::MovementConsumed);
+#endif
 		}
 		else if (InputTag == TAG_Input_Gamepad_Look)
 		{
-			Input_LookPad(InputActionValue);
+			Input_LookPad(FInputActionValue(PadLookFilter.Apply(InputActionValue.Get<FVector2D>(), GetSimulationDeltaSeconds())));
+
+#if GEINPUT_LATENCY_ENABLED
+			FInputLatencyTracker::NotifyEffectPending(Pawn.Get(), EInputLatencyEffect::ControlRotation);
+#endif
 		}
 		else if (InputTag == TAG_Input_MouseAndKeyboard_Look)
 		{
 			Input_LookMouse(InputActionValue);
+
+#if GEINPUT_LATENCY_ENABLED
+			FInputLatencyTracker::NotifyEffectPending(Pawn.Get(), EInputLatencyEffect::ControlRotation);
+#endif
 		}
 	}
 }
@@ -103,10 +120,7 @@ void UInputProcessor_MoveAndLook::Input_LookPad(const FInputActionValue& InputAc
 {
 	const auto Value{ InputActionValue.Get<FVector2D>() };
 
-	const auto* World{ GetWorld() };
-	check(World);
-
-	const auto DeltaSeconds{ World->GetDeltaSeconds() };
+	const auto DeltaSeconds{ GetSimulationDeltaSeconds() };
 
 	if (Value.X != 0.0f)
 	{
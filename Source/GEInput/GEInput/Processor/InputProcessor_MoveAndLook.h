@@ -4,6 +4,8 @@
 
 #include "InputProcessor.h"
 
+#include "Filter/InputFilterChain.h"
+
 #include "InputProcessor_MoveAndLook.generated.h"
 
 
@@ -24,6 +26,26 @@ protected:
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Look")
 	float PadLookPitchRate{ 165.0f };
 
+	UPROPERTY(EditDefaultsOnly, Category = "Look|Pad Filter")
+	FInputFilterStage_Deadzone PadLookDeadzone;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Look|Pad Filter")
+	FInputFilterStage_ResponseCurve PadLookResponseCurve;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Look|Pad Filter")
+	FInputFilterStage_Smoothing PadLookSmoothing;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Look|Pad Filter")
+	FInputFilterStage_Invert PadLookInvert;
+
+	//
+	// Filter applied to the gamepad look before it is handled, all stages are pass-through by default
+	//
+	TInputFilterChain<FInputFilterStage_Deadzone, FInputFilterStage_ResponseCurve, FInputFilterStage_Smoothing, FInputFilterStage_Invert> PadLookFilter
+	{
+		PadLookDeadzone, PadLookResponseCurve, PadLookSmoothing, PadLookInvert
+	};
+
 	UPROPERTY(Transient)
 	TWeakObjectPtr<APawn> Pawn;
 
@@ -36,5 +58,5 @@ protected:
 
 	void Input_Move(const FInputActionValue& InputActionValue);
 	void Input_LookMouse(const FInputActionValue& InputActionValue);
-	void Input_LookPad(const FInputActionValue& InputActionValue);
+	virtual void Input_LookPad(const FInputActionValue& InputActionValue);
 };
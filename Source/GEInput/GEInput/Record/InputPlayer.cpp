@@ -0,0 +1,199 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputPlayer.h"
+
+#include "GEInputLogs.h"
+#include "GEInputLLM.h"
+
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+
+FInputPlayer::~FInputPlayer()
+{
+	Close();
+}
+
+
+bool FInputPlayer::Open(const FString& Filename)
+{
+	GEINPUT_LLM_SCOPE();
+
+	Close();
+
+	Reader.Reset(IFileManager::Get().CreateFileReader(*Filename));
+
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("Failed to open input recording file (%s)"), *Filename);
+		return false;
+	}
+
+	// Validate stream header
+
+	uint32 Magic{ 0 };
+	uint16 Version{ 0 };
+	uint16 Flags{ 0 };
+
+	*Reader << Magic;
+	*Reader << Version;
+	*Reader << Flags;
+
+	if (Reader->IsError() || (Magic != GEInputRecord::Magic) || (Version != GEInputRecord::Version))
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("Invalid input recording file (%s)"), *Filename);
+		Close();
+		return false;
+	}
+
+	ChunkBuffer.Reset();
+	ChunkOffset = 0;
+	ChunkEventsRemaining = 0;
+	Tags.Reset();
+	PrevValues.Reset();
+
+	return true;
+}
+
+void FInputPlayer::Close()
+{
+	if (Reader.IsValid())
+	{
+		Reader->Close();
+		Reader.Reset();
+	}
+}
+
+
+bool FInputPlayer::ReadNextEvent(FInputRecordEvent& OutEvent)
+{
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	if ((ChunkEventsRemaining == 0) && !ReadNextChunk())
+	{
+		Close();
+		return false;
+	}
+
+	if (!DecodeEvent(OutEvent))
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("Input recording stream is corrupted, playback stopped"));
+		Close();
+		return false;
+	}
+
+	--ChunkEventsRemaining;
+	return true;
+}
+
+
+bool FInputPlayer::ReadNextChunk()
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (Reader->AtEnd())
+	{
+		return false;
+	}
+
+	uint32 ChunkBytes{ 0 };
+	uint32 ChunkEvents{ 0 };
+
+	*Reader << ChunkBytes;
+	*Reader << ChunkEvents;
+
+	if (Reader->IsError() || (ChunkBytes == 0) || (ChunkEvents == 0) || (ChunkBytes > static_cast<uint32>(Reader->TotalSize() - Reader->Tell())))
+	{
+		return false;
+	}
+
+	ChunkBuffer.SetNumUninitialized(ChunkBytes);
+	Reader->Serialize(ChunkBuffer.GetData(), ChunkBytes);
+
+	ChunkOffset = 0;
+	ChunkEventsRemaining = ChunkEvents;
+
+	// Reset delta state
+
+	for (auto& PrevValue : PrevValues)
+	{
+		PrevValue = FIntVector::ZeroValue;
+	}
+
+	PrevFrame = 0;
+	PrevTimeMicro = 0;
+
+	return !Reader->IsError();
+}
+
+bool FInputPlayer::DecodeEvent(FInputRecordEvent& OutEvent)
+{
+	uint64 FrameDelta{ 0 };
+	uint64 TimeDelta{ 0 };
+	uint64 TagIndex{ 0 };
+
+	if (!GEInputRecord::ReadVarUInt(ChunkBuffer, ChunkOffset, FrameDelta) ||
+		!GEInputRecord::ReadVarUInt(ChunkBuffer, ChunkOffset, TimeDelta) ||
+		!GEInputRecord::ReadVarUInt(ChunkBuffer, ChunkOffset, TagIndex))
+	{
+		return false;
+	}
+
+	// Register tag when it appears for the first time
+
+	if (TagIndex == Tags.Num())
+	{
+		uint64 NameLength{ 0 };
+		if (!GEInputRecord::ReadVarUInt(ChunkBuffer, ChunkOffset, NameLength) || ((ChunkOffset + NameLength) > static_cast<uint64>(ChunkBuffer.Num())))
+		{
+			return false;
+		}
+
+		const FString TagName{ static_cast<int32>(NameLength), reinterpret_cast<const ANSICHAR*>(ChunkBuffer.GetData() + ChunkOffset) };
+		ChunkOffset += static_cast<int32>(NameLength);
+
+		Tags.Add(FGameplayTag::RequestGameplayTag(FName(*TagName), false));
+		PrevValues.AddZeroed();
+	}
+	else if (TagIndex > static_cast<uint64>(Tags.Num()))
+	{
+		return false;
+	}
+
+	if (!ChunkBuffer.IsValidIndex(ChunkOffset))
+	{
+		return false;
+	}
+
+	const auto Header{ ChunkBuffer[ChunkOffset++] };
+	const auto ValueType{ static_cast<EInputActionValueType>((Header >> 3) & 0x3) };
+
+	FVector RawValue{ FVector::ZeroVector };
+	auto& PrevValue{ PrevValues[TagIndex] };
+
+	for (int32 Component{ 0 }; Component < GEInputRecord::GetNumComponents(ValueType); ++Component)
+	{
+		int64 Delta{ 0 };
+		if (!GEInputRecord::ReadVarInt(ChunkBuffer, ChunkOffset, Delta))
+		{
+			return false;
+		}
+
+		PrevValue[Component] = static_cast<int32>(PrevValue[Component] + Delta);
+		RawValue[Component] = GEInputRecord::Dequantize(PrevValue[Component]);
+	}
+
+	PrevFrame += static_cast<uint32>(FrameDelta);
+	PrevTimeMicro += TimeDelta;
+
+	OutEvent.Frame = PrevFrame;
+	OutEvent.Timestamp = static_cast<double>(PrevTimeMicro) / 1000000.0;
+	OutEvent.InputTag = Tags[TagIndex];
+	OutEvent.TriggerEvent = GEInputRecord::IndexToTriggerEvent(Header & 0x7);
+	OutEvent.Value = FInputActionValue(ValueType, RawValue);
+
+	return true;
+}
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Record/InputRecordTypes.h"
+
+class FArchive;
+
+
+/**
+ * Reads input events from a stream written by FInputRecorder
+ *
+ * Tips:
+ *	Only one chunk is loaded into memory at a time, the next chunk is read from disk when the current one is exhausted.
+ */
+class GEINPUT_API FInputPlayer
+{
+public:
+	FInputPlayer() {}
+	~FInputPlayer();
+
+protected:
+	TUniquePtr<FArchive> Reader;
+
+	TArray<uint8> ChunkBuffer;
+	int32 ChunkOffset{ 0 };
+	uint32 ChunkEventsRemaining{ 0 };
+
+	//
+	// Tag table shared by the whole stream
+	//
+	TArray<FGameplayTag> Tags;
+
+	//
+	// Delta decoding state reset at the start of each chunk
+	//
+	TArray<FIntVector> PrevValues;
+	uint32 PrevFrame{ 0 };
+	uint64 PrevTimeMicro{ 0 };
+
+public:
+	/**
+	 * Opens the file and validates the stream header
+	 */
+	bool Open(const FString& Filename);
+
+	void Close();
+
+	bool IsPlaying() const { return Reader.IsValid(); }
+
+	/**
+	 * Decodes the next event of the stream.
+	 * Returns false and closes the stream when the end is reached or the data is corrupted.
+	 */
+	bool ReadNextEvent(FInputRecordEvent& OutEvent);
+
+protected:
+	bool ReadNextChunk();
+	bool DecodeEvent(FInputRecordEvent& OutEvent);
+
+};
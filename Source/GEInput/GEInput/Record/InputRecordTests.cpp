@@ -0,0 +1,119 @@
+// Copyright (C) 2024 owoDra
+
+#include "Record/InputRecorder.h"
+#include "Record/InputPlayer.h"
+#include "GameplayTag/GEInputTags_Input.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputRecordRoundTripTest, "GEInput.Record.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInputRecordRoundTripTest::RunTest(const FString& Parameters)
+{
+	const auto Filename{ FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("GEInputRecordRoundTrip.bin")) };
+
+	// The smallest chunk size splits the events over many chunks, so that the tag table
+	// written in the first chunk and the delta state reset at every chunk start are both exercised
+
+	FInputRecorder Recorder(256);
+
+	if (!TestTrue(TEXT("Recording opened"), Recorder.Open(Filename)))
+	{
+		return false;
+	}
+
+	const auto StartFrame{ GFrameCounter };
+	const auto StartTime{ FPlatformTime::Seconds() };
+
+	const FGameplayTag InputTags[]{ TAG_Input_Gamepad_Move, TAG_Input_Gamepad_Look, TAG_Input_MouseAndKeyboard_Move, TAG_Input_MouseAndKeyboard_Look };
+	const EInputActionValueType ValueTypes[]{ EInputActionValueType::Axis2D, EInputActionValueType::Axis3D, EInputActionValueType::Axis1D, EInputActionValueType::Boolean };
+	const ETriggerEvent TriggerEvents[]{ ETriggerEvent::Started, ETriggerEvent::Triggered, ETriggerEvent::Ongoing, ETriggerEvent::Completed, ETriggerEvent::Canceled };
+
+	TArray<FInputRecordEvent> Expected;
+
+	for (int32 Index{ 0 }; Index < 400; ++Index)
+	{
+		const auto TagIndex{ Index % UE_ARRAY_COUNT(InputTags) };
+		const auto ValueType{ ValueTypes[TagIndex] };
+		const auto Sign{ (Index % 3 == 0) ? -1.0 : 1.0 };
+
+		auto& Event{ Expected.AddDefaulted_GetRef() };
+		Event.Frame = static_cast<uint32>(Index / 2);
+		Event.Timestamp = Event.Frame / 60.0;
+		Event.InputTag = InputTags[TagIndex];
+		Event.TriggerEvent = TriggerEvents[(Index / 4) % UE_ARRAY_COUNT(TriggerEvents)];
+		Event.Value = (ValueType == EInputActionValueType::Boolean)
+			? FInputActionValue(ValueType, FVector(Index % 2, 0.0, 0.0))
+			: FInputActionValue(ValueType, FVector(Sign * Index * 0.125, -Index * 0.5, Index * 1.75));
+
+		Recorder.RecordEvent(StartFrame + Event.Frame, StartTime + Event.Timestamp, Event.InputTag, Event.TriggerEvent, Event.Value);
+
+		// The same event delivered to another processor in the same frame is recorded once
+
+		Recorder.RecordEvent(StartFrame + Event.Frame, StartTime + Event.Timestamp, Event.InputTag, Event.TriggerEvent, Event.Value);
+	}
+
+	TestEqual(TEXT("Recorded event count"), static_cast<int32>(Recorder.GetNumRecordedEvents()), Expected.Num());
+
+	Recorder.Close();
+
+	TestTrue(TEXT("Recording spans several chunks"), IFileManager::Get().FileSize(*Filename) > 256 * 4);
+
+	// Read back and compare
+
+	FInputPlayer Player;
+
+	if (!TestTrue(TEXT("Recording opened for playback"), Player.Open(Filename)))
+	{
+		IFileManager::Get().Delete(*Filename);
+		return false;
+	}
+
+	constexpr auto ValueTolerance{ 0.5 / GEInputRecord::ValueScale };
+	constexpr auto TimeTolerance{ 0.01 };
+
+	int32 NumRead{ 0 };
+	FInputRecordEvent Event;
+
+	while (Player.ReadNextEvent(Event))
+	{
+		if (!Expected.IsValidIndex(NumRead))
+		{
+			AddError(TEXT("More events were read than recorded"));
+			break;
+		}
+
+		const auto& Source{ Expected[NumRead] };
+		const auto Context{ FString::Printf(TEXT("Event %d"), NumRead) };
+
+		TestEqual(Context + TEXT(" frame"), static_cast<int32>(Event.Frame), static_cast<int32>(Source.Frame));
+		TestEqual(Context + TEXT(" timestamp"), Event.Timestamp, Source.Timestamp, TimeTolerance);
+		TestTrue(Context + TEXT(" tag"), Event.InputTag == Source.InputTag);
+		TestTrue(Context + TEXT(" trigger event"), Event.TriggerEvent == Source.TriggerEvent);
+		TestTrue(Context + TEXT(" value type"), Event.Value.GetValueType() == Source.Value.GetValueType());
+
+		const auto Value{ Event.Value.Get<FVector>() };
+		const auto SourceValue{ Source.Value.Get<FVector>() };
+
+		for (int32 Component{ 0 }; Component < GEInputRecord::GetNumComponents(Source.Value.GetValueType()); ++Component)
+		{
+			TestEqual(FString::Printf(TEXT("%s value[%d]"), *Context, Component), Value[Component], SourceValue[Component], ValueTolerance);
+		}
+
+		++NumRead;
+	}
+
+	TestEqual(TEXT("Read event count"), NumRead, Expected.Num());
+	TestFalse(TEXT("Player closed at the end of the stream"), Player.IsPlaying());
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,155 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+
+
+/**
+ * Single input event captured by FInputRecorder or decoded by FInputPlayer
+ */
+struct GEINPUT_API FInputRecordEvent
+{
+public:
+	FInputRecordEvent() {}
+
+public:
+	//
+	// Frame number relative to the start of the recording
+	//
+	uint32 Frame{ 0 };
+
+	//
+	// Time in seconds relative to the start of the recording
+	//
+	double Timestamp{ 0.0 };
+
+	FGameplayTag InputTag;
+
+	ETriggerEvent TriggerEvent{ ETriggerEvent::None };
+
+	FInputActionValue Value;
+};
+
+
+/**
+ * Binary layout and encoding helpers shared by FInputRecorder and FInputPlayer
+ *
+ * Tips:
+ *	The stream is a file header followed by independent chunks ([uint32 Bytes][uint32 NumEvents][Payload]).
+ *	Inside a chunk, frame, time and per-tag values are delta-encoded as zigzag varints and reset at every chunk start,
+ *	so that a reader only ever needs to hold one chunk in memory.
+ */
+namespace GEInputRecord
+{
+	//
+	// Magic number at the beginning of the file ("GEIR")
+	//
+	constexpr uint32 Magic{ 0x52494547 };
+
+	//
+	// Version of the binary layout
+	//
+	constexpr uint16 Version{ 1 };
+
+	//
+	// Fixed-point scale used to quantize input values (1/1024 resolution)
+	//
+	constexpr float ValueScale{ 1024.0f };
+
+	//
+	// Default size of a chunk before it is flushed to disk
+	//
+	constexpr int32 DefaultChunkSize{ 64 * 1024 };
+
+	/**
+	 * Returns the compact index of the trigger event (0-4), or INDEX_NONE if not recordable
+	 */
+	inline int32 TriggerEventToIndex(ETriggerEvent TriggerEvent)
+	{
+		switch (TriggerEvent)
+		{
+		case ETriggerEvent::Triggered:	return 0;
+		case ETriggerEvent::Started:	return 1;
+		case ETriggerEvent::Ongoing:	return 2;
+		case ETriggerEvent::Canceled:	return 3;
+		case ETriggerEvent::Completed:	return 4;
+		default:						return INDEX_NONE;
+		}
+	}
+
+	/**
+	 * Returns the trigger event from the compact index
+	 */
+	inline ETriggerEvent IndexToTriggerEvent(int32 Index)
+	{
+		static const ETriggerEvent Events[]{ ETriggerEvent::Triggered, ETriggerEvent::Started, ETriggerEvent::Ongoing, ETriggerEvent::Canceled, ETriggerEvent::Completed };
+		return ((Index >= 0) && (Index < UE_ARRAY_COUNT(Events))) ? Events[Index] : ETriggerEvent::None;
+	}
+
+	/**
+	 * Returns number of value components stored for the value type
+	 */
+	inline int32 GetNumComponents(EInputActionValueType ValueType)
+	{
+		return FMath::Max(1, static_cast<int32>(ValueType));
+	}
+
+	inline int32 Quantize(double Value)
+	{
+		return static_cast<int32>(FMath::Clamp(FMath::RoundToDouble(Value * ValueScale), static_cast<double>(MIN_int32), static_cast<double>(MAX_int32)));
+	}
+
+	inline double Dequantize(int32 Value)
+	{
+		return static_cast<double>(Value) / ValueScale;
+	}
+
+	inline void WriteVarUInt(TArray<uint8>& Buffer, uint64 Value)
+	{
+		do
+		{
+			auto Byte{ static_cast<uint8>(Value & 0x7F) };
+			Value >>= 7;
+			Byte |= (Value != 0) ? 0x80 : 0x00;
+			Buffer.Add(Byte);
+		} while (Value != 0);
+	}
+
+	inline void WriteVarInt(TArray<uint8>& Buffer, int64 Value)
+	{
+		WriteVarUInt(Buffer, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	inline bool ReadVarUInt(const TArray<uint8>& Buffer, int32& InOutOffset, uint64& OutValue)
+	{
+		OutValue = 0;
+
+		for (int32 Shift{ 0 }; (Shift < 64) && Buffer.IsValidIndex(InOutOffset); Shift += 7)
+		{
+			const auto Byte{ Buffer[InOutOffset++] };
+			OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline bool ReadVarInt(const TArray<uint8>& Buffer, int32& InOutOffset, int64& OutValue)
+	{
+		uint64 Raw{ 0 };
+		if (ReadVarUInt(Buffer, InOutOffset, Raw))
+		{
+			OutValue = static_cast<int64>(Raw >> 1) ^ -static_cast<int64>(Raw & 1);
+			return true;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputRecorder.h"
+
+#include "GEInputLogs.h"
+#include "GEInputLLM.h"
+
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+
+FInputRecorder::FInputRecorder(int32 InChunkSize)
+	: ChunkSize(FMath::Max(InChunkSize, 256))
+{
+}
+
+FInputRecorder::~FInputRecorder()
+{
+	Close();
+}
+
+
+bool FInputRecorder::Open(const FString& Filename)
+{
+	GEINPUT_LLM_SCOPE();
+
+	Close();
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("Failed to create input recording file (%s)"), *Filename);
+		return false;
+	}
+
+	// Write stream header
+
+	auto Magic{ GEInputRecord::Magic };
+	auto Version{ GEInputRecord::Version };
+	uint16 Flags{ 0 };
+
+	*Writer << Magic;
+	*Writer << Version;
+	*Writer << Flags;
+
+	ChunkBuffer.Reset(ChunkSize + 64);
+	ChunkEventCount = 0;
+	TotalEventCount = 0;
+
+	TagIndices.Reset();
+	FrameEvents.Reset();
+	ResetDeltaState();
+
+	StartFrame = GFrameCounter;
+	StartTime = FPlatformTime::Seconds();
+
+	return true;
+}
+
+void FInputRecorder::Close()
+{
+	if (Writer.IsValid())
+	{
+		FlushChunk();
+
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+
+void FInputRecorder::ReserveTags(int32 NumTags)
+{
+	GEINPUT_LLM_SCOPE();
+
+	TagIndices.Reserve(NumTags);
+	PrevValues.Reserve(NumTags);
+}
+
+void FInputRecorder::RecordEvent(uint64 FrameNumber, double Time, const FGameplayTag& InputTag, ETriggerEvent TriggerEvent, const FInputActionValue& Value)
+{
+	GEINPUT_LLM_SCOPE();
+
+	const auto TriggerIndex{ GEInputRecord::TriggerEventToIndex(TriggerEvent) };
+
+	if (!Writer.IsValid() || !InputTag.IsValid() || (TriggerIndex == INDEX_NONE))
+	{
+		return;
+	}
+
+	const auto Frame{ static_cast<uint32>(FrameNumber - StartFrame) };
+	const auto TimeMicro{ static_cast<uint64>(FMath::Max(Time - StartTime, 0.0) * 1000000.0) };
+
+	// Find or register tag index
+
+	auto* ExistingIndex{ TagIndices.Find(InputTag) };
+	const auto bNewTag{ ExistingIndex == nullptr };
+	const auto TagIndex{ bNewTag ? TagIndices.Num() : *ExistingIndex };
+
+	// Skip events already delivered to another processor in the same frame
+
+	if (FrameEventsFrame != Frame)
+	{
+		FrameEvents.Reset();
+		FrameEventsFrame = Frame;
+	}
+
+	const TPair<int32, int32> FrameEvent{ TagIndex, TriggerIndex };
+
+	if (FrameEvents.Contains(FrameEvent))
+	{
+		return;
+	}
+
+	FrameEvents.Add(FrameEvent);
+
+	if (bNewTag)
+	{
+		TagIndices.Add(InputTag, TagIndex);
+	}
+
+	if (!PrevValues.IsValidIndex(TagIndex))
+	{
+		PrevValues.SetNumZeroed(TagIndex + 1);
+	}
+
+	// Encode event
+
+	GEInputRecord::WriteVarUInt(ChunkBuffer, Frame - PrevFrame);
+	GEInputRecord::WriteVarUInt(ChunkBuffer, TimeMicro - FMath::Min(TimeMicro, PrevTimeMicro));
+	GEInputRecord::WriteVarUInt(ChunkBuffer, TagIndex);
+
+	if (bNewTag)
+	{
+		FNameBuilder TagName;
+		InputTag.GetTagName().AppendString(TagName);
+
+		const auto TagNameAnsi{ StringCast<ANSICHAR>(TagName.ToString(), TagName.Len()) };
+
+		GEInputRecord::WriteVarUInt(ChunkBuffer, TagNameAnsi.Length());
+		ChunkBuffer.Append(reinterpret_cast<const uint8*>(TagNameAnsi.Get()), TagNameAnsi.Length());
+	}
+
+	const auto ValueType{ Value.GetValueType() };
+	ChunkBuffer.Add(static_cast<uint8>(TriggerIndex | (static_cast<uint8>(ValueType) << 3)));
+
+	const auto RawValue{ Value.Get<FVector>() };
+	auto& PrevValue{ PrevValues[TagIndex] };
+
+	for (int32 Component{ 0 }; Component < GEInputRecord::GetNumComponents(ValueType); ++Component)
+	{
+		const auto Quantized{ GEInputRecord::Quantize(RawValue[Component]) };
+		GEInputRecord::WriteVarInt(ChunkBuffer, static_cast<int64>(Quantized) - PrevValue[Component]);
+		PrevValue[Component] = Quantized;
+	}
+
+	PrevFrame = Frame;
+	PrevTimeMicro = TimeMicro;
+
+	++ChunkEventCount;
+	++TotalEventCount;
+
+	if (ChunkBuffer.Num() >= ChunkSize)
+	{
+		FlushChunk();
+	}
+}
+
+
+void FInputRecorder::FlushChunk()
+{
+	if (Writer.IsValid() && (ChunkEventCount > 0))
+	{
+		auto ChunkBytes{ static_cast<uint32>(ChunkBuffer.Num()) };
+
+		*Writer << ChunkBytes;
+		*Writer << ChunkEventCount;
+		Writer->Serialize(ChunkBuffer.GetData(), ChunkBuffer.Num());
+	}
+
+	ChunkBuffer.Reset();
+	ChunkEventCount = 0;
+
+	ResetDeltaState();
+}
+
+void FInputRecorder::ResetDeltaState()
+{
+	for (auto& PrevValue : PrevValues)
+	{
+		PrevValue = FIntVector::ZeroValue;
+	}
+
+	PrevFrame = 0;
+	PrevTimeMicro = 0;
+}
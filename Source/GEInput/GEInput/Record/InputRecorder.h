@@ -0,0 +1,82 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Record/InputRecordTypes.h"
+
+class FArchive;
+
+
+/**
+ * Writes input events reaching the processors into a compact, delta-encoded binary stream on disk
+ *
+ * Tips:
+ *	Events are encoded into an in-memory chunk which is written to the file every time it exceeds the chunk size,
+ *	so memory usage stays constant regardless of the length of the session.
+ */
+class GEINPUT_API FInputRecorder
+{
+public:
+	explicit FInputRecorder(int32 InChunkSize = GEInputRecord::DefaultChunkSize);
+	~FInputRecorder();
+
+protected:
+	TUniquePtr<FArchive> Writer;
+
+	int32 ChunkSize{ GEInputRecord::DefaultChunkSize };
+
+	TArray<uint8> ChunkBuffer;
+	uint32 ChunkEventCount{ 0 };
+
+	//
+	// Tag table shared by the whole stream
+	//
+	TMap<FGameplayTag, int32> TagIndices;
+
+	//
+	// Delta encoding state reset at the start of each chunk
+	//
+	TArray<FIntVector> PrevValues;
+	uint32 PrevFrame{ 0 };
+	uint64 PrevTimeMicro{ 0 };
+
+	uint64 StartFrame{ 0 };
+	double StartTime{ 0.0 };
+
+	//
+	// Events already recorded in the current frame, used to drop the duplicates delivered to several processors
+	//
+	TArray<TPair<int32, int32>, TInlineAllocator<16>> FrameEvents;
+	uint32 FrameEventsFrame{ 0 };
+
+	uint32 TotalEventCount{ 0 };
+
+public:
+	/**
+	 * Creates the file and writes the stream header
+	 */
+	bool Open(const FString& Filename);
+
+	/**
+	 * Flushes the pending chunk and closes the file
+	 */
+	void Close();
+
+	bool IsRecording() const { return Writer.IsValid(); }
+	uint32 GetNumRecordedEvents() const { return TotalEventCount; }
+
+	/**
+	 * Presizes the tag table for the number of tags expected in the stream, so that recording does not allocate for them
+	 */
+	void ReserveTags(int32 NumTags);
+
+	/**
+	 * Appends an event to the stream
+	 */
+	void RecordEvent(uint64 FrameNumber, double Time, const FGameplayTag& InputTag, ETriggerEvent TriggerEvent, const FInputActionValue& Value);
+
+protected:
+	void FlushChunk();
+	void ResetDeltaState();
+
+};
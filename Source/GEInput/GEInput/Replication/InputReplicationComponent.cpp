@@ -0,0 +1,564 @@
+// Copyright (C) 2024 owoDra
+
+#include "InputReplicationComponent.h"
+
+#include "InputProcessComponent.h"
+#include "Processor/InputProcessor.h"
+#include "Record/InputRecordTypes.h"
+#include "GEInputStats.h"
+#include "GEInputLLM.h"
+
+#include "InputAction.h"
+#include "GameFramework/Actor.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputReplicationComponent)
+
+
+UInputReplicationComponent::UInputReplicationComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	SetIsReplicatedByDefault(true);
+}
+
+
+void UInputReplicationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	auto* Owner{ GetOwner() };
+	check(Owner);
+
+	// Only a remote owning client sends input, a listen server host already runs its processors locally
+
+	if (Owner->HasLocalNetOwner() && !Owner->HasAuthority())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UInputReplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (auto* InputComponent{ LocalInputComponent.Get() })
+	{
+		InputComponent->SetInputReplication(nullptr);
+	}
+
+	LocalInputComponent.Reset();
+
+	if (ServerInputComponent)
+	{
+		ServerInputComponent->DestroyComponent();
+		ServerInputComponent = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!LocalInputComponent.IsValid())
+	{
+		BindLocalInputComponent();
+	}
+
+	SendPendingInput();
+}
+
+UInputReplicationComponent* UInputReplicationComponent::FindOrAddReplicationComponent(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	if (auto* ExistingComponent{ Actor->FindComponentByClass<UInputReplicationComponent>() })
+	{
+		return ExistingComponent;
+	}
+
+	// Only the server creates the component, clients receive it through replication
+
+	if (!Actor->HasAuthority())
+	{
+		return nullptr;
+	}
+
+	GEINPUT_LLM_SCOPE();
+
+	auto* NewComponent{ NewObject<UInputReplicationComponent>(Actor) };
+	NewComponent->RegisterComponent();
+
+	return NewComponent;
+}
+
+
+// Slots
+
+void UInputReplicationComponent::UpdateSlots(const UInputProcessComponent* InputComponent)
+{
+	check(InputComponent);
+
+	const auto ChangedFrame{ InputComponent->GetLastProcessorsChangedFrame() };
+
+	if (ChangedFrame == SlotsBuiltFrame)
+	{
+		return;
+	}
+
+	GEINPUT_LLM_SCOPE();
+
+	SlotsBuiltFrame = ChangedFrame;
+
+	// Collect tags of processors that run on the server
+
+	Slots.Reset();
+
+	for (const auto& KVP : InputComponent->GetInputProcessors())
+	{
+		const auto* Processor{ KVP.Value.Get() };
+
+		if (!Processor || !Processor->ShouldRunOnServer())
+		{
+			continue;
+		}
+
+		for (const auto& ActionKVP : Processor->GetInputActions())
+		{
+			if (ActionKVP.Key.IsValid() && ActionKVP.Value && (FindSlotIndex(ActionKVP.Key) == INDEX_NONE))
+			{
+				auto& NewSlot{ Slots.AddDefaulted_GetRef() };
+				NewSlot.InputTag = ActionKVP.Key;
+				NewSlot.ValueType = ActionKVP.Value->ValueType;
+			}
+		}
+	}
+
+	Slots.Sort([](const FInputReplicationSlot& A, const FInputReplicationSlot& B)
+		{
+			return A.InputTag.GetTagName().LexicalLess(B.InputTag.GetTagName());
+		});
+
+	// Hash the table so that packets built for another set of processors are rejected
+
+	uint32 Crc{ 0 };
+
+	for (const auto& Slot : Slots)
+	{
+		const auto ValueType{ static_cast<uint8>(Slot.ValueType) };
+
+		Crc = FCrc::StrCrc32(*Slot.InputTag.ToString(), Crc);
+		Crc = FCrc::MemCrc32(&ValueType, sizeof(ValueType), Crc);
+	}
+
+	SlotTableHash = static_cast<uint16>(Crc ^ (Crc >> 16));
+
+	// Delta state is only valid for the previous table
+
+	PendingSlots.Reset();
+	PendingSlots.SetNum(Slots.Num());
+	bHasPendingInput = false;
+
+	UnackedFrames.Reset();
+	AckedFrame = FInputReplicationFrame();
+
+	ReceivedFrames.Reset();
+	ReceivedFrames.SetNum(GEInputReplication::ServerHistorySize);
+}
+
+int32 UInputReplicationComponent::FindSlotIndex(const FGameplayTag& InputTag) const
+{
+	return Slots.IndexOfByPredicate([&InputTag](const FInputReplicationSlot& Slot) { return Slot.InputTag == InputTag; });
+}
+
+
+// Client
+
+void UInputReplicationComponent::BindLocalInputComponent()
+{
+	auto* Owner{ GetOwner() };
+	check(Owner);
+
+	auto* InputComponent{ Cast<UInputProcessComponent>(Owner->InputComponent) };
+	InputComponent = InputComponent ? InputComponent : Owner->FindComponentByClass<UInputProcessComponent>();
+
+	if (InputComponent)
+	{
+		LocalInputComponent = InputComponent;
+		InputComponent->SetInputReplication(this);
+	}
+}
+
+void UInputReplicationComponent::CaptureInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)
+{
+	const auto* InputComponent{ LocalInputComponent.Get() };
+	const auto TriggerIndex{ GEInputRecord::TriggerEventToIndex(TriggerEvent) };
+
+	if (!InputComponent || (TriggerIndex == INDEX_NONE))
+	{
+		return;
+	}
+
+	UpdateSlots(InputComponent);
+
+	const auto SlotIndex{ FindSlotIndex(InputTag) };
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	auto& State{ PendingSlots[SlotIndex] };
+	State.EventMask |= static_cast<uint8>(1 << TriggerIndex);
+
+	const auto Value{ InputActionValue.Get<FVector>() };
+	const auto NumComponents{ GEInputRecord::GetNumComponents(Slots[SlotIndex].ValueType) };
+
+	for (int32 Component{ 0 }; Component < NumComponents; ++Component)
+	{
+		State.Values[Component] = GEInputRecord::Quantize(Value[Component]);
+	}
+
+	bHasPendingInput = true;
+}
+
+void UInputReplicationComponent::SendPendingInput()
+{
+	GEINPUT_LLM_SCOPE();
+
+	// Move the input captured this frame to the unacknowledged frames
+
+	if (bHasPendingInput)
+	{
+		// The server rejects frames beyond its history, so while the window is full the input stays pending.
+		// Captured events keep merging into it and it becomes the next frame once the server confirms one, it has never been sent.
+
+		if (static_cast<uint64>(NextFrame) > static_cast<uint64>(LastConfirmedFrame) + GEInputReplication::ServerHistorySize)
+		{
+			GEInputStats::RecordCollapsedInputFrame();
+		}
+		else
+		{
+			auto& NewFrame{ UnackedFrames.AddDefaulted_GetRef() };
+			NewFrame.Frame = NextFrame++;
+			NewFrame.Slots = PendingSlots;
+
+			for (auto& State : PendingSlots)
+			{
+				State = FInputSlotState();
+			}
+
+			bHasPendingInput = false;
+		}
+	}
+
+	if (UnackedFrames.IsEmpty())
+	{
+		return;
+	}
+
+	// Send the frames not sent yet after a few frames sent before them, or only those frames again when nothing is new
+
+	auto FirstNewIndex{ UnackedFrames.IndexOfByPredicate([this](const FInputReplicationFrame& Each) { return Each.Frame > LastSentFrame; }) };
+	FirstNewIndex = (FirstNewIndex == INDEX_NONE) ? UnackedFrames.Num() : FirstNewIndex;
+
+	const auto FirstIndex{ FMath::Max(FirstNewIndex - GEInputReplication::NumRedundantFrames, 0) };
+	const auto NumFramesToSend{ FMath::Min(UnackedFrames.Num() - FirstIndex, GEInputReplication::MaxFramesPerPacket) };
+
+	// Write the frames against the acknowledged baseline
+
+	static const FInputSlotState EmptyState;
+
+	FBitWriter Writer(256, true);
+
+	auto Hash{ SlotTableHash };
+	Writer << Hash;
+
+	auto BaseFrame{ AckedFrame.Frame };
+	Writer.SerializeIntPacked(BaseFrame);
+
+	auto NumFrames{ static_cast<uint32>(NumFramesToSend) };
+	Writer.SerializeInt(NumFrames, GEInputReplication::MaxFramesPerPacket + 1);
+
+	auto PreviousFrame{ BaseFrame };
+
+	for (int32 FrameIndex{ FirstIndex }; FrameIndex < FirstIndex + NumFramesToSend; ++FrameIndex)
+	{
+		const auto& Frame{ UnackedFrames[FrameIndex] };
+
+		auto FrameDelta{ Frame.Frame - PreviousFrame };
+		Writer.SerializeIntPacked(FrameDelta);
+		PreviousFrame = Frame.Frame;
+
+		for (int32 SlotIndex{ 0 }; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			const auto& State{ Frame.Slots[SlotIndex] };
+			const auto& Base{ AckedFrame.Slots.IsValidIndex(SlotIndex) ? AckedFrame.Slots[SlotIndex] : EmptyState };
+
+			const auto bChanged{ State != Base };
+			Writer.WriteBit(bChanged);
+
+			if (!bChanged)
+			{
+				continue;
+			}
+
+			uint32 EventMask{ State.EventMask };
+			Writer.SerializeInt(EventMask, 1 << GEInputReplication::NumEventBits);
+
+			if (EventMask == 0)
+			{
+				continue;
+			}
+
+			const auto NumComponents{ GEInputRecord::GetNumComponents(Slots[SlotIndex].ValueType) };
+
+			for (int32 Component{ 0 }; Component < NumComponents; ++Component)
+			{
+				const auto bComponentChanged{ State.Values[Component] != Base.Values[Component] };
+				Writer.WriteBit(bComponentChanged);
+
+				if (bComponentChanged)
+				{
+					auto Delta{ GEInputReplication::ZigZag(State.Values[Component] - Base.Values[Component]) };
+					Writer.SerializeIntPacked(Delta);
+				}
+			}
+		}
+	}
+
+	if (Writer.IsError())
+	{
+		return;
+	}
+
+	LastSentFrame = FMath::Max(LastSentFrame, PreviousFrame);
+
+	TArray<uint8> Packet(Writer.GetData(), Writer.GetNumBytes());
+
+	GEInputStats::RecordReplicatedInputBytes(Packet.Num());
+
+	ServerReceiveInputPacket(Packet);
+}
+
+void UInputReplicationComponent::ClientAckInputFrame_Implementation(uint32 Frame)
+{
+	LastConfirmedFrame = FMath::Max(LastConfirmedFrame, Frame);
+
+	if (Frame <= AckedFrame.Frame)
+	{
+		return;
+	}
+
+	const auto FrameIndex{ UnackedFrames.IndexOfByPredicate([Frame](const FInputReplicationFrame& Each) { return Each.Frame == Frame; }) };
+
+	if (FrameIndex != INDEX_NONE)
+	{
+		AckedFrame = MoveTemp(UnackedFrames[FrameIndex]);
+		UnackedFrames.RemoveAt(0, FrameIndex + 1);
+	}
+}
+
+void UInputReplicationComponent::ClientResetInputBaseline_Implementation(uint32 LastProcessedFrame)
+{
+	LastConfirmedFrame = FMath::Max(LastConfirmedFrame, LastProcessedFrame);
+	AckedFrame = FInputReplicationFrame();
+
+	const auto NumProcessed{ UnackedFrames.IndexOfByPredicate([LastProcessedFrame](const FInputReplicationFrame& Each) { return Each.Frame > LastProcessedFrame; }) };
+	UnackedFrames.RemoveAt(0, (NumProcessed == INDEX_NONE) ? UnackedFrames.Num() : NumProcessed);
+}
+
+
+// Server
+
+UInputProcessComponent* UInputReplicationComponent::GetOrCreateServerInputComponent()
+{
+	auto* Owner{ GetOwner() };
+	check(Owner);
+
+	if (!ServerInputComponent && Owner->HasAuthority())
+	{
+		GEINPUT_LLM_SCOPE();
+
+		// Assign before registering, registration notifies the feature actions which call back into this function
+
+		ServerInputComponent = NewObject<UInputProcessComponent>(Owner, TEXT("ServerInputProcessComponent"));
+		ServerInputComponent->RegisterComponent();
+	}
+
+	return ServerInputComponent;
+}
+
+void UInputReplicationComponent::ServerReceiveInputPacket_Implementation(const TArray<uint8>& Packet)
+{
+	GEINPUT_LLM_SCOPE();
+
+	if (!ServerInputComponent)
+	{
+		return;
+	}
+
+	UpdateSlots(ServerInputComponent);
+
+	FBitReader Reader(Packet.GetData(), static_cast<int64>(Packet.Num()) * 8);
+
+	uint16 Hash{ 0 };
+	Reader << Hash;
+
+	uint32 BaseFrame{ 0 };
+	Reader.SerializeIntPacked(BaseFrame);
+
+	uint32 NumFrames{ 0 };
+	Reader.SerializeInt(NumFrames, GEInputReplication::MaxFramesPerPacket + 1);
+
+	// Every packet is answered with an ack or a reset so that the client never keeps resending against a baseline the server rejects
+
+	if (Reader.IsError() || (Hash != SlotTableHash) || (BaseFrame > LastProcessedFrame))
+	{
+		ClientResetInputBaseline(LastProcessedFrame);
+		return;
+	}
+
+	// Copy the baseline, decoded frames may overwrite its history entry
+
+	TArray<FInputSlotState, TInlineAllocator<16>> Base;
+	Base.SetNum(Slots.Num());
+
+	if (BaseFrame != 0)
+	{
+		const auto& BaseEntry{ ReceivedFrames[BaseFrame % GEInputReplication::ServerHistorySize] };
+
+		if ((BaseEntry.Frame != BaseFrame) || (BaseEntry.Slots.Num() != Slots.Num()))
+		{
+			ClientResetInputBaseline(LastProcessedFrame);
+			return;
+		}
+
+		for (int32 SlotIndex{ 0 }; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			Base[SlotIndex] = BaseEntry.Slots[SlotIndex];
+		}
+	}
+
+	FInputReplicationFrame Decoded;
+	Decoded.Slots.SetNum(Slots.Num());
+	Decoded.Frame = BaseFrame;
+
+	// Frames further ahead than the history would overwrite baselines the client may still reference
+
+	const auto MaxFrame{ static_cast<uint64>(LastProcessedFrame) + GEInputReplication::ServerHistorySize };
+
+	for (uint32 FrameIndex{ 0 }; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		uint32 FrameDelta{ 0 };
+		Reader.SerializeIntPacked(FrameDelta);
+
+		if (Reader.IsError() || (FrameDelta == 0) || (static_cast<uint64>(Decoded.Frame) + FrameDelta > MaxFrame))
+		{
+			ClientResetInputBaseline(LastProcessedFrame);
+			return;
+		}
+
+		Decoded.Frame += FrameDelta;
+
+		for (int32 SlotIndex{ 0 }; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			auto& State{ Decoded.Slots[SlotIndex] };
+			State = Base[SlotIndex];
+
+			if (!Reader.ReadBit())
+			{
+				continue;
+			}
+
+			uint32 EventMask{ 0 };
+			Reader.SerializeInt(EventMask, 1 << GEInputReplication::NumEventBits);
+
+			State = FInputSlotState();
+			State.EventMask = static_cast<uint8>(EventMask);
+
+			if (EventMask == 0)
+			{
+				continue;
+			}
+
+			const auto NumComponents{ GEInputRecord::GetNumComponents(Slots[SlotIndex].ValueType) };
+
+			for (int32 Component{ 0 }; Component < NumComponents; ++Component)
+			{
+				State.Values[Component] = Base[SlotIndex].Values[Component];
+
+				if (Reader.ReadBit())
+				{
+					uint32 Delta{ 0 };
+					Reader.SerializeIntPacked(Delta);
+
+					State.Values[Component] += GEInputReplication::UnZigZag(Delta);
+				}
+			}
+		}
+
+		if (Reader.IsError())
+		{
+			ClientResetInputBaseline(LastProcessedFrame);
+			return;
+		}
+
+		// Frames already processed are only resent because the ack was lost
+
+		if (Decoded.Frame > LastProcessedFrame)
+		{
+			auto& Entry{ ReceivedFrames[Decoded.Frame % GEInputReplication::ServerHistorySize] };
+			Entry.Frame = Decoded.Frame;
+			Entry.Slots = Decoded.Slots;
+
+			ProcessReceivedFrame(Decoded);
+
+			LastProcessedFrame = Decoded.Frame;
+		}
+	}
+
+	ClientAckInputFrame(LastProcessedFrame);
+}
+
+void UInputReplicationComponent::ProcessReceivedFrame(const FInputReplicationFrame& Frame)
+{
+	// Deliver events in the order EnhancedInput fires them
+
+	static const int32 EventOrder[]{ 1, 2, 0, 3, 4 };
+
+	for (int32 SlotIndex{ 0 }; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		const auto& State{ Frame.Slots[SlotIndex] };
+
+		if (State.EventMask == 0)
+		{
+			continue;
+		}
+
+		const auto& Slot{ Slots[SlotIndex] };
+		const FVector Value
+		{
+			GEInputRecord::Dequantize(State.Values[0]),
+			GEInputRecord::Dequantize(State.Values[1]),
+			GEInputRecord::Dequantize(State.Values[2])
+		};
+
+		const FInputActionValue InputActionValue{ Slot.ValueType, Value };
+
+		for (const auto TriggerIndex : EventOrder)
+		{
+			if (State.EventMask & (1 << TriggerIndex))
+			{
+				ServerInputComponent->InjectInputEvent(GEInputRecord::IndexToTriggerEvent(TriggerIndex), Slot.InputTag, InputActionValue);
+			}
+		}
+	}
+}
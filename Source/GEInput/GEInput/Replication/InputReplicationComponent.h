@@ -0,0 +1,169 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+
+#include "Replication/InputReplicationTypes.h"
+#include "InputTriggers.h"
+
+#include "InputReplicationComponent.generated.h"
+
+class UInputProcessComponent;
+class UInputProcessor;
+
+
+/**
+ * Sends the input of processors marked bRunOnServer from the owning client to the server,
+ * where the same processor classes run on a server side UInputProcessComponent.
+ *
+ * Tips:
+ *	Created on the server by UGameFeatureAction_AddInputProcessors and replicated to the owning client.
+ *	Input is sent as a compact bitstream over an unreliable RPC and delta compressed against the last frame acknowledged by the server.
+ *	Each packet carries the frames not sent yet and the last GEInputReplication::NumRedundantFrames frames sent before them.
+ *	Frame numbers never run more than GEInputReplication::ServerHistorySize ahead of the last frame the server confirmed,
+ *	input captured beyond that is merged into the next frame, which the server cannot have seen yet.
+ */
+UCLASS(NotBlueprintable, ClassGroup = "Input")
+class GEINPUT_API UInputReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+public:
+	UInputReplicationComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Returns the component of the actor, creating it on the server if it does not exist yet
+	 */
+	static UInputReplicationComponent* FindOrAddReplicationComponent(AActor* Actor);
+
+
+	////////////////////////////////////////////////////////////
+	// Slots
+protected:
+	//
+	// Replicated input tags sorted by name, identical on client and server when both run the same processors
+	//
+	TArray<FInputReplicationSlot> Slots;
+
+	uint16 SlotTableHash{ 0 };
+
+	//
+	// UInputProcessComponent::LastProcessorsChangedFrame the slots were built for
+	//
+	uint64 SlotsBuiltFrame{ MAX_uint64 };
+
+protected:
+	/**
+	 * Rebuilds the slot table if the processors of the component changed
+	 */
+	void UpdateSlots(const UInputProcessComponent* InputComponent);
+
+	int32 FindSlotIndex(const FGameplayTag& InputTag) const;
+
+
+	////////////////////////////////////////////////////////////
+	// Client
+protected:
+	//
+	// Local input component whose dispatched events are sent to the server
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UInputProcessComponent> LocalInputComponent;
+
+	//
+	// Input captured in the current frame
+	//
+	TArray<FInputSlotState> PendingSlots;
+
+	bool bHasPendingInput{ false };
+
+	//
+	// Frames sent but not acknowledged yet, in ascending order
+	//
+	TArray<FInputReplicationFrame> UnackedFrames;
+
+	//
+	// Last acknowledged frame used as the delta baseline
+	//
+	FInputReplicationFrame AckedFrame;
+
+	//
+	// Last frame the server confirmed processing, kept when the baseline is reset
+	//
+	uint32 LastConfirmedFrame{ 0 };
+
+	//
+	// Newest frame written to a packet
+	//
+	uint32 LastSentFrame{ 0 };
+
+	uint32 NextFrame{ 1 };
+
+public:
+	/**
+	 * Captures an event dispatched to a processor that runs on the server.
+	 * Events of the same tag in one frame are merged.
+	 */
+	void CaptureInputEvent(ETriggerEvent TriggerEvent, const FGameplayTag& InputTag, const FInputActionValue& InputActionValue);
+
+	uint32 GetAckedFrame() const { return AckedFrame.Frame; }
+
+	int32 GetNumUnackedFrames() const { return UnackedFrames.Num(); }
+
+protected:
+	void BindLocalInputComponent();
+	void SendPendingInput();
+
+	UFUNCTION(Client, Unreliable)
+	void ClientAckInputFrame(uint32 Frame);
+
+	/**
+	 * Called when the server rejected a packet, frames up to the last processed frame are dropped and the baseline falls back to the empty state
+	 */
+	UFUNCTION(Client, Unreliable)
+	void ClientResetInputBaseline(uint32 LastProcessedFrame);
+
+
+	////////////////////////////////////////////////////////////
+	// Server
+protected:
+	//
+	// Input component created on the server to run the processors marked bRunOnServer
+	//
+	UPROPERTY(Transient)
+	TObjectPtr<UInputProcessComponent> ServerInputComponent;
+
+	//
+	// Received frames indexed by frame number modulo GEInputReplication::ServerHistorySize
+	//
+	TArray<FInputReplicationFrame> ReceivedFrames;
+
+	uint32 LastProcessedFrame{ 0 };
+
+public:
+	/**
+	 * Returns the input component that runs processors on the server, creating it if needed
+	 */
+	UInputProcessComponent* GetOrCreateServerInputComponent();
+
+	/**
+	 * Returns the input component that runs processors on the server, null if none was created
+	 */
+	UInputProcessComponent* GetServerInputComponent() const { return ServerInputComponent; }
+
+protected:
+	UFUNCTION(Server, Unreliable)
+	void ServerReceiveInputPacket(const TArray<uint8>& Packet);
+
+	void ProcessReceivedFrame(const FInputReplicationFrame& Frame);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FInputReplicationListenServerTest;
+#endif
+
+};
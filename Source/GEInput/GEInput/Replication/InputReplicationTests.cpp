@@ -0,0 +1,149 @@
+// Copyright (C) 2024 owoDra
+
+#include "Replication/InputReplicationComponent.h"
+#include "Development/InputProcessor_Replicated.h"
+#include "InputProcessComponent.h"
+#include "GameplayTag/GEInputTags_Input.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputReplicationListenServerTest, "GEInput.Replication.ListenServer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInputReplicationListenServerTest::RunTest(const FString& Parameters)
+{
+	// Listen server world with a host player. RPCs of actors owned by the host run locally,
+	// so one replication component both sends the packets and receives them on its server input component
+
+	auto* GameInstance{ NewObject<UGameInstance>(GEngine) };
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone(TEXT("GEInputReplicationTestWorld"));
+
+	auto* World{ GameInstance->GetWorld() };
+
+	auto DestroyTestWorld
+	{
+		[GameInstance, World]()
+		{
+			if (World)
+			{
+				GEngine->ShutdownWorldNetDriver(World);
+
+				World->DestroyWorld(false);
+				GEngine->DestroyWorldContext(World);
+			}
+
+			GameInstance->Shutdown();
+			GameInstance->RemoveFromRoot();
+		}
+	};
+
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		DestroyTestWorld();
+		return false;
+	}
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	FURL ListenURL;
+
+	if (!TestTrue(TEXT("World listens"), World->Listen(ListenURL)) || !TestTrue(TEXT("Listen server"), World->GetNetMode() == NM_ListenServer))
+	{
+		DestroyTestWorld();
+		return false;
+	}
+
+	auto* Controller{ World->SpawnActor<APlayerController>() };
+	auto* Pawn{ World->SpawnActor<APawn>() };
+
+	auto* LocalPlayer{ NewObject<ULocalPlayer>(GEngine, GEngine->LocalPlayerClass) };
+	GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(0));
+	Controller->SetPlayer(LocalPlayer);
+	Controller->Possess(Pawn);
+
+	// Both components add the processor in the same frame, so the slot table is not rebuilt between sending and receiving
+
+	auto* InputComponent{ NewObject<UInputProcessComponent>(Pawn, TEXT("InputProcessComponent")) };
+	Pawn->InputComponent = InputComponent;
+	InputComponent->RegisterComponent();
+	InputComponent->AddInputProcessor(UInputProcessor_Replicated::StaticClass());
+
+	auto* Replication{ UInputReplicationComponent::FindOrAddReplicationComponent(Pawn) };
+	auto* ServerInputComponent{ Replication ? Replication->GetOrCreateServerInputComponent() : nullptr };
+
+	if (ServerInputComponent)
+	{
+		ServerInputComponent->AddInputProcessor(UInputProcessor_Replicated::StaticClass());
+	}
+
+	auto* LocalProcessor{ Cast<UInputProcessor_Replicated>(InputComponent->GetInputProcessors().FindRef(UInputProcessor_Replicated::StaticClass())) };
+	auto* ServerProcessor{ ServerInputComponent ? Cast<UInputProcessor_Replicated>(ServerInputComponent->GetInputProcessors().FindRef(UInputProcessor_Replicated::StaticClass())) : nullptr };
+
+	if (TestNotNull(TEXT("Local processor"), LocalProcessor) && TestNotNull(TEXT("Server processor"), ServerProcessor))
+	{
+		auto Tick{ [Replication]() { Replication->TickComponent(0.0f, LEVELTICK_All, nullptr); } };
+
+		// The first tick binds the local input component
+
+		Tick();
+
+		// Round trip and ack
+
+		LocalProcessor->SimulateBoundInputEvent(ETriggerEvent::Started, TAG_Input_Gamepad_Move, FInputActionValue(FVector2D(0.5, -0.25)));
+		Tick();
+
+		TestEqual(TEXT("Started received by the server"), ServerProcessor->GetNumStartedReceived(), 1);
+		TestTrue(TEXT("Value received by the server"), ServerProcessor->GetLastValue().Equals(FVector2D(0.5, -0.25), 0.01));
+		TestEqual(TEXT("Acked frame"), static_cast<int32>(Replication->GetAckedFrame()), 1);
+		TestEqual(TEXT("Unacked frames after the ack"), Replication->GetNumUnackedFrames(), 0);
+
+		// Drop the baseline from the server history, as if it had been overwritten, so that the next packet is rejected
+
+		Replication->ReceivedFrames[Replication->GetAckedFrame() % GEInputReplication::ServerHistorySize].Frame = 0;
+
+		LocalProcessor->SimulateBoundInputEvent(ETriggerEvent::Completed, TAG_Input_Gamepad_Move, FInputActionValue(FVector2D::ZeroVector));
+		Tick();
+
+		TestEqual(TEXT("Completed of the rejected packet not received"), ServerProcessor->GetNumCompletedReceived(), 0);
+		TestEqual(TEXT("Baseline reset"), static_cast<int32>(Replication->GetAckedFrame()), 0);
+		TestEqual(TEXT("Unprocessed frame kept"), Replication->GetNumUnackedFrames(), 1);
+
+		// The frame is sent again against the empty baseline
+
+		Tick();
+
+		TestEqual(TEXT("Completed received after the reset"), ServerProcessor->GetNumCompletedReceived(), 1);
+		TestEqual(TEXT("Started not delivered twice"), ServerProcessor->GetNumStartedReceived(), 1);
+		TestEqual(TEXT("Acked frame after the reset"), static_cast<int32>(Replication->GetAckedFrame()), 2);
+		TestEqual(TEXT("Unacked frames after the reset"), Replication->GetNumUnackedFrames(), 0);
+	}
+
+	// Cleanup
+
+	InputComponent->RemoveAllInputProcessors();
+
+	GameInstance->RemoveLocalPlayer(LocalPlayer);
+
+	if (IsValid(Controller))
+	{
+		World->DestroyActor(Controller);
+	}
+
+	World->DestroyActor(Pawn);
+
+	DestroyTestWorld();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "InputActionValue.h"
+
+
+/**
+ * Input replicated for one tag slot in one frame
+ */
+struct FInputSlotState
+{
+public:
+	//
+	// Trigger events fired this frame, one bit per GEInputRecord::TriggerEventToIndex
+	//
+	uint8 EventMask{ 0 };
+
+	//
+	// Value of the last event fired this frame, quantized with GEInputRecord::Quantize
+	//
+	int32 Values[3]{ 0, 0, 0 };
+
+public:
+	bool operator==(const FInputSlotState& Other) const
+	{
+		return (EventMask == Other.EventMask) && (Values[0] == Other.Values[0]) && (Values[1] == Other.Values[1]) && (Values[2] == Other.Values[2]);
+	}
+
+	bool operator!=(const FInputSlotState& Other) const { return !(*this == Other); }
+};
+
+
+/**
+ * Input tag replicated to the server and the shape of its value
+ */
+struct FInputReplicationSlot
+{
+public:
+	FGameplayTag InputTag;
+
+	EInputActionValueType ValueType{ EInputActionValueType::Boolean };
+};
+
+
+/**
+ * Replicated input of all slots in one frame
+ */
+struct FInputReplicationFrame
+{
+public:
+	uint32 Frame{ 0 };
+
+	TArray<FInputSlotState> Slots;
+};
+
+
+/**
+ * Bitstream layout shared by the owning client and the server
+ *
+ * Tips:
+ *	[uint16 SlotTableHash][packed BaseFrame][NumFrames (0-MaxFramesPerPacket)] followed by frames in ascending order.
+ *	Each frame is [packed frame delta] then per slot a "changed" bit against the same slot in BaseFrame,
+ *	and for changed slots a 5 bit event mask plus, when any event fired, each value component
+ *	as a "changed" bit and a packed zigzag delta against BaseFrame.
+ *	BaseFrame 0 means the empty state, which is used until the server acknowledged a frame and after it rejected a packet.
+ *	The server rejects packets whose frames are more than ServerHistorySize ahead of the last frame it processed.
+ */
+namespace GEInputReplication
+{
+	//
+	// Maximum number of frames written to one packet
+	//
+	constexpr int32 MaxFramesPerPacket{ 16 };
+
+	//
+	// Number of frames sent before the new frames of a packet again, so that one lost packet does not lose its input
+	//
+	constexpr int32 NumRedundantFrames{ 2 };
+
+	//
+	// Number of received frames kept by the server to decode delta against
+	//
+	constexpr int32 ServerHistorySize{ 64 };
+
+	//
+	// Number of bits used for the event mask
+	//
+	constexpr int32 NumEventBits{ 5 };
+
+	inline uint32 ZigZag(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	inline int32 UnZigZag(uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+}
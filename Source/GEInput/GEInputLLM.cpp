@@ -0,0 +1,5 @@
+// Copyright (C) 2024 owoDra
+
+#include "GEInputLLM.h"
+
+LLM_DEFINE_TAG(GEInput);
@@ -0,0 +1,12 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+
+//
+// Low Level Memory tracker tag for everything allocated by GEInput
+//
+LLM_DECLARE_TAG_API(GEInput, GEINPUT_API);
+
+#define GEINPUT_LLM_SCOPE() LLM_SCOPE_BYTAG(GEInput)
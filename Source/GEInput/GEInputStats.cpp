@@ -0,0 +1,180 @@
+// Copyright (C) 2024 owoDra
+
+#include "GEInputStats.h"
+
+#include "Latency/InputLatencyTracker.h"
+
+DEFINE_STAT(STAT_GEInput_DispatchInputEvent);
+DEFINE_STAT(STAT_GEInput_AddInputProcessor);
+DEFINE_STAT(STAT_GEInput_RemoveAllInputProcessors);
+DEFINE_STAT(STAT_GEInput_AddInputProcessorsForActor);
+DEFINE_STAT(STAT_GEInput_AddInputMappingForPlayer);
+DEFINE_STAT(STAT_GEInput_RemoveInputMapping);
+DEFINE_STAT(STAT_GEInput_RunDeferredWork);
+DEFINE_STAT(STAT_GEInput_RunInputFilters);
+DEFINE_STAT(STAT_GEInput_FlushMappingContextRegistry);
+
+DEFINE_STAT(STAT_GEInput_EventsTriggered);
+DEFINE_STAT(STAT_GEInput_EventsStarted);
+DEFINE_STAT(STAT_GEInput_EventsOngoing);
+DEFINE_STAT(STAT_GEInput_EventsCanceled);
+DEFINE_STAT(STAT_GEInput_EventsCompleted);
+DEFINE_STAT(STAT_GEInput_MappingContextRebuilds);
+DEFINE_STAT(STAT_GEInput_SynchronousLoads);
+DEFINE_STAT(STAT_GEInput_ReplicatedInputBytes);
+DEFINE_STAT(STAT_GEInput_ReplicatedInputFramesCollapsed);
+DEFINE_STAT(STAT_GEInput_IntentsPublished);
+DEFINE_STAT(STAT_GEInput_DeferredWorkRun);
+DEFINE_STAT(STAT_GEInput_DeferredWorkCarriedOver);
+
+DEFINE_STAT(STAT_GEInput_LatencyArrivalToEvaluation);
+DEFINE_STAT(STAT_GEInput_LatencyEvaluationToHandler);
+DEFINE_STAT(STAT_GEInput_LatencyHandlerToEffect);
+DEFINE_STAT(STAT_GEInput_LatencyTotal);
+
+DEFINE_STAT(STAT_GEInput_ActiveProcessors);
+DEFINE_STAT(STAT_GEInput_ActiveBindings);
+
+CSV_DEFINE_CATEGORY_MODULE(GEINPUT_API, GEInput, true);
+
+
+namespace GEInputStats
+{
+	static int32 NumActiveProcessors{ 0 };
+	static int32 NumActiveBindings{ 0 };
+
+	void RecordDispatchedEvent(ETriggerEvent TriggerEvent)
+	{
+		switch (TriggerEvent)
+		{
+		case ETriggerEvent::Triggered:
+			INC_DWORD_STAT(STAT_GEInput_EventsTriggered);
+			CSV_CUSTOM_STAT(GEInput, EventsTriggered, 1, ECsvCustomStatOp::Accumulate);
+			break;
+
+		case ETriggerEvent::Started:
+			INC_DWORD_STAT(STAT_GEInput_EventsStarted);
+			CSV_CUSTOM_STAT(GEInput, EventsStarted, 1, ECsvCustomStatOp::Accumulate);
+			break;
+
+		case ETriggerEvent::Ongoing:
+			INC_DWORD_STAT(STAT_GEInput_EventsOngoing);
+			CSV_CUSTOM_STAT(GEInput, EventsOngoing, 1, ECsvCustomStatOp::Accumulate);
+			break;
+
+		case ETriggerEvent::Canceled:
+			INC_DWORD_STAT(STAT_GEInput_EventsCanceled);
+			CSV_CUSTOM_STAT(GEInput, EventsCanceled, 1, ECsvCustomStatOp::Accumulate);
+			break;
+
+		case ETriggerEvent::Completed:
+			INC_DWORD_STAT(STAT_GEInput_EventsCompleted);
+			CSV_CUSTOM_STAT(GEInput, EventsCompleted, 1, ECsvCustomStatOp::Accumulate);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	void AddActiveProcessors(int32 Delta)
+	{
+		NumActiveProcessors += Delta;
+
+		if (Delta >= 0)
+		{
+			INC_DWORD_STAT_BY(STAT_GEInput_ActiveProcessors, Delta);
+		}
+		else
+		{
+			DEC_DWORD_STAT_BY(STAT_GEInput_ActiveProcessors, -Delta);
+		}
+	}
+
+	void AddActiveBindings(int32 Delta)
+	{
+		NumActiveBindings += Delta;
+
+		if (Delta >= 0)
+		{
+			INC_DWORD_STAT_BY(STAT_GEInput_ActiveBindings, Delta);
+		}
+		else
+		{
+			DEC_DWORD_STAT_BY(STAT_GEInput_ActiveBindings, -Delta);
+		}
+	}
+
+	void RecordMappingContextRebuild()
+	{
+		INC_DWORD_STAT(STAT_GEInput_MappingContextRebuilds);
+		CSV_CUSTOM_STAT(GEInput, MappingContextRebuilds, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordSynchronousLoad()
+	{
+		INC_DWORD_STAT(STAT_GEInput_SynchronousLoads);
+		CSV_CUSTOM_STAT(GEInput, SynchronousLoads, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordReplicatedInputBytes(int32 NumBytes)
+	{
+		INC_DWORD_STAT_BY(STAT_GEInput_ReplicatedInputBytes, NumBytes);
+		CSV_CUSTOM_STAT(GEInput, ReplicatedInputBytes, NumBytes, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordCollapsedInputFrame()
+	{
+		INC_DWORD_STAT(STAT_GEInput_ReplicatedInputFramesCollapsed);
+		CSV_CUSTOM_STAT(GEInput, ReplicatedInputFramesCollapsed, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordPublishedIntent()
+	{
+		INC_DWORD_STAT(STAT_GEInput_IntentsPublished);
+		CSV_CUSTOM_STAT(GEInput, IntentsPublished, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordDeferredWork(int32 NumRun, int32 NumCarriedOver)
+	{
+		INC_DWORD_STAT_BY(STAT_GEInput_DeferredWorkRun, NumRun);
+		INC_DWORD_STAT_BY(STAT_GEInput_DeferredWorkCarriedOver, NumCarriedOver);
+		CSV_CUSTOM_STAT(GEInput, DeferredWorkRun, NumRun, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(GEInput, DeferredWorkCarriedOver, NumCarriedOver, ECsvCustomStatOp::Accumulate);
+	}
+
+	void RecordLatencySample(EInputLatencyStage Stage, float Milliseconds)
+	{
+		switch (Stage)
+		{
+		case EInputLatencyStage::ArrivalToEvaluation:
+			SET_FLOAT_STAT(STAT_GEInput_LatencyArrivalToEvaluation, Milliseconds);
+			CSV_CUSTOM_STAT(GEInput, LatencyArrivalToEvaluationMs, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+
+		case EInputLatencyStage::EvaluationToHandler:
+			SET_FLOAT_STAT(STAT_GEInput_LatencyEvaluationToHandler, Milliseconds);
+			CSV_CUSTOM_STAT(GEInput, LatencyEvaluationToHandlerMs, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+
+		case EInputLatencyStage::HandlerToEffect:
+			SET_FLOAT_STAT(STAT_GEInput_LatencyHandlerToEffect, Milliseconds);
+			CSV_CUSTOM_STAT(GEInput, LatencyHandlerToEffectMs, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+
+		case EInputLatencyStage::Total:
+			SET_FLOAT_STAT(STAT_GEInput_LatencyTotal, Milliseconds);
+			CSV_CUSTOM_STAT(GEInput, LatencyTotalMs, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	void FlushFrameStats()
+	{
+		CSV_CUSTOM_STAT(GEInput, ActiveProcessors, NumActiveProcessors, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GEInput, ActiveBindings, NumActiveBindings, ECsvCustomStatOp::Set);
+	}
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+#include "InputTriggers.h"
+
+enum class EInputLatencyStage : uint8;
+
+
+DECLARE_STATS_GROUP(TEXT("GEInput"), STATGROUP_GEInput, STATCAT_Advanced);
+
+////////////////////////////////////
+// Cycles
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch Input Event"), STAT_GEInput_DispatchInputEvent, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Input Processor"), STAT_GEInput_AddInputProcessor, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Remove All Input Processors"), STAT_GEInput_RemoveAllInputProcessors, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Input Processors For Actor"), STAT_GEInput_AddInputProcessorsForActor, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Input Mapping For Player"), STAT_GEInput_AddInputMappingForPlayer, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Remove Input Mapping"), STAT_GEInput_RemoveInputMapping, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Deferred Work"), STAT_GEInput_RunDeferredWork, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Input Filters"), STAT_GEInput_RunInputFilters, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flush Mapping Context Registry"), STAT_GEInput_FlushMappingContextRegistry, STATGROUP_GEInput, GEINPUT_API);
+
+////////////////////////////////////
+// Per frame counters
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Triggered"), STAT_GEInput_EventsTriggered, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Started"), STAT_GEInput_EventsStarted, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Ongoing"), STAT_GEInput_EventsOngoing, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Canceled"), STAT_GEInput_EventsCanceled, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Completed"), STAT_GEInput_EventsCompleted, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Mapping Context Rebuild Requests"), STAT_GEInput_MappingContextRebuilds, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Synchronous Loads"), STAT_GEInput_SynchronousLoads, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Replicated Input Bytes"), STAT_GEInput_ReplicatedInputBytes, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Replicated Input Frames Collapsed"), STAT_GEInput_ReplicatedInputFramesCollapsed, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Intents Published"), STAT_GEInput_IntentsPublished, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Work Run"), STAT_GEInput_DeferredWorkRun, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Work Carried Over"), STAT_GEInput_DeferredWorkCarriedOver, STATGROUP_GEInput, GEINPUT_API);
+
+////////////////////////////////////
+// Latency (last sample of the frame)
+
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Latency Arrival To Evaluation (ms)"), STAT_GEInput_LatencyArrivalToEvaluation, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Latency Evaluation To Handler (ms)"), STAT_GEInput_LatencyEvaluationToHandler, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Latency Handler To Effect (ms)"), STAT_GEInput_LatencyHandlerToEffect, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Latency Total (ms)"), STAT_GEInput_LatencyTotal, STATGROUP_GEInput, GEINPUT_API);
+
+////////////////////////////////////
+// Totals
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Processors"), STAT_GEInput_ActiveProcessors, STATGROUP_GEInput, GEINPUT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Bindings"), STAT_GEInput_ActiveBindings, STATGROUP_GEInput, GEINPUT_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GEINPUT_API, GEInput);
+
+
+/**
+ * Helpers that update the STATGROUP_GEInput counters and the matching CSV_CUSTOM_STAT counters together
+ */
+namespace GEInputStats
+{
+	/**
+	 * Records an event delivered to a processor
+	 */
+	GEINPUT_API void RecordDispatchedEvent(ETriggerEvent TriggerEvent);
+
+	GEINPUT_API void AddActiveProcessors(int32 Delta);
+	GEINPUT_API void AddActiveBindings(int32 Delta);
+
+	GEINPUT_API void RecordMappingContextRebuild();
+	GEINPUT_API void RecordSynchronousLoad();
+
+	/**
+	 * Records the size of an input packet sent to the server
+	 */
+	GEINPUT_API void RecordReplicatedInputBytes(int32 NumBytes);
+
+	/**
+	 * Records a frame of input merged into the next one because the server has not confirmed enough frames to send it
+	 */
+	GEINPUT_API void RecordCollapsedInputFrame();
+
+	/**
+	 * Records an intent published on UInputIntentBus
+	 */
+	GEINPUT_API void RecordPublishedIntent();
+
+	/**
+	 * Records the deferred work run by a component this frame and the work left for later frames
+	 */
+	GEINPUT_API void RecordDeferredWork(int32 NumRun, int32 NumCarriedOver);
+
+	/**
+	 * Records a latency sample of a stage measured by FInputLatencyTracker
+	 */
+	GEINPUT_API void RecordLatencySample(EInputLatencyStage Stage, float Milliseconds);
+
+	/**
+	 * Writes the per frame totals to the CSV profiler.
+	 * Called at the end of every frame by the module.
+	 */
+	void FlushFrameStats();
+}
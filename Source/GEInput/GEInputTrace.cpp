@@ -0,0 +1,121 @@
+// Copyright (C) 2024 owoDra
+
+#include "GEInputTrace.h"
+
+#if GEINPUT_TRACE_ENABLED
+
+#include "UObject/Object.h"
+#include "UObject/Class.h"
+
+UE_TRACE_CHANNEL_DEFINE(GEInputChannel);
+
+
+UE_TRACE_EVENT_BEGIN(GEInput, ProcessorAdded)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, InputComponentId)
+	UE_TRACE_EVENT_FIELD(uint32, NumBindingsAdded)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ProcessorClass)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GEInput, ProcessorsRemoved)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, InputComponentId)
+	UE_TRACE_EVENT_FIELD(uint32, NumProcessors)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GEInput, MappingContextChanged)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, ControllerId)
+	UE_TRACE_EVENT_FIELD(int32, Priority)
+	UE_TRACE_EVENT_FIELD(bool, bAdded)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, MappingContext)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GEInput, FeatureActionChanged)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(bool, bActivated)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, FeatureAction)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GEInput, LatencySample)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+	UE_TRACE_EVENT_FIELD(uint32, Microseconds)
+UE_TRACE_EVENT_END()
+
+
+void FGEInputTrace::OutputProcessorAdded(const UObject* InputComponent, const UClass* ProcessorClass, int32 NumBindingsAdded)
+{
+	const auto ClassName{ GetNameSafe(ProcessorClass) };
+
+	UE_TRACE_LOG(GEInput, ProcessorAdded, GEInputChannel)
+		<< ProcessorAdded.Cycle(FPlatformTime::Cycles64())
+		<< ProcessorAdded.InputComponentId(reinterpret_cast<uint64>(InputComponent))
+		<< ProcessorAdded.NumBindingsAdded(static_cast<uint32>(FMath::Max(NumBindingsAdded, 0)))
+		<< ProcessorAdded.ProcessorClass(*ClassName, ClassName.Len());
+}
+
+void FGEInputTrace::OutputProcessorsRemoved(const UObject* InputComponent, int32 NumProcessors)
+{
+	UE_TRACE_LOG(GEInput, ProcessorsRemoved, GEInputChannel)
+		<< ProcessorsRemoved.Cycle(FPlatformTime::Cycles64())
+		<< ProcessorsRemoved.InputComponentId(reinterpret_cast<uint64>(InputComponent))
+		<< ProcessorsRemoved.NumProcessors(static_cast<uint32>(FMath::Max(NumProcessors, 0)));
+}
+
+void FGEInputTrace::OutputMappingContextChanged(const UObject* Controller, const UObject* MappingContext, int32 Priority, bool bAdded)
+{
+	const auto ContextName{ GetNameSafe(MappingContext) };
+
+	UE_TRACE_LOG(GEInput, MappingContextChanged, GEInputChannel)
+		<< MappingContextChanged.Cycle(FPlatformTime::Cycles64())
+		<< MappingContextChanged.ControllerId(reinterpret_cast<uint64>(Controller))
+		<< MappingContextChanged.Priority(Priority)
+		<< MappingContextChanged.bAdded(bAdded)
+		<< MappingContextChanged.MappingContext(*ContextName, ContextName.Len());
+}
+
+void FGEInputTrace::OutputFeatureActionChanged(const UObject* FeatureAction, bool bActivated)
+{
+	const auto ActionName{ GetPathNameSafe(FeatureAction) };
+
+	UE_TRACE_LOG(GEInput, FeatureActionChanged, GEInputChannel)
+		<< FeatureActionChanged.Cycle(FPlatformTime::Cycles64())
+		<< FeatureActionChanged.bActivated(bActivated)
+		<< FeatureActionChanged.FeatureAction(*ActionName, ActionName.Len());
+}
+
+void FGEInputTrace::OutputLatencySample(uint8 Stage, uint32 Microseconds)
+{
+	UE_TRACE_LOG(GEInput, LatencySample, GEInputChannel)
+		<< LatencySample.Cycle(FPlatformTime::Cycles64())
+		<< LatencySample.Stage(Stage)
+		<< LatencySample.Microseconds(Microseconds);
+}
+
+
+uint32 FGEInputTrace::GetProcessorEventSpecId(const UClass* ProcessorClass, const FGameplayTag& InputTag, ETriggerEvent TriggerEvent)
+{
+	check(IsInGameThread());
+
+	// Scope names are registered once per processor class, input tag and trigger event
+
+	static TMap<TTuple<FName, FGameplayTag, uint8>, uint32> SpecIds;
+
+	const auto ClassName{ ProcessorClass ? ProcessorClass->GetFName() : NAME_None };
+	const TTuple<FName, FGameplayTag, uint8> Key{ ClassName, InputTag, static_cast<uint8>(TriggerEvent) };
+
+	if (const auto* SpecId{ SpecIds.Find(Key) })
+	{
+		return *SpecId;
+	}
+
+	const auto ScopeName{ FString::Printf(TEXT("GEInput/%s/%s/%s"), *ClassName.ToString(), *InputTag.ToString(), *UEnum::GetDisplayValueAsText(TriggerEvent).ToString()) };
+	const auto NewSpecId{ FCpuProfilerTrace::OutputEventType(*ScopeName) };
+
+	SpecIds.Add(Key, NewSpecId);
+
+	return NewSpecId;
+}
+
+#endif // GEINPUT_TRACE_ENABLED
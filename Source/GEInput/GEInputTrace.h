@@ -0,0 +1,104 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Trace/Config.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include "GameplayTagContainer.h"
+#include "InputTriggers.h"
+
+//
+// Whether the GEInput trace channel is compiled in
+//
+#define GEINPUT_TRACE_ENABLED (UE_TRACE_ENABLED && CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if GEINPUT_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(GEInputChannel, GEINPUT_API);
+
+
+/**
+ * Outputs GEInput events to Unreal Insights on GEInputChannel
+ *
+ * Tips:
+ *	Use the GEINPUT_TRACE_* macros instead of calling this directly, they compile out when tracing is disabled
+ *	and only cost a channel check when GEInputChannel is off.
+ */
+struct GEINPUT_API FGEInputTrace
+{
+public:
+	static void OutputProcessorAdded(const UObject* InputComponent, const UClass* ProcessorClass, int32 NumBindingsAdded);
+	static void OutputProcessorsRemoved(const UObject* InputComponent, int32 NumProcessors);
+	static void OutputMappingContextChanged(const UObject* Controller, const UObject* MappingContext, int32 Priority, bool bAdded);
+	static void OutputFeatureActionChanged(const UObject* FeatureAction, bool bActivated);
+	static void OutputLatencySample(uint8 Stage, uint32 Microseconds);
+
+	/**
+	 * Returns the CPU scope id named after the processor class, input tag and trigger event
+	 */
+	static uint32 GetProcessorEventSpecId(const UClass* ProcessorClass, const FGameplayTag& InputTag, ETriggerEvent TriggerEvent);
+
+};
+
+
+/**
+ * CPU scope on GEInputChannel that is only opened when the channel is enabled
+ */
+class FGEInputTraceCpuScope
+{
+public:
+	explicit FGEInputTraceCpuScope(uint32 InSpecId)
+		: bActive(InSpecId != 0)
+	{
+		if (bActive)
+		{
+			FCpuProfilerTrace::OutputBeginEvent(InSpecId);
+		}
+	}
+
+	~FGEInputTraceCpuScope()
+	{
+		if (bActive)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+	}
+
+private:
+	bool bActive{ false };
+};
+
+#define GEINPUT_TRACE_CPUSCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, GEInputChannel)
+
+#define GEINPUT_TRACE_PROCESSOR_SCOPE(ProcessorClass, InputTag, TriggerEvent) \
+	FGEInputTraceCpuScope PREPROCESSOR_JOIN(GEInputProcessorScope, __LINE__)(UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel) ? FGEInputTrace::GetProcessorEventSpecId(ProcessorClass, InputTag, TriggerEvent) : 0)
+
+#define GEINPUT_TRACE_PROCESSOR_ADDED(InputComponent, ProcessorClass, NumBindingsAdded) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel)) { FGEInputTrace::OutputProcessorAdded(InputComponent, ProcessorClass, NumBindingsAdded); } } while (0)
+
+#define GEINPUT_TRACE_PROCESSORS_REMOVED(InputComponent, NumProcessors) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel)) { FGEInputTrace::OutputProcessorsRemoved(InputComponent, NumProcessors); } } while (0)
+
+#define GEINPUT_TRACE_MAPPING_CONTEXT_CHANGED(Controller, MappingContext, Priority, bAdded) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel)) { FGEInputTrace::OutputMappingContextChanged(Controller, MappingContext, Priority, bAdded); } } while (0)
+
+#define GEINPUT_TRACE_FEATURE_ACTION_CHANGED(FeatureAction, bActivated) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel)) { FGEInputTrace::OutputFeatureActionChanged(FeatureAction, bActivated); } } while (0)
+
+#define GEINPUT_TRACE_LATENCY_SAMPLE(Stage, Microseconds) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GEInputChannel)) { FGEInputTrace::OutputLatencySample(Stage, Microseconds); } } while (0)
+
+#else
+
+#define GEINPUT_TRACE_CPUSCOPE(Name)
+#define GEINPUT_TRACE_PROCESSOR_SCOPE(ProcessorClass, InputTag, TriggerEvent)
+#define GEINPUT_TRACE_PROCESSOR_ADDED(InputComponent, ProcessorClass, NumBindingsAdded)
+#define GEINPUT_TRACE_PROCESSORS_REMOVED(InputComponent, NumProcessors)
+#define GEINPUT_TRACE_MAPPING_CONTEXT_CHANGED(Controller, MappingContext, Priority, bAdded)
+#define GEINPUT_TRACE_FEATURE_ACTION_CHANGED(FeatureAction, bActivated)
+#define GEINPUT_TRACE_LATENCY_SAMPLE(Stage, Microseconds)
+
+#endif // GEINPUT_TRACE_ENABLED
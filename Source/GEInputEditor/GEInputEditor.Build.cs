@@ -32,7 +32,9 @@ public class GEInputEditor : ModuleRules
 
                 "InputCore", "Slate", "SlateCore",
 
-                "Kismet", "KismetCompiler",
+                "Kismet", "KismetCompiler", "BlueprintGraph",
+
+                "GameplayTags", "GameFeatures", "ModularGameplay",
 
                 "GEInput",
             }
@@ -3,6 +3,10 @@
 #include "GEInputEditor.h"
 
 #include "AssetTypeActions/AssetTypeActions_InputProcessorBlueprint.h"
+#include "Analysis/InputProcessorBlueprintCompilerExtension.h"
+#include "Processor/InputProcessorBlueprint.h"
+
+#include "BlueprintCompilationManager.h"
 
 IMPLEMENT_MODULE(FGEInputEditorModule, GEInputEditor)
 
@@ -10,11 +14,13 @@ IMPLEMENT_MODULE(FGEInputEditorModule, GEInputEditor)
 void FGEInputEditorModule::StartupModule()
 {
 	RegisterAssetTypeActions();
+	RegisterCompilerExtensions();
 }
 
 void FGEInputEditorModule::ShutdownModule()
 {
 	UnregisterAssetTypeActions();
+	UnregisterCompilerExtensions();
 }
 
 
@@ -33,6 +39,33 @@ void FGEInputEditorModule::RegisterAssetTypeActions()
 	RegisterAsset<FAssetTypeActions_InputProcessorBlueprint>(RegisteredAssetTypeActions);
 }
 
+void FGEInputEditorModule::RegisterCompilerExtensions()
+{
+	CompilerExtension = NewObject<UInputProcessorBlueprintCompilerExtension>(GetTransientPackage());
+	CompilerExtension->AddToRoot();
+
+	FBlueprintCompilationManager::RegisterCompilerExtension(UInputProcessorBlueprint::StaticClass(), CompilerExtension);
+}
+
+void FGEInputEditorModule::UnregisterCompilerExtensions()
+{
+	if (!CompilerExtension)
+	{
+		return;
+	}
+
+	// The compilation manager cannot remove a registered extension, so it is deactivated and left to the manager's references
+
+	CompilerExtension->Deactivate();
+
+	if (UObjectInitialized())
+	{
+		CompilerExtension->RemoveFromRoot();
+	}
+
+	CompilerExtension = nullptr;
+}
+
 void FGEInputEditorModule::UnregisterAssetTypeActions()
 {
 	UnregisterAssets(RegisteredAssetTypeActions);
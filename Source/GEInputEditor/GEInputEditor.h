@@ -8,6 +8,8 @@
 #include "AssetTypeActions_Base.h"
 #include "IAssetTools.h"
 
+class UInputProcessorBlueprintCompilerExtension;
+
 
 /**
  *  Modules for the editor features of the Game Phase Extension plugin
@@ -36,6 +38,11 @@ protected:
 	//
 	TArray<TSharedPtr<FAssetTypeActions_Base>> RegisteredAssetTypeActions;
 
+	//
+	// Registered compiler extension, rooted while the module is loaded
+	//
+	TObjectPtr<UInputProcessorBlueprintCompilerExtension> CompilerExtension{ nullptr };
+
 protected:
 	/**
 	 * Add a category in the context menu of the asset creation
@@ -61,6 +68,16 @@ protected:
 	}
 
 	void UnregisterAssets(TArray<TSharedPtr<FAssetTypeActions_Base>>& RegisteredAssets);
+
+	/**
+	 * Register the compiler extensions that report on InputProcessor Blueprints
+	 */
+	void RegisterCompilerExtensions();
+
+	/**
+	 * Unregister the compiler extensions from the module
+	 */
+	void UnregisterCompilerExtensions();
 };
 
 
@@ -0,0 +1,25 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "InputProcessorBlueprintCompilerExtension.h"
+
+#include "Analysis/InputProcessorCostAnalyzer.h"
+
+#include "KismetCompiler.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InputProcessorBlueprintCompilerExtension)
+
+
+void UInputProcessorBlueprintCompilerExtension::ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	if (const auto* Blueprint{ CompilationContext.Blueprint })
+	{
+		const auto Cost{ FInputProcessorCostAnalyzer::Analyze(Blueprint) };
+
+		FInputProcessorCostAnalyzer::Report(Blueprint, Cost, CompilationContext.MessageLog);
+	}
+}
@@ -0,0 +1,35 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "BlueprintCompilerExtension.h"
+
+#include "InputProcessorBlueprintCompilerExtension.generated.h"
+
+
+/**
+ * Reports the estimated dispatch cost of InputProcessor Blueprints in their compiler results
+ */
+UCLASS(MinimalAPI)
+class UInputProcessorBlueprintCompilerExtension : public UBlueprintCompilerExtension
+{
+	GENERATED_BODY()
+public:
+	UInputProcessorBlueprintCompilerExtension() {}
+
+protected:
+	//
+	// False once the editor module is shut down
+	//
+	bool bActive{ true };
+
+public:
+	/**
+	 * Stops reporting on compiled blueprints
+	 */
+	void Deactivate() { bActive = false; }
+
+protected:
+	virtual void ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data) override;
+
+};
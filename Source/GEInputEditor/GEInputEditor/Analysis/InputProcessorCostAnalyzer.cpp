@@ -0,0 +1,158 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "InputProcessorCostAnalyzer.h"
+
+#include "Processor/InputProcessor.h"
+
+#include "Engine/Blueprint.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_Event.h"
+#include "K2Node.h"
+#include "Kismet2/CompilerResultsLog.h"
+
+
+namespace GEInputValidation
+{
+	static int32 MaxPerFrameNodes{ 200 };
+	static FAutoConsoleVariableRef CVarMaxPerFrameNodes(
+		TEXT("GEInput.Validation.MaxPerFrameNodes"),
+		MaxPerFrameNodes,
+		TEXT("Number of Blueprint nodes an input processor can run per frame before its compilation warns."));
+}
+
+
+// FInputProcessorCostAnalyzer
+
+FInputProcessorBlueprintCost FInputProcessorCostAnalyzer::Analyze(const UBlueprint* Blueprint)
+{
+	FInputProcessorBlueprintCost Cost;
+
+	const auto* Processor{ Blueprint && Blueprint->GeneratedClass ? Cast<UInputProcessor>(Blueprint->GeneratedClass->GetDefaultObject(false)) : nullptr };
+
+	if (!Processor)
+	{
+		return Cost;
+	}
+
+	Cost.Bindings = Processor->EstimateDispatchCost();
+
+	static const TPair<FName, ETriggerEvent> TriggerEvents[]
+	{
+		{ GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnTriggered),	ETriggerEvent::Triggered },
+		{ GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnStarted),	ETriggerEvent::Started },
+		{ GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnOngoing),	ETriggerEvent::Ongoing },
+		{ GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnCanceled),	ETriggerEvent::Canceled },
+		{ GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnComplete),	ETriggerEvent::Completed },
+	};
+
+	const auto BoundTriggerEvents{ Processor->GetBoundTriggerEvents() };
+
+	for (const auto& TriggerEvent : TriggerEvents)
+	{
+		if (const auto* EventNode{ FindEventNode(Blueprint, TriggerEvent.Key) })
+		{
+			const auto NumNodes{ CountNodesRunByEvent(EventNode) };
+
+			Cost.EventNodes.Emplace(EventNode, NumNodes);
+
+			const auto bPerFrame{ (TriggerEvent.Value == ETriggerEvent::Triggered) || (TriggerEvent.Value == ETriggerEvent::Ongoing) };
+
+			if (bPerFrame && (BoundTriggerEvents & static_cast<uint8>(TriggerEvent.Value)))
+			{
+				Cost.NumPerFrameNodes += Cost.Bindings.NumBoundActions * NumNodes;
+			}
+		}
+	}
+
+	return Cost;
+}
+
+void FInputProcessorCostAnalyzer::Report(const UBlueprint* Blueprint, const FInputProcessorBlueprintCost& Cost, FCompilerResultsLog& MessageLog)
+{
+	const auto& Bindings{ Cost.Bindings };
+
+	MessageLog.Note(*FString::Printf(TEXT("Input dispatch cost: %d actions, %d bindings, %d per-frame bindings, up to %d nodes per frame"),
+		Bindings.NumBoundActions, Bindings.NumBindings, Bindings.NumPerFrameBindings, Cost.NumPerFrameNodes));
+
+	for (const auto& Pair : Cost.EventNodes)
+	{
+		MessageLog.Note(*FString::Printf(TEXT("@@ runs %d nodes"), Pair.Value), Pair.Key);
+	}
+
+	for (const auto& InputTag : Bindings.DigitalPerFrameTags)
+	{
+		MessageLog.Warning(*FString::Printf(TEXT("%s is a digital action bound with Triggered or Ongoing, which dispatch every frame while it is held"), *InputTag.ToString()));
+	}
+
+	if (Bindings.NumPerFrameBindings > UInputProcessor::GetMaxPerFrameBindings())
+	{
+		MessageLog.Warning(*FString::Printf(TEXT("%d bindings can dispatch every frame, above the budget of %d (GEInput.Validation.MaxPerFrameBindings)"),
+			Bindings.NumPerFrameBindings, UInputProcessor::GetMaxPerFrameBindings()));
+	}
+
+	if (Cost.NumPerFrameNodes > GEInputValidation::MaxPerFrameNodes)
+	{
+		MessageLog.Warning(*FString::Printf(TEXT("Up to %d nodes can run every frame, above the budget of %d (GEInput.Validation.MaxPerFrameNodes). Consider generating a native stub."),
+			Cost.NumPerFrameNodes, GEInputValidation::MaxPerFrameNodes));
+	}
+}
+
+
+UK2Node_Event* FInputProcessorCostAnalyzer::FindEventNode(const UBlueprint* Blueprint, FName EventName)
+{
+	for (const auto* Graph : Blueprint->UbergraphPages)
+	{
+		for (auto* Node : Graph->Nodes)
+		{
+			if (auto* EventNode{ Cast<UK2Node_Event>(Node) }; EventNode && EventNode->bOverrideFunction && (EventNode->EventReference.GetMemberName() == EventName))
+			{
+				return EventNode;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+int32 FInputProcessorCostAnalyzer::CountNodesRunByEvent(const UK2Node_Event* EventNode)
+{
+	TSet<const UEdGraphNode*> Visited;
+	TArray<const UEdGraphNode*> Pending;
+
+	Visited.Add(EventNode);
+	Pending.Add(EventNode);
+
+	// Follows the execution flow forward and the data inputs backward to the pure nodes evaluated on the way
+
+	while (!Pending.IsEmpty())
+	{
+		const auto* Node{ Pending.Pop() };
+
+		for (const auto* Pin : Node->Pins)
+		{
+			const auto bExec{ Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec };
+
+			if ((bExec && (Pin->Direction == EGPD_Output)) || (!bExec && (Pin->Direction == EGPD_Input)))
+			{
+				for (const auto* LinkedPin : Pin->LinkedTo)
+				{
+					const auto* LinkedNode{ LinkedPin->GetOwningNode() };
+					const auto* LinkedK2Node{ Cast<UK2Node>(LinkedNode) };
+
+					if (!bExec && (!LinkedK2Node || !LinkedK2Node->IsNodePure()))
+					{
+						continue;
+					}
+
+					if (!Visited.Contains(LinkedNode))
+					{
+						Visited.Add(LinkedNode);
+						Pending.Add(LinkedNode);
+					}
+				}
+			}
+		}
+	}
+
+	return Visited.Num() - 1;
+}
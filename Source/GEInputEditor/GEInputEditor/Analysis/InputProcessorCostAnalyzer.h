@@ -0,0 +1,61 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Processor/InputProcessorCost.h"
+
+class UBlueprint;
+class UK2Node_Event;
+class FCompilerResultsLog;
+
+
+/**
+ * Estimated dispatch cost of an InputProcessor Blueprint
+ */
+struct FInputProcessorBlueprintCost
+{
+public:
+	//
+	// Estimate of the bindings of the class default object
+	//
+	FInputProcessorCostEstimate Bindings;
+
+	//
+	// Event nodes of the trigger events implemented by the Blueprint and the number of nodes each one runs
+	//
+	TArray<TPair<const UK2Node_Event*, int32>> EventNodes;
+
+	//
+	// Worst case number of nodes run in a frame in which every action is held
+	//
+	int32 NumPerFrameNodes{ 0 };
+};
+
+
+/**
+ * Estimates the per-frame dispatch cost of InputProcessor Blueprints from their bindings and event graphs
+ */
+class FInputProcessorCostAnalyzer
+{
+public:
+	/**
+	 * Analyzes the class default object and the event graph of the compiled Blueprint
+	 */
+	static FInputProcessorBlueprintCost Analyze(const UBlueprint* Blueprint);
+
+	/**
+	 * Writes the estimate and the warnings about expensive configurations to the compiler results
+	 */
+	static void Report(const UBlueprint* Blueprint, const FInputProcessorBlueprintCost& Cost, FCompilerResultsLog& MessageLog);
+
+	/**
+	 * Returns the override of the event in the event graph of the Blueprint
+	 */
+	static UK2Node_Event* FindEventNode(const UBlueprint* Blueprint, FName EventName);
+
+	/**
+	 * Returns the number of nodes run when the event fires, pure nodes included and function graphs counted as one node
+	 */
+	static int32 CountNodesRunByEvent(const UK2Node_Event* EventNode);
+
+};
@@ -5,11 +5,14 @@
 #include "Processor/InputProcessorBlueprint.h"
 #include "Processor/InputProcessor.h"
 #include "Factory/InputProcessorBlueprintFactory.h"
+#include "Codegen/InputProcessorStubGenerator.h"
 #include "GEInputEditor.h"
 
 #include "Misc/MessageDialog.h"
 #include "BlueprintEditor.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "ToolMenuSection.h"
+#include "HAL/PlatformProcess.h"
 
 
 #define LOCTEXT_NAMESPACE "AssetTypeActions"
@@ -45,6 +48,21 @@ const TArray<FText>& FAssetTypeActions_InputProcessorBlueprint::GetSubMenus() co
 }
 
 
+void FAssetTypeActions_InputProcessorBlueprint::GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section)
+{
+	FAssetTypeActions_Blueprint::GetActions(InObjects, Section);
+
+	auto Blueprints{ GetTypedWeakObjectPtrs<UBlueprint>(InObjects) };
+
+	Section.AddMenuEntry(
+		"InputProcessorBlueprint_GenerateNativeStub",
+		LOCTEXT("InputProcessorBlueprint_GenerateNativeStub", "Generate Native Stub"),
+		LOCTEXT("InputProcessorBlueprint_GenerateNativeStubTooltip", "Generates the source of a native InputProcessor that dispatches the input events like the event graph of this Blueprint."),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &FAssetTypeActions_InputProcessorBlueprint::ExecuteGenerateNativeStub, Blueprints)));
+}
+
+
 void FAssetTypeActions_InputProcessorBlueprint::OpenAssetEditor( const TArray<UObject*>& InObjects, TSharedPtr<IToolkitHost> EditWithinLevelEditor )
 {
 	auto Mode{ EditWithinLevelEditor.IsValid() ? EToolkitMode::WorldCentric : EToolkitMode::Standalone };
@@ -103,4 +121,37 @@ bool FAssetTypeActions_InputProcessorBlueprint::ShouldUseDataOnlyEditor(const UB
 		&& !Blueprint->bIsNewlyCreated;
 }
 
+void FAssetTypeActions_InputProcessorBlueprint::ExecuteGenerateNativeStub(TArray<TWeakObjectPtr<UBlueprint>> Blueprints)
+{
+	const auto Directory{ FInputProcessorStubGenerator::GetDefaultOutputDirectory() };
+
+	TArray<FString> Lines;
+	auto bAnyWritten{ false };
+
+	for (const auto& WeakBlueprint : Blueprints)
+	{
+		if (auto* Blueprint{ WeakBlueprint.Get() })
+		{
+			FInputProcessorStubGenerator Generator(Blueprint);
+
+			if (Generator.Generate())
+			{
+				bAnyWritten |= Generator.WriteFiles(Directory);
+			}
+
+			Lines.Append(Generator.GetReport().Messages);
+		}
+	}
+
+	Lines.Add(FString());
+	Lines.Add(FString::Printf(TEXT("Output: %s"), *Directory));
+
+	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Join(Lines, TEXT("\n"))));
+
+	if (bAnyWritten)
+	{
+		FPlatformProcess::ExploreFolder(*Directory);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -17,6 +17,9 @@ public:
 	virtual FColor GetTypeColor() const override;
 	virtual uint32 GetCategories() override;
 	virtual const TArray<FText>& GetSubMenus() const override;
+
+	virtual bool HasActions(const TArray<UObject*>& InObjects) const override { return true; }
+	virtual void GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section) override;
 	
 	virtual void OpenAssetEditor(const TArray<UObject*>& InObjects, TSharedPtr<class IToolkitHost> EditWithinLevelEditor = TSharedPtr<IToolkitHost>()) override;
 
@@ -28,4 +31,9 @@ private:
 	 */
 	bool ShouldUseDataOnlyEditor(const UBlueprint* Blueprint) const;
 
+	/**
+	 * Generates the source of a native UInputProcessor subclass for each Blueprint
+	 */
+	void ExecuteGenerateNativeStub(TArray<TWeakObjectPtr<UBlueprint>> Blueprints);
+
 };
@@ -0,0 +1,883 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "InputProcessorStubGenerator.h"
+
+#include "Analysis/InputProcessorCostAnalyzer.h"
+#include "Processor/InputProcessor.h"
+#include "GEInputLogs.h"
+
+#include "Engine/Blueprint.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_Event.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_Self.h"
+#include "K2Node_Switch.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "GameplayTagContainer.h"
+#include "Misc/DefaultValueHelper.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+namespace InputProcessorStubGenerator
+{
+	static constexpr int32 MaxDepth{ 64 };
+
+	static const FName SwitchGameplayTagNodeName{ TEXT("GameplayTagsK2Node_SwitchGameplayTag") };
+	static const FName PinTagsPropertyName{ TEXT("PinTags") };
+
+	/**
+	 * Events dispatched by UInputProcessComponent that are translated to native overrides
+	 */
+	static const FName TriggerEventNames[]
+	{
+		GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnTriggered),
+		GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnStarted),
+		GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnOngoing),
+		GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnCanceled),
+		GET_FUNCTION_NAME_CHECKED(UInputProcessor, OnComplete),
+	};
+
+	/**
+	 * Conversions from FInputActionValue exposed by UEnhancedInputLibrary and their native equivalent
+	 */
+	static const TPair<FName, const TCHAR*> ValueConversions[]
+	{
+		{ TEXT("Conv_InputActionValueToBool"),	TEXT("Get<bool>()") },
+		{ TEXT("Conv_InputActionValueToAxis1D"),	TEXT("Get<float>()") },
+		{ TEXT("Conv_InputActionValueToAxis2D"),	TEXT("Get<FVector2D>()") },
+		{ TEXT("Conv_InputActionValueToAxis3D"),	TEXT("Get<FVector>()") },
+	};
+
+	static FString GetNodeTitle(const UEdGraphNode* Node)
+	{
+		return Node ? Node->GetNodeTitle(ENodeTitleType::ListView).ToString() : FString(TEXT("None"));
+	}
+
+	static FString MakeIdentifier(const FString& Source)
+	{
+		FString Result;
+		Result.Reserve(Source.Len());
+
+		for (const auto Char : Source)
+		{
+			Result.AppendChar(FChar::IsAlnum(Char) ? Char : TEXT('_'));
+		}
+
+		if (Result.IsEmpty() || FChar::IsDigit(Result[0]))
+		{
+			Result.InsertAt(0, TEXT('_'));
+		}
+
+		return Result;
+	}
+}
+
+
+// FInputProcessorStubGenerator
+
+FInputProcessorStubGenerator::FInputProcessorStubGenerator(UBlueprint* InBlueprint)
+	: Blueprint(InBlueprint)
+{
+	if (Blueprint)
+	{
+		NativeParentClass = FBlueprintEditorUtils::FindFirstNativeClass(Blueprint->ParentClass);
+
+		auto BaseName{ Blueprint->GetName() };
+		BaseName.RemoveFromStart(TEXT("BP_"));
+
+		ClassName = InputProcessorStubGenerator::MakeIdentifier(BaseName) + TEXT("_Native");
+	}
+}
+
+
+bool FInputProcessorStubGenerator::Generate()
+{
+	if (!Blueprint || !NativeParentClass || !Blueprint->GeneratedClass || !NativeParentClass->IsChildOf(UInputProcessor::StaticClass()))
+	{
+		Report.Messages.Add(TEXT("The asset is not a compiled InputProcessor Blueprint"));
+		return false;
+	}
+
+	FString Declarations;
+	FString Definitions;
+
+	for (const auto& EventName : InputProcessorStubGenerator::TriggerEventNames)
+	{
+		GenerateHandler(EventName, Declarations, Definitions);
+	}
+
+	if (Report.NumHandlers <= 0)
+	{
+		Report.Messages.Add(TEXT("The Blueprint does not implement any trigger event"));
+		return false;
+	}
+
+	const auto BlueprintPath{ Blueprint->GetPathName() };
+	const auto ParentName{ GetCPPClassName(NativeParentClass) };
+
+	// Header
+
+	HeaderText.Reset();
+	HeaderText += TEXT("// Generated from ") + BlueprintPath + TEXT(" by GEInputEditor, review before adding it to a game module\n\n");
+	HeaderText += TEXT("#pragma once\n\n");
+	HeaderText += FString::Printf(TEXT("#include \"%s\"\n\n"), *NativeParentClass->GetMetaData(TEXT("IncludePath")));
+	HeaderText += FString::Printf(TEXT("#include \"%s.generated.h\"\n\n\n"), *ClassName);
+	HeaderText += TEXT("/**\n");
+	HeaderText += TEXT(" * Native dispatch of ") + Blueprint->GetName() + TEXT("\n");
+	HeaderText += TEXT(" *\n");
+	HeaderText += TEXT(" * Tips:\n");
+	HeaderText += TEXT(" *\tReparent the Blueprint to this class, then remove the translated events and variables from it.\n");
+	HeaderText += TEXT(" *\tAdd the export macro of the game module to the class declaration.\n");
+	HeaderText += TEXT(" */\n");
+	HeaderText += TEXT("UCLASS(Abstract, Blueprintable)\n");
+	HeaderText += FString::Printf(TEXT("class U%s : public %s\n"), *ClassName, *ParentName);
+	HeaderText += TEXT("{\n\tGENERATED_BODY()\npublic:\n");
+	HeaderText += FString::Printf(TEXT("\tU%s() {}\n\n"), *ClassName);
+
+	if (!MemberVariables.IsEmpty())
+	{
+		HeaderText += TEXT("protected:\n");
+
+		for (const auto& VariableName : MemberVariables)
+		{
+			const auto* Property{ FindFProperty<FProperty>(Blueprint->GeneratedClass, VariableName) };
+
+			HeaderText += TEXT("\tUPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Generated\")\n");
+			HeaderText += FString::Printf(TEXT("\t%s %s;\n\n"), Property ? *Property->GetCPPType() : TEXT("/* TODO: unknown type */ int32"), *VariableName.ToString());
+		}
+	}
+
+	HeaderText += TEXT("protected:\n");
+	HeaderText += Declarations;
+	HeaderText += TEXT("\n};\n");
+
+	// Source
+
+	SourceText.Reset();
+	SourceText += TEXT("// Generated from ") + BlueprintPath + TEXT(" by GEInputEditor, review before adding it to a game module\n\n");
+	SourceText += FString::Printf(TEXT("#include \"%s.h\"\n\n"), *ClassName);
+	SourceText += TEXT("#include \"InputActionValue.h\"\n");
+
+	if (!NativeTags.IsEmpty())
+	{
+		SourceText += TEXT("#include \"NativeGameplayTags.h\"\n");
+	}
+
+	auto SortedIncludes{ IncludePaths.Array() };
+	SortedIncludes.Sort();
+
+	for (const auto& IncludePath : SortedIncludes)
+	{
+		SourceText += FString::Printf(TEXT("#include \"%s\"\n"), *IncludePath);
+	}
+
+	SourceText += FString::Printf(TEXT("\n#include UE_INLINE_GENERATED_CPP_BY_NAME(%s)\n\n\n"), *ClassName);
+
+	if (!NativeTags.IsEmpty())
+	{
+		NativeTags.ValueSort(TLess<FString>());
+
+		for (const auto& Pair : NativeTags)
+		{
+			SourceText += FString::Printf(TEXT("UE_DEFINE_GAMEPLAY_TAG_STATIC(%s, \"%s\");\n"), *Pair.Value, *Pair.Key);
+		}
+
+		SourceText += TEXT("\n\n");
+	}
+
+	SourceText += FString::Printf(TEXT("// U%s\n\n"), *ClassName);
+	SourceText += Definitions;
+
+	Report.Messages.Insert(FString::Printf(TEXT("%s: %d handlers, %d nodes translated, %d left as TODO"),
+		*Blueprint->GetName(), Report.NumHandlers, Report.NumTranslatedNodes, Report.NumUnsupportedNodes), 0);
+
+	return true;
+}
+
+bool FInputProcessorStubGenerator::WriteFiles(const FString& Directory)
+{
+	if (HeaderText.IsEmpty() || SourceText.IsEmpty())
+	{
+		return false;
+	}
+
+	Report.HeaderPath = Directory / ClassName + TEXT(".h");
+	Report.SourcePath = Directory / ClassName + TEXT(".cpp");
+
+	if (!FFileHelper::SaveStringToFile(HeaderText, *Report.HeaderPath) || !FFileHelper::SaveStringToFile(SourceText, *Report.SourcePath))
+	{
+		Report.Messages.Add(TEXT("Failed to write ") + Report.HeaderPath);
+		return false;
+	}
+
+	UE_LOG(LogGameCore_Input, Log, TEXT("Generated native stub of %s at %s"), *Blueprint->GetPathName(), *Report.HeaderPath);
+
+	return true;
+}
+
+FString FInputProcessorStubGenerator::GetDefaultOutputDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GEInput") / TEXT("NativeStubs");
+}
+
+
+bool FInputProcessorStubGenerator::GenerateHandler(FName EventName, FString& OutDeclaration, FString& OutDefinition)
+{
+	CurrentEvent = FInputProcessorCostAnalyzer::FindEventNode(Blueprint, EventName);
+
+	if (!CurrentEvent)
+	{
+		return false;
+	}
+
+	LocalNames.Reset();
+	NextLocalIndex = 0;
+
+	FString Body;
+	EmitExecChain(CurrentEvent->FindPin(UEdGraphSchema_K2::PN_Then), 1, Body);
+
+	CurrentEvent = nullptr;
+
+	if (Body.IsEmpty())
+	{
+		return false;
+	}
+
+	const auto Signature{ FString::Printf(TEXT("%s_Implementation(const FGameplayTag& InputTag, const FInputActionValue& InputActionValue)"), *EventName.ToString()) };
+
+	OutDeclaration += FString::Printf(TEXT("\tvirtual void %s override;\n"), *Signature);
+	OutDefinition += FString::Printf(TEXT("void U%s::%s\n{\n%s}\n\n"), *ClassName, *Signature, *Body);
+
+	Report.NumHandlers++;
+
+	return true;
+}
+
+
+void FInputProcessorStubGenerator::EmitExecChain(const UEdGraphPin* ExecOutputPin, int32 Indent, FString& Out, int32 Depth)
+{
+	const auto Tab{ MakeIndent(Indent) };
+
+	for (auto Steps{ 0 }; Steps < 256; ++Steps)
+	{
+		if (!ExecOutputPin || ExecOutputPin->LinkedTo.IsEmpty())
+		{
+			return;
+		}
+
+		auto* Node{ ExecOutputPin->LinkedTo[0]->GetOwningNode() };
+
+		if (Depth >= InputProcessorStubGenerator::MaxDepth)
+		{
+			EmitUnsupported(Node, TEXT("the graph is nested too deeply"), Indent, Out);
+			return;
+		}
+
+		FString Reason;
+
+		// Sequence: every output in order
+
+		if (auto* SequenceNode{ Cast<UK2Node_ExecutionSequence>(Node) })
+		{
+			for (const auto* Pin : SequenceNode->Pins)
+			{
+				if ((Pin->Direction == EGPD_Output) && (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+				{
+					EmitExecChain(Pin, Indent, Out, Depth + 1);
+				}
+			}
+
+			Report.NumTranslatedNodes++;
+			return;
+		}
+
+		// Switch on gameplay tag: if/else chain against native tags
+
+		if (auto* SwitchNode{ Cast<UK2Node_Switch>(Node) }; SwitchNode && (SwitchNode->GetClass()->GetFName() == InputProcessorStubGenerator::SwitchGameplayTagNodeName))
+		{
+			const auto* PinTagsProperty{ FindFProperty<FArrayProperty>(SwitchNode->GetClass(), InputProcessorStubGenerator::PinTagsPropertyName) };
+
+			FString Selection;
+			if (!PinTagsProperty || !ResolveExpression(SwitchNode->GetSelectionPin(), Selection, Reason, Depth + 1))
+			{
+				EmitUnsupported(Node, Reason.IsEmpty() ? FString(TEXT("unknown switch layout")) : Reason, Indent, Out);
+				return;
+			}
+
+			const auto* DefaultPin{ SwitchNode->GetDefaultPin() };
+			const auto& PinTags{ *PinTagsProperty->ContainerPtrToValuePtr<TArray<FGameplayTag>>(SwitchNode) };
+
+			auto CaseIndex{ 0 };
+
+			for (const auto* Pin : SwitchNode->Pins)
+			{
+				if ((Pin == DefaultPin) || (Pin->Direction != EGPD_Output) || (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec) || !PinTags.IsValidIndex(CaseIndex))
+				{
+					continue;
+				}
+
+				const auto& Tag{ PinTags[CaseIndex] };
+
+				Out += FString::Printf(TEXT("%s%s (%s == %s)\n%s{\n"), *Tab, (CaseIndex == 0) ? TEXT("if") : TEXT("else if"), *Selection, *GetNativeTagName(Tag.ToString()), *Tab);
+				EmitExecChain(Pin, Indent + 1, Out, Depth + 1);
+				Out += Tab + TEXT("}\n");
+
+				CaseIndex++;
+			}
+
+			if (DefaultPin && !DefaultPin->LinkedTo.IsEmpty())
+			{
+				Out += FString::Printf(TEXT("%selse\n%s{\n"), *Tab, *Tab);
+				EmitExecChain(DefaultPin, Indent + 1, Out, Depth + 1);
+				Out += Tab + TEXT("}\n");
+			}
+
+			Report.NumTranslatedNodes++;
+			return;
+		}
+
+		// Branch
+
+		if (auto* BranchNode{ Cast<UK2Node_IfThenElse>(Node) })
+		{
+			FString Condition;
+			if (!ResolveExpression(BranchNode->GetConditionPin(), Condition, Reason, Depth + 1))
+			{
+				EmitUnsupported(Node, Reason, Indent, Out);
+				return;
+			}
+
+			Out += FString::Printf(TEXT("%sif (%s)\n%s{\n"), *Tab, *Condition, *Tab);
+			EmitExecChain(BranchNode->GetThenPin(), Indent + 1, Out, Depth + 1);
+			Out += Tab + TEXT("}\n");
+
+			if (!BranchNode->GetElsePin()->LinkedTo.IsEmpty())
+			{
+				Out += FString::Printf(TEXT("%selse\n%s{\n"), *Tab, *Tab);
+				EmitExecChain(BranchNode->GetElsePin(), Indent + 1, Out, Depth + 1);
+				Out += Tab + TEXT("}\n");
+			}
+
+			Report.NumTranslatedNodes++;
+			return;
+		}
+
+		// Cast with execution pins: the result is a local valid inside the success branch
+
+		if (auto* CastNode{ Cast<UK2Node_DynamicCast>(Node) }; CastNode && !CastNode->IsNodePure())
+		{
+			FString Source;
+			if (!CastNode->TargetType || !CastNode->TargetType->HasAnyClassFlags(CLASS_Native))
+			{
+				EmitUnsupported(Node, TEXT("casts to a Blueprint class"), Indent, Out);
+				return;
+			}
+
+			if (!ResolveExpression(CastNode->GetCastSourcePin(), Source, Reason, Depth + 1))
+			{
+				EmitUnsupported(Node, Reason, Indent, Out);
+				return;
+			}
+
+			AddIncludeFor(CastNode->TargetType);
+
+			const auto LocalName{ MakeLocalName(TEXT("CastResult")) };
+			LocalNames.Add(CastNode->GetCastResultPin(), LocalName);
+
+			Out += FString::Printf(TEXT("%sif (auto* %s{ Cast<%s>(%s) })\n%s{\n"), *Tab, *LocalName, *GetCPPClassName(CastNode->TargetType), *Source, *Tab);
+			EmitExecChain(CastNode->GetValidCastPin(), Indent + 1, Out, Depth + 1);
+			Out += Tab + TEXT("}\n");
+
+			if (!CastNode->GetInvalidCastPin()->LinkedTo.IsEmpty())
+			{
+				Out += FString::Printf(TEXT("%selse\n%s{\n"), *Tab, *Tab);
+				EmitExecChain(CastNode->GetInvalidCastPin(), Indent + 1, Out, Depth + 1);
+				Out += Tab + TEXT("}\n");
+			}
+
+			Report.NumTranslatedNodes++;
+			return;
+		}
+
+		// Function call: a call on another object is guarded like the Blueprint VM does
+
+		if (auto* CallNode{ Cast<UK2Node_CallFunction>(Node) })
+		{
+			FString Target;
+			FString Call;
+			if (!BuildCallExpression(CallNode, Target, Call, Reason, Depth + 1))
+			{
+				EmitUnsupported(Node, Reason, Indent, Out);
+				return;
+			}
+
+			if (Target.IsEmpty())
+			{
+				Out += FString::Printf(TEXT("%s%s;\n"), *Tab, *Call);
+			}
+			else
+			{
+				const auto LocalName{ MakeLocalName(TEXT("CallTarget")) };
+
+				Out += FString::Printf(TEXT("%sif (auto* %s{ %s })\n%s{\n%s\t%s->%s;\n%s}\n"), *Tab, *LocalName, *Target, *Tab, *Tab, *LocalName, *Call, *Tab);
+			}
+
+			Report.NumTranslatedNodes++;
+			ExecOutputPin = CallNode->GetThenPin();
+			continue;
+		}
+
+		// Member variable assignment
+
+		if (auto* SetNode{ Cast<UK2Node_VariableSet>(Node) })
+		{
+			const auto VariableName{ SetNode->GetVarName() };
+
+			FString Value;
+			if (!SetNode->VariableReference.IsSelfContext() || !ResolveExpression(SetNode->FindPin(VariableName), Value, Reason, Depth + 1))
+			{
+				EmitUnsupported(Node, Reason.IsEmpty() ? FString(TEXT("only member variables are supported")) : Reason, Indent, Out);
+				return;
+			}
+
+			MemberVariables.AddUnique(VariableName);
+
+			Out += FString::Printf(TEXT("%s%s = %s;\n"), *Tab, *VariableName.ToString(), *Value);
+
+			Report.NumTranslatedNodes++;
+			ExecOutputPin = SetNode->FindPin(UEdGraphSchema_K2::PN_Then);
+			continue;
+		}
+
+		EmitUnsupported(Node, TEXT("the node type is not supported"), Indent, Out);
+		return;
+	}
+}
+
+void FInputProcessorStubGenerator::EmitUnsupported(const UEdGraphNode* Node, const FString& Reason, int32 Indent, FString& Out)
+{
+	const auto Title{ InputProcessorStubGenerator::GetNodeTitle(Node) };
+
+	Out += FString::Printf(TEXT("%s// TODO: \"%s\" was not translated (%s), the rest of this branch is omitted\n"), *MakeIndent(Indent), *Title, *Reason);
+
+	Report.NumUnsupportedNodes++;
+	Report.Messages.Add(FString::Printf(TEXT("%s: %s"), *Title, *Reason));
+}
+
+
+bool FInputProcessorStubGenerator::BuildCallExpression(const UK2Node_CallFunction* CallNode, FString& OutTarget, FString& OutCall, FString& OutReason, int32 Depth)
+{
+	const auto* Function{ CallNode->GetTargetFunction() };
+
+	if (!Function)
+	{
+		OutReason = TEXT("the function no longer exists");
+		return false;
+	}
+
+	// Input action value conversions are member templates of FInputActionValue
+
+	for (const auto& Conversion : InputProcessorStubGenerator::ValueConversions)
+	{
+		if (Function->GetFName() == Conversion.Key)
+		{
+			const auto* ValuePin{ CallNode->FindPin(TEXT("InValue")) };
+
+			FString Value;
+			if (!ValuePin || !ResolveExpression(ValuePin, Value, OutReason, Depth + 1))
+			{
+				return false;
+			}
+
+			OutTarget.Reset();
+			OutCall = Value + TEXT(".") + Conversion.Value;
+			return true;
+		}
+	}
+
+	if (!Function->HasAnyFunctionFlags(FUNC_Native))
+	{
+		OutReason = TEXT("calls a function defined in a Blueprint");
+		return false;
+	}
+
+	// Arguments
+
+	TArray<FString> Arguments;
+
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			continue;
+		}
+
+		const auto* Pin{ CallNode->FindPin(It->GetFName()) };
+
+		if (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ReferenceParm))
+		{
+			if (Pin && !Pin->LinkedTo.IsEmpty())
+			{
+				OutReason = TEXT("uses an output parameter");
+				return false;
+			}
+
+			Arguments.Add(FString::Printf(TEXT("/* out */ %s"), *It->GetName()));
+			continue;
+		}
+
+		FString Argument;
+		if (!Pin || !ResolveExpression(Pin, Argument, OutReason, Depth + 1))
+		{
+			return false;
+		}
+
+		Arguments.Add(Argument);
+	}
+
+	// Target
+
+	const auto* OwnerClass{ Function->GetOwnerClass() };
+	const auto FunctionCall{ FString::Printf(TEXT("%s(%s)"), *Function->GetName(), *FString::Join(Arguments, TEXT(", "))) };
+
+	OutTarget.Reset();
+
+	if (Function->HasAnyFunctionFlags(FUNC_Static))
+	{
+		AddIncludeFor(OwnerClass);
+
+		OutCall = GetCPPClassName(OwnerClass) + TEXT("::") + FunctionCall;
+		return true;
+	}
+
+	const auto* SelfPin{ CallNode->FindPin(UEdGraphSchema_K2::PN_Self) };
+
+	if (!SelfPin || SelfPin->LinkedTo.IsEmpty())
+	{
+		if (!Blueprint->GeneratedClass->IsChildOf(OwnerClass))
+		{
+			OutReason = TEXT("the target is not the processor");
+			return false;
+		}
+
+		OutCall = FunctionCall;
+		return true;
+	}
+
+	if (!ResolveExpression(SelfPin, OutTarget, OutReason, Depth + 1))
+	{
+		return false;
+	}
+
+	AddIncludeFor(OwnerClass);
+
+	if (OutTarget == TEXT("this"))
+	{
+		OutTarget.Reset();
+	}
+
+	OutCall = FunctionCall;
+	return true;
+}
+
+bool FInputProcessorStubGenerator::ResolveExpression(const UEdGraphPin* InputPin, FString& OutExpression, FString& OutReason, int32 Depth)
+{
+	if (!InputPin)
+	{
+		OutReason = TEXT("missing pin");
+		return false;
+	}
+
+	if (Depth >= InputProcessorStubGenerator::MaxDepth)
+	{
+		OutReason = TEXT("the expression is nested too deeply");
+		return false;
+	}
+
+	if (InputPin->LinkedTo.IsEmpty())
+	{
+		return GetDefaultLiteral(InputPin, OutExpression, OutReason);
+	}
+
+	const auto* SourcePin{ InputPin->LinkedTo[0] };
+	auto* SourceNode{ SourcePin->GetOwningNode() };
+
+	if (const auto* LocalName{ LocalNames.Find(SourcePin) })
+	{
+		OutExpression = *LocalName;
+		return true;
+	}
+
+	// Event parameters keep their names in the native signature
+
+	if (SourceNode == CurrentEvent)
+	{
+		OutExpression = SourcePin->PinName.ToString();
+		return true;
+	}
+
+	if (SourceNode->IsA<UK2Node_Self>())
+	{
+		OutExpression = TEXT("this");
+		return true;
+	}
+
+	if (auto* GetNode{ Cast<UK2Node_VariableGet>(SourceNode) })
+	{
+		if (!GetNode->IsNodePure() || !GetNode->VariableReference.IsSelfContext())
+		{
+			OutReason = TEXT("only member variables are supported");
+			return false;
+		}
+
+		const auto VariableName{ GetNode->GetVarName() };
+
+		// Variables declared by native classes are inherited, only Blueprint ones are declared by the stub
+
+		if (!NativeParentClass->FindPropertyByName(VariableName))
+		{
+			MemberVariables.AddUnique(VariableName);
+		}
+
+		OutExpression = VariableName.ToString();
+		return true;
+	}
+
+	if (auto* CastNode{ Cast<UK2Node_DynamicCast>(SourceNode) }; CastNode && CastNode->IsNodePure())
+	{
+		if (!CastNode->TargetType || !CastNode->TargetType->HasAnyClassFlags(CLASS_Native))
+		{
+			OutReason = TEXT("casts to a Blueprint class");
+			return false;
+		}
+
+		FString Source;
+		if (!ResolveExpression(CastNode->GetCastSourcePin(), Source, OutReason, Depth + 1))
+		{
+			return false;
+		}
+
+		AddIncludeFor(CastNode->TargetType);
+
+		OutExpression = FString::Printf(TEXT("Cast<%s>(%s)"), *GetCPPClassName(CastNode->TargetType), *Source);
+		return true;
+	}
+
+	if (auto* CallNode{ Cast<UK2Node_CallFunction>(SourceNode) }; CallNode && CallNode->IsNodePure())
+	{
+		if (SourcePin != CallNode->GetReturnValuePin())
+		{
+			OutReason = TEXT("uses an output parameter of a pure function");
+			return false;
+		}
+
+		FString Target;
+		FString Call;
+		if (!BuildCallExpression(CallNode, Target, Call, OutReason, Depth + 1))
+		{
+			return false;
+		}
+
+		OutExpression = Target.IsEmpty() ? Call : FString::Printf(TEXT("%s->%s"), *Target, *Call);
+		return true;
+	}
+
+	OutReason = FString::Printf(TEXT("reads a value from \"%s\""), *InputProcessorStubGenerator::GetNodeTitle(SourceNode));
+	return false;
+}
+
+bool FInputProcessorStubGenerator::GetDefaultLiteral(const UEdGraphPin* Pin, FString& OutLiteral, FString& OutReason)
+{
+	const auto& PinType{ Pin->PinType };
+	const auto& DefaultValue{ Pin->DefaultValue };
+
+	if (PinType.IsContainer())
+	{
+		OutReason = TEXT("container defaults are not supported");
+		return false;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean)
+	{
+		OutLiteral = DefaultValue.ToBool() ? TEXT("true") : TEXT("false");
+		return true;
+	}
+
+	if ((PinType.PinCategory == UEdGraphSchema_K2::PC_Int) || (PinType.PinCategory == UEdGraphSchema_K2::PC_Int64))
+	{
+		OutLiteral = DefaultValue.IsEmpty() ? FString(TEXT("0")) : DefaultValue;
+		return true;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Real)
+	{
+		const auto Value{ DefaultValue.IsEmpty() ? 0.0 : FCString::Atod(*DefaultValue) };
+		OutLiteral = FString::SanitizeFloat(Value) + ((PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float) ? TEXT("f") : TEXT(""));
+		return true;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		if (const auto* Enum{ Cast<UEnum>(PinType.PinSubCategoryObject.Get()) })
+		{
+			OutLiteral = DefaultValue.IsEmpty() ? Enum->GetNameByIndex(0).ToString() : Enum->GenerateFullEnumName(*DefaultValue);
+			return true;
+		}
+
+		OutLiteral = DefaultValue.IsEmpty() ? FString(TEXT("0")) : DefaultValue;
+		return true;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Enum)
+	{
+		if (const auto* Enum{ Cast<UEnum>(PinType.PinSubCategoryObject.Get()) })
+		{
+			OutLiteral = DefaultValue.IsEmpty() ? Enum->GetNameByIndex(0).ToString() : Enum->GenerateFullEnumName(*DefaultValue);
+			return true;
+		}
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Name)
+	{
+		OutLiteral = DefaultValue.IsEmpty() || (DefaultValue == TEXT("None")) ? FString(TEXT("NAME_None")) : FString::Printf(TEXT("FName(TEXT(\"%s\"))"), *DefaultValue);
+		return true;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_String)
+	{
+		OutLiteral = FString::Printf(TEXT("TEXT(\"%s\")"), *DefaultValue.ReplaceCharWithEscapedChar());
+		return true;
+	}
+
+	if ((PinType.PinCategory == UEdGraphSchema_K2::PC_Object) || (PinType.PinCategory == UEdGraphSchema_K2::PC_Class))
+	{
+		// Hidden object pins are world contexts and default to self
+
+		if (Pin->bHidden || (Pin->PinName == UEdGraphSchema_K2::PN_Self))
+		{
+			OutLiteral = TEXT("this");
+			return true;
+		}
+
+		if (!Pin->DefaultObject)
+		{
+			OutLiteral = TEXT("nullptr");
+			return true;
+		}
+
+		OutReason = TEXT("object defaults are not supported");
+		return false;
+	}
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Struct)
+	{
+		const auto* Struct{ Cast<UScriptStruct>(PinType.PinSubCategoryObject.Get()) };
+
+		if (Struct == FGameplayTag::StaticStruct())
+		{
+			FGameplayTag Tag;
+			Tag.FromExportString(DefaultValue);
+
+			OutLiteral = Tag.IsValid() ? GetNativeTagName(Tag.ToString()) : FString(TEXT("FGameplayTag::EmptyTag"));
+			return true;
+		}
+
+		if (Struct == TBaseStructure<FVector>::Get())
+		{
+			FVector Value{ FVector::ZeroVector };
+			FDefaultValueHelper::ParseVector(DefaultValue, Value);
+
+			OutLiteral = FString::Printf(TEXT("FVector(%s, %s, %s)"), *FString::SanitizeFloat(Value.X), *FString::SanitizeFloat(Value.Y), *FString::SanitizeFloat(Value.Z));
+			return true;
+		}
+
+		if (Struct == TBaseStructure<FVector2D>::Get())
+		{
+			FVector2D Value{ FVector2D::ZeroVector };
+			FDefaultValueHelper::ParseVector2D(DefaultValue, Value);
+
+			OutLiteral = FString::Printf(TEXT("FVector2D(%s, %s)"), *FString::SanitizeFloat(Value.X), *FString::SanitizeFloat(Value.Y));
+			return true;
+		}
+
+		if (Struct == TBaseStructure<FRotator>::Get())
+		{
+			FRotator Value{ FRotator::ZeroRotator };
+			FDefaultValueHelper::ParseRotator(DefaultValue, Value);
+
+			OutLiteral = FString::Printf(TEXT("FRotator(%s, %s, %s)"), *FString::SanitizeFloat(Value.Pitch), *FString::SanitizeFloat(Value.Yaw), *FString::SanitizeFloat(Value.Roll));
+			return true;
+		}
+
+		if (Struct && DefaultValue.IsEmpty())
+		{
+			OutLiteral = Struct->GetStructCPPName() + TEXT("()");
+			return true;
+		}
+	}
+
+	OutReason = FString::Printf(TEXT("the default value of \"%s\" is not supported"), *Pin->GetDisplayName().ToString());
+	return false;
+}
+
+
+FString FInputProcessorStubGenerator::GetNativeTagName(const FString& TagString)
+{
+	if (const auto* Existing{ NativeTags.Find(TagString) })
+	{
+		return *Existing;
+	}
+
+	return NativeTags.Add(TagString, TEXT("TAG_") + TagString.Replace(TEXT("."), TEXT("_")));
+}
+
+FString FInputProcessorStubGenerator::MakeLocalName(const TCHAR* Prefix)
+{
+	const auto* OwnerClass{ Blueprint->SkeletonGeneratedClass ? Blueprint->SkeletonGeneratedClass.Get() : NativeParentClass };
+
+	for (;;)
+	{
+		auto LocalName{ FString::Printf(TEXT("%s%d"), Prefix, NextLocalIndex++) };
+		const FName LocalFName{ *LocalName };
+
+		const auto bShadowsMember
+		{
+			(FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, LocalFName) != INDEX_NONE) ||
+			(OwnerClass && (OwnerClass->FindPropertyByName(LocalFName) || OwnerClass->FindFunctionByName(LocalFName)))
+		};
+
+		if (!bShadowsMember)
+		{
+			return LocalName;
+		}
+	}
+}
+
+void FInputProcessorStubGenerator::AddIncludeFor(const UClass* Class)
+{
+	if (const auto* NativeClass{ FBlueprintEditorUtils::FindFirstNativeClass(const_cast<UClass*>(Class)) })
+	{
+		const auto& IncludePath{ NativeClass->GetMetaData(TEXT("IncludePath")) };
+
+		if (!IncludePath.IsEmpty())
+		{
+			IncludePaths.Add(IncludePath);
+		}
+	}
+}
+
+FString FInputProcessorStubGenerator::GetCPPClassName(const UClass* Class)
+{
+	return Class ? FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName()) : FString();
+}
+
+FString FInputProcessorStubGenerator::MakeIndent(int32 Indent)
+{
+	return FString::ChrN(Indent, TEXT('\t'));
+}
@@ -0,0 +1,106 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraphNode;
+class UEdGraphPin;
+class UK2Node_Event;
+class UK2Node_CallFunction;
+
+
+/**
+ * Summary of a native stub generation
+ */
+struct FInputProcessorStubReport
+{
+public:
+	int32 NumHandlers{ 0 };
+	int32 NumTranslatedNodes{ 0 };
+	int32 NumUnsupportedNodes{ 0 };
+
+	TArray<FString> Messages;
+
+	FString HeaderPath;
+	FString SourcePath;
+};
+
+
+/**
+ * Translates the event graph of an InputProcessor Blueprint into the source of an equivalent native UInputProcessor subclass
+ *
+ * Tips:
+ *	Supported patterns are switches and branches on the input tag, calls to native functions with values converted
+ *	from the input action value, casts and member variable assignments.
+ *	Anything else is left as a TODO comment in the generated source, which must be reviewed before it is added to a game module.
+ */
+class FInputProcessorStubGenerator
+{
+public:
+	explicit FInputProcessorStubGenerator(UBlueprint* InBlueprint);
+
+private:
+	UBlueprint* Blueprint{ nullptr };
+	UClass* NativeParentClass{ nullptr };
+
+	FString ClassName;
+
+	FString HeaderText;
+	FString SourceText;
+
+	FInputProcessorStubReport Report;
+
+	//
+	// State of the handler being generated
+	//
+	UK2Node_Event* CurrentEvent{ nullptr };
+	TMap<const UEdGraphPin*, FString> LocalNames;
+	int32 NextLocalIndex{ 0 };
+
+	//
+	// Declarations required by the generated code
+	//
+	TArray<FName> MemberVariables;
+	TSet<FString> IncludePaths;
+	TMap<FString, FString> NativeTags;
+
+public:
+	/**
+	 * Analyzes the Blueprint and generates the header and source text
+	 */
+	bool Generate();
+
+	/**
+	 * Writes the generated files to the directory
+	 */
+	bool WriteFiles(const FString& Directory);
+
+	const FInputProcessorStubReport& GetReport() const { return Report; }
+
+	static FString GetDefaultOutputDirectory();
+
+private:
+	bool GenerateHandler(FName EventName, FString& OutDeclaration, FString& OutDefinition);
+
+	void EmitExecChain(const UEdGraphPin* ExecOutputPin, int32 Indent, FString& Out, int32 Depth = 0);
+	void EmitUnsupported(const UEdGraphNode* Node, const FString& Reason, int32 Indent, FString& Out);
+
+	bool BuildCallExpression(const UK2Node_CallFunction* CallNode, FString& OutTarget, FString& OutCall, FString& OutReason, int32 Depth);
+	bool ResolveExpression(const UEdGraphPin* InputPin, FString& OutExpression, FString& OutReason, int32 Depth);
+	bool GetDefaultLiteral(const UEdGraphPin* Pin, FString& OutLiteral, FString& OutReason);
+
+	FString GetNativeTagName(const FString& TagString);
+
+	/**
+	 * Returns a name for a local of the handler that does not shadow a member of the Blueprint or its parents
+	 */
+	FString MakeLocalName(const TCHAR* Prefix);
+
+	void AddIncludeFor(const UClass* Class);
+
+	static FString GetCPPClassName(const UClass* Class);
+	static FString MakeIndent(int32 Indent);
+
+};
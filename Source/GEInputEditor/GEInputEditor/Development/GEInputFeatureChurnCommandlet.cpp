@@ -0,0 +1,409 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "GEInputFeatureChurnCommandlet.h"
+
+#include "InputProcessComponent.h"
+#include "GameFeature/GameFeatureAction_AddInputContextMapping.h"
+#include "GameFeature/GameFeatureAction_AddInputProcessors.h"
+#include "GEInputLogs.h"
+
+#include "GameFeaturesSubsystem.h"
+#include "Components/GameFrameworkComponentManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Containers/Ticker.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GEInputFeatureChurnCommandlet)
+
+
+namespace GEInputFeatureChurn
+{
+	constexpr float FrameDeltaSeconds{ 1.0f / 60.0f };
+	constexpr double FeatureStateTimeoutSeconds{ 60.0 };
+
+	static double CyclesToMilliseconds(uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles);
+	}
+
+	static void PumpEngine()
+	{
+		FTSTicker::GetCoreTicker().Tick(FrameDeltaSeconds);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		ProcessAsyncLoading(true, false, 0.005f);
+	}
+}
+
+
+UGEInputFeatureChurnCommandlet::UGEInputFeatureChurnCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+
+int32 UGEInputFeatureChurnCommandlet::Main(const FString& Params)
+{
+	// Parse parameters
+
+	FString FeaturesString;
+	if (!FParse::Value(*Params, TEXT("Features="), FeaturesString, false))
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: -Features=FeatureA+FeatureB is required"));
+		return 1;
+	}
+
+	TArray<FString> FeatureNames;
+	FeaturesString.ParseIntoArray(FeatureNames, TEXT("+"));
+
+	TArray<FString> PluginURLs;
+	for (const auto& FeatureName : FeatureNames)
+	{
+		FString PluginURL;
+		if (UGameFeaturesSubsystem::Get().GetPluginURLByName(FeatureName, PluginURL))
+		{
+			PluginURLs.Add(PluginURL);
+		}
+		else
+		{
+			UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Game feature plugin not found (%s)"), *FeatureName);
+			return 1;
+		}
+	}
+
+	TArray<int32> PlayerCounts{ 1, 16, 64 };
+	FString PlayersString;
+	if (FParse::Value(*Params, TEXT("Players="), PlayersString, false))
+	{
+		TArray<FString> Parts;
+		PlayersString.ParseIntoArray(Parts, TEXT(","));
+
+		PlayerCounts.Reset();
+		for (const auto& Part : Parts)
+		{
+			PlayerCounts.Add(FMath::Max(1, FCString::Atoi(*Part)));
+		}
+	}
+
+	auto NumCycles{ 10 };
+	auto NumFrames{ 30 };
+	FParse::Value(*Params, TEXT("Cycles="), NumCycles);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+
+	FString MapName;
+	FParse::Value(*Params, TEXT("Map="), MapName);
+
+	auto OutputDirectory{ FPaths::ProfilingDir() / TEXT("GEInput") };
+	FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+
+	// Run cycles for each player count
+
+	UGameInstance* GameInstance{ nullptr };
+	auto* World{ CreateTestWorld(GameInstance, MapName) };
+
+	if (!World)
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Failed to create test world"));
+		return 1;
+	}
+
+	TArray<FCycleResult> Results;
+	auto bHasLeaks{ false };
+
+	for (const auto NumPlayers : PlayerCounts)
+	{
+		TArray<AActor*> Actors;
+		TArray<ULocalPlayer*> LocalPlayers;
+		SpawnPlayers(GameInstance, World, NumPlayers, Actors, LocalPlayers);
+
+		if (LocalPlayers.Num() < NumPlayers)
+		{
+			UE_LOG(LogGameCore_Input, Warning, TEXT("FeatureChurn: Only %d of %d controllers have a local player, mapping context churn is not measured for the rest"),
+				LocalPlayers.Num(), NumPlayers);
+		}
+
+		for (int32 Cycle{ 0 }; Cycle < NumCycles; ++Cycle)
+		{
+			auto& Result{ Results.AddDefaulted_GetRef() };
+			Result.NumPlayers = NumPlayers;
+			Result.NumLocalPlayers = LocalPlayers.Num();
+			Result.Cycle = Cycle;
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			const auto ObjectsBefore{ GUObjectArray.GetObjectArrayNumMinusAvailable() };
+
+			double MaxFrameMs{ 0.0 }, AvgFrameMs{ 0.0 };
+
+			if (!SetFeaturesActive(PluginURLs, true, World, Result.ActivationMs))
+			{
+				UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Failed to activate features"));
+				DestroyTestWorld(GameInstance);
+				return 1;
+			}
+
+			TickFrames(World, NumFrames, MaxFrameMs, AvgFrameMs);
+			Result.MaxFrameMs = MaxFrameMs;
+			Result.AvgFrameMs = AvgFrameMs;
+
+			if (!SetFeaturesActive(PluginURLs, false, World, Result.DeactivationMs))
+			{
+				UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Failed to deactivate features"));
+				DestroyTestWorld(GameInstance);
+				return 1;
+			}
+
+			TickFrames(World, NumFrames, MaxFrameMs, AvgFrameMs);
+			Result.MaxFrameMs = FMath::Max(Result.MaxFrameMs, MaxFrameMs);
+
+			CountTrackedEntries(Result.TrackedControllers, Result.TrackedActors, Result.StaleEntries);
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			Result.UObjectDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+
+			bHasLeaks |= (Result.TrackedControllers > 0) || (Result.TrackedActors > 0);
+
+			UE_LOG(LogGameCore_Input, Display, TEXT("FeatureChurn: Players=%d LocalPlayers=%d Cycle=%d Activate=%.2fms Deactivate=%.2fms MaxFrame=%.2fms AvgFrame=%.2fms UObjectDelta=%d LeakedControllers=%d LeakedActors=%d Stale=%d"),
+				NumPlayers, Result.NumLocalPlayers, Cycle, Result.ActivationMs, Result.DeactivationMs, Result.MaxFrameMs, Result.AvgFrameMs,
+				Result.UObjectDelta, Result.TrackedControllers, Result.TrackedActors, Result.StaleEntries);
+		}
+
+		DestroyPlayers(GameInstance, World, Actors, LocalPlayers);
+	}
+
+	DestroyTestWorld(GameInstance);
+
+	// Write results
+
+	FString Csv{ TEXT("Players,LocalPlayers,Cycle,ActivationMs,DeactivationMs,MaxFrameMs,AvgFrameMs,UObjectDelta,LeakedControllers,LeakedActors,StaleEntries\n") };
+	for (const auto& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%d\n"),
+			Result.NumPlayers, Result.NumLocalPlayers, Result.Cycle, Result.ActivationMs, Result.DeactivationMs, Result.MaxFrameMs, Result.AvgFrameMs,
+			Result.UObjectDelta, Result.TrackedControllers, Result.TrackedActors, Result.StaleEntries);
+	}
+
+	const auto CsvFilename{ OutputDirectory / FString::Printf(TEXT("FeatureChurn-%s.csv"), *FDateTime::Now().ToString()) };
+	if (FFileHelper::SaveStringToFile(Csv, *CsvFilename))
+	{
+		UE_LOG(LogGameCore_Input, Display, TEXT("FeatureChurn: Results written to %s"), *CsvFilename);
+	}
+
+	if (bHasLeaks)
+	{
+		UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Controller or actor entries were left after deactivation"));
+	}
+
+	return bHasLeaks ? 1 : 0;
+}
+
+
+UWorld* UGEInputFeatureChurnCommandlet::CreateTestWorld(UGameInstance*& OutGameInstance, const FString& MapName) const
+{
+	OutGameInstance = NewObject<UGameInstance>(GEngine);
+	OutGameInstance->AddToRoot();
+	OutGameInstance->InitializeStandalone(TEXT("GEInputFeatureChurnWorld"));
+
+	auto* WorldContext{ OutGameInstance->GetWorldContext() };
+
+	if (!WorldContext)
+	{
+		return nullptr;
+	}
+
+	if (!MapName.IsEmpty())
+	{
+		FString Error;
+		if (!GEngine->LoadMap(*WorldContext, FURL(*MapName), nullptr, Error))
+		{
+			UE_LOG(LogGameCore_Input, Error, TEXT("FeatureChurn: Failed to load map %s (%s)"), *MapName, *Error);
+			return nullptr;
+		}
+	}
+
+	auto* World{ WorldContext->World() };
+
+	if (World && !World->HasBegunPlay())
+	{
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	return World;
+}
+
+void UGEInputFeatureChurnCommandlet::DestroyTestWorld(UGameInstance* GameInstance) const
+{
+	if (GameInstance)
+	{
+		if (auto* World{ GameInstance->GetWorld() })
+		{
+			World->DestroyWorld(false);
+			GEngine->DestroyWorldContext(World);
+		}
+
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+	}
+}
+
+
+void UGEInputFeatureChurnCommandlet::SpawnPlayers(UGameInstance* GameInstance, UWorld* World, int32 NumPlayers, TArray<AActor*>& OutActors, TArray<ULocalPlayer*>& OutLocalPlayers) const
+{
+	auto AddInputComponent
+	{
+		[](AActor* Actor)
+		{
+			UGameFrameworkComponentManager::AddGameFrameworkComponentReceiver(Actor);
+
+			auto* InputComponent{ NewObject<UInputProcessComponent>(Actor, TEXT("InputProcessComponent")) };
+			Actor->InputComponent = InputComponent;
+			InputComponent->RegisterComponent();
+		}
+	};
+
+	for (int32 Index{ 0 }; Index < NumPlayers; ++Index)
+	{
+		auto* Controller{ World->SpawnActor<APlayerController>() };
+		auto* Pawn{ World->SpawnActor<APawn>() };
+
+		AddInputComponent(Controller);
+		AddInputComponent(Pawn);
+
+		// UGameInstance::CreateLocalPlayer refuses to create players without a game viewport,
+		// so the local player is added directly and assigned to the spawned controller
+
+		auto* LocalPlayer{ NewObject<ULocalPlayer>(GEngine, GEngine->LocalPlayerClass) };
+		if (GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(Index)) != INDEX_NONE)
+		{
+			Controller->SetPlayer(LocalPlayer);
+			OutLocalPlayers.Add(LocalPlayer);
+		}
+
+		Controller->Possess(Pawn);
+
+		OutActors.Add(Pawn);
+		OutActors.Add(Controller);
+	}
+}
+
+void UGEInputFeatureChurnCommandlet::DestroyPlayers(UGameInstance* GameInstance, UWorld* World, const TArray<AActor*>& Actors, const TArray<ULocalPlayer*>& LocalPlayers) const
+{
+	for (auto* Actor : Actors)
+	{
+		UGameFrameworkComponentManager::RemoveGameFrameworkComponentReceiver(Actor);
+	}
+
+	// Removing a local player also destroys its controller
+
+	for (auto* LocalPlayer : LocalPlayers)
+	{
+		GameInstance->RemoveLocalPlayer(LocalPlayer);
+	}
+
+	for (auto* Actor : Actors)
+	{
+		if (IsValid(Actor))
+		{
+			World->DestroyActor(Actor);
+		}
+	}
+}
+
+
+bool UGEInputFeatureChurnCommandlet::SetFeaturesActive(const TArray<FString>& PluginURLs, bool bActive, UWorld* World, double& OutMilliseconds) const
+{
+	auto& Subsystem{ UGameFeaturesSubsystem::Get() };
+
+	auto NumPending{ PluginURLs.Num() };
+	auto bSucceeded{ true };
+
+	auto OnComplete
+	{
+		[&NumPending, &bSucceeded](const UE::GameFeatures::FResult& Result)
+		{
+			bSucceeded &= !Result.HasError();
+			--NumPending;
+		}
+	};
+
+	const auto StartCycles{ FPlatformTime::Cycles64() };
+
+	for (const auto& PluginURL : PluginURLs)
+	{
+		if (bActive)
+		{
+			Subsystem.LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateLambda(OnComplete));
+		}
+		else
+		{
+			Subsystem.DeactivateGameFeaturePlugin(PluginURL, FGameFeaturePluginDeactivateComplete::CreateLambda(OnComplete));
+		}
+	}
+
+	// State transitions may span several ticks
+
+	while ((NumPending > 0) && (GEInputFeatureChurn::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles) < GEInputFeatureChurn::FeatureStateTimeoutSeconds * 1000.0))
+	{
+		GEInputFeatureChurn::PumpEngine();
+	}
+
+	OutMilliseconds = GEInputFeatureChurn::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+	return bSucceeded && (NumPending == 0);
+}
+
+void UGEInputFeatureChurnCommandlet::TickFrames(UWorld* World, int32 NumFrames, double& OutMaxFrameMs, double& OutAvgFrameMs) const
+{
+	OutMaxFrameMs = 0.0;
+	OutAvgFrameMs = 0.0;
+
+	for (int32 Frame{ 0 }; Frame < NumFrames; ++Frame)
+	{
+		const auto StartCycles{ FPlatformTime::Cycles64() };
+
+		World->Tick(LEVELTICK_All, GEInputFeatureChurn::FrameDeltaSeconds);
+		GEInputFeatureChurn::PumpEngine();
+
+		const auto FrameMs{ GEInputFeatureChurn::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles) };
+		OutMaxFrameMs = FMath::Max(OutMaxFrameMs, FrameMs);
+		OutAvgFrameMs += FrameMs;
+	}
+
+	OutAvgFrameMs /= FMath::Max(1, NumFrames);
+}
+
+void UGEInputFeatureChurnCommandlet::CountTrackedEntries(int32& OutControllers, int32& OutActors, int32& OutStale) const
+{
+	OutControllers = 0;
+	OutActors = 0;
+	OutStale = 0;
+
+#if !UE_BUILD_SHIPPING
+	for (TObjectIterator<UGameFeatureAction_AddInputContextMapping> It; It; ++It)
+	{
+		auto NumStale{ 0 };
+		OutControllers += It->GetNumTrackedControllers(&NumStale);
+		OutStale += NumStale;
+	}
+
+	for (TObjectIterator<UGameFeatureAction_AddInputProcessors> It; It; ++It)
+	{
+		auto NumStale{ 0 };
+		OutActors += It->GetNumTrackedActors(&NumStale);
+		OutStale += NumStale;
+	}
+#endif
+}
@@ -0,0 +1,65 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "GEInputFeatureChurnCommandlet.generated.h"
+
+class UGameInstance;
+class ULocalPlayer;
+class UWorld;
+
+
+/**
+ * Measures how the activation cost of input game features scales with the number of players and processors
+ *
+ * Usage:
+ *	UnrealEditor-Cmd <Project> -run=GEInputFeatureChurn -Features=FeatureA+FeatureB [-Map=/Game/Maps/Test] [-Players=1,16,64] [-Cycles=10] [-Frames=30] [-Output=<Directory>]
+ *
+ * Tips:
+ *	Each cycle activates every listed game feature, ticks the world for the number of frames,
+ *	deactivates the features and ticks again, then checks that no controller or actor entries were left
+ *	in UGameFeatureAction_AddInputContextMapping and UGameFeatureAction_AddInputProcessors.
+ *
+ *	Every spawned controller is given its own ULocalPlayer so that mapping context add/remove is measured.
+ *	The world is ticked directly, so GFrameCounter does not advance between the ticked frames.
+ */
+UCLASS()
+class UGEInputFeatureChurnCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UGEInputFeatureChurnCommandlet(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	struct FCycleResult
+	{
+		int32 NumPlayers{ 0 };
+		int32 NumLocalPlayers{ 0 };
+		int32 Cycle{ 0 };
+		double ActivationMs{ 0.0 };
+		double DeactivationMs{ 0.0 };
+		double MaxFrameMs{ 0.0 };
+		double AvgFrameMs{ 0.0 };
+		int32 UObjectDelta{ 0 };
+		int32 TrackedControllers{ 0 };
+		int32 TrackedActors{ 0 };
+		int32 StaleEntries{ 0 };
+	};
+
+	UWorld* CreateTestWorld(UGameInstance*& OutGameInstance, const FString& MapName) const;
+	void DestroyTestWorld(UGameInstance* GameInstance) const;
+
+	void SpawnPlayers(UGameInstance* GameInstance, UWorld* World, int32 NumPlayers, TArray<AActor*>& OutActors, TArray<ULocalPlayer*>& OutLocalPlayers) const;
+	void DestroyPlayers(UGameInstance* GameInstance, UWorld* World, const TArray<AActor*>& Actors, const TArray<ULocalPlayer*>& LocalPlayers) const;
+
+	bool SetFeaturesActive(const TArray<FString>& PluginURLs, bool bActive, UWorld* World, double& OutMilliseconds) const;
+	void TickFrames(UWorld* World, int32 NumFrames, double& OutMaxFrameMs, double& OutAvgFrameMs) const;
+
+	void CountTrackedEntries(int32& OutControllers, int32& OutActors, int32& OutStale) const;
+
+};
@@ -0,0 +1,63 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "GEInputFeatureValidationCommandlet.h"
+
+#include "Development/InputFeatureValidator.h"
+#include "GEInputLogs.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/FileHelper.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GEInputFeatureValidationCommandlet)
+
+
+UGEInputFeatureValidationCommandlet::UGEInputFeatureValidationCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+
+int32 UGEInputFeatureValidationCommandlet::Main(const FString& Params)
+{
+	FString OutputFilename;
+	FParse::Value(*Params, TEXT("Output="), OutputFilename);
+
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	const auto StartTime{ FPlatformTime::Seconds() };
+
+	FInputFeatureValidator Validator;
+	const auto NumFeatures{ Validator.AddAllFeatures() };
+	Validator.Run();
+
+	const auto& Issues{ Validator.GetIssues() };
+
+	FString Report;
+
+	for (const auto& Issue : Issues)
+	{
+		FString Features;
+
+		for (const auto& Feature : Issue.Features)
+		{
+			Features += (Features.IsEmpty() ? TEXT("") : TEXT(", ")) + Feature.ToString();
+		}
+
+		UE_LOG(LogGameCore_Input, Warning, TEXT("FeatureValidation: %s [%s]"), *Issue.Message, *Features);
+
+		Report += FString::Printf(TEXT("%s [%s]\n"), *Issue.Message, *Features);
+	}
+
+	UE_LOG(LogGameCore_Input, Display, TEXT("FeatureValidation: %d issues in %d game features (%.2fs)"), Issues.Num(), NumFeatures, FPlatformTime::Seconds() - StartTime);
+
+	if (!OutputFilename.IsEmpty() && FFileHelper::SaveStringToFile(Report, *OutputFilename))
+	{
+		UE_LOG(LogGameCore_Input, Display, TEXT("FeatureValidation: Results written to %s"), *OutputFilename);
+	}
+
+	return Issues.IsEmpty() ? 0 : 1;
+}
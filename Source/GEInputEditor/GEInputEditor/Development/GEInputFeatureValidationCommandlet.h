@@ -0,0 +1,29 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "GEInputFeatureValidationCommandlet.generated.h"
+
+
+/**
+ * Reports input processors and mapping contexts of all game features in the project that overlap at runtime
+ *
+ * Usage:
+ *	UnrealEditor-Cmd <Project> -run=GEInputFeatureValidation [-Output=<File>]
+ *
+ * Tips:
+ *	Returns 1 if any issue is found, see FInputFeatureValidator for the checks.
+ */
+UCLASS()
+class UGEInputFeatureValidationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UGEInputFeatureValidationCommandlet(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	virtual int32 Main(const FString& Params) override;
+
+};